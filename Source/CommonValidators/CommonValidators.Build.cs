@@ -9,11 +9,18 @@ public class CommonValidators : ModuleRules
 		PrivateDependencyModuleNames.AddRange(new string[] {
 			"Core",
 			"CoreUObject",
+			"AssetRegistry",
 			"Engine",
 			"DataValidation",
 			"BlueprintGraph",
+			"AnimGraph",
+			"ContentBrowser",
 			"DeveloperSettings",
+			"Json",
 			"Kismet",
+			"Slate",
+			"SlateCore",
+			"ToolMenus",
 			"UnrealEd"
 		});
 	}
@@ -1,3 +1,49 @@
 #include "Modules/ModuleManager.h"
+#include "CommonValidatorsAssetTags.h"
+#include "CommonValidatorsAsyncValidation.h"
+#include "CommonValidatorsCallGraph.h"
+#include "CommonValidatorsFixMenu.h"
+#include "CommonValidatorsGraphIndex.h"
+#include "CommonValidatorsLiveValidation.h"
+#include "CommonValidatorsLog.h"
+#include "CommonValidatorsMessageReport.h"
+#include "CommonValidatorsNodeRules.h"
+#include "CommonValidatorsPureNodeAllowlist.h"
+#include "CommonValidatorsReferenceGraph.h"
+#include "CommonValidatorsResultCache.h"
 
-IMPLEMENT_MODULE(FDefaultModuleImpl, CommonValidators)
+DEFINE_LOG_CATEGORY(LogCommonValidators);
+
+class FCommonValidatorsModule : public IModuleInterface
+{
+public:
+	virtual void StartupModule() override
+	{
+		FCommonValidatorsGraphIndexCache::Get().Initialize();
+		FCommonValidatorsPureNodeAllowlist::Get().Initialize();
+		FCommonValidatorsNodeRules::Get().Initialize();
+		FCommonValidatorsCallGraph::Get().Initialize();
+		FCommonValidatorsReferenceGraph::Get().Initialize();
+		FCommonValidatorsAssetTags::Initialize();
+		FCommonValidatorsResultCache::Get().Initialize();
+		FCommonValidatorsLiveValidation::Get().Initialize();
+		FCommonValidatorsFixMenu::Initialize();
+	}
+
+	virtual void ShutdownModule() override
+	{
+		FCommonValidatorsFixMenu::Shutdown();
+		FCommonValidatorsLiveValidation::Get().Shutdown();
+		FCommonValidatorsAsyncValidation::Get().Shutdown();
+		FCommonValidatorsMessageReport::Get().Shutdown();
+		FCommonValidatorsResultCache::Get().Shutdown();
+		FCommonValidatorsAssetTags::Shutdown();
+		FCommonValidatorsReferenceGraph::Get().Shutdown();
+		FCommonValidatorsCallGraph::Get().Shutdown();
+		FCommonValidatorsNodeRules::Get().Shutdown();
+		FCommonValidatorsPureNodeAllowlist::Get().Shutdown();
+		FCommonValidatorsGraphIndexCache::Get().Shutdown();
+	}
+};
+
+IMPLEMENT_MODULE(FCommonValidatorsModule, CommonValidators)
@@ -0,0 +1,341 @@
+#include "CommonValidatorsAssetTags.h"
+
+#include "AssetRegistry/AssetData.h"
+#include "CommonValidatorsDeveloperSettings.h"
+#include "CommonValidatorsGraphIndex.h"
+#include "CommonValidatorsNodeRules.h"
+#include "EditorValidator_AnimUpdate.h"
+#include "EditorValidator_BlockingLoad.h"
+#include "EditorValidator_DuplicatePure.h"
+#include "EditorValidator_EmptyTick.h"
+#include "EditorValidator_ExpensiveTick.h"
+#include "EditorValidator_HardReferences.h"
+#include "EditorValidator_IdleTick.h"
+#include "EditorValidator_LargeCopy.h"
+#include "EditorValidator_NodeRules.h"
+#include "EditorValidator_PureNode.h"
+#include "EditorValidator_Replication.h"
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "Misc/Crc.h"
+#include "Runtime/Launch/Resources/Version.h"
+#include "UObject/AssetRegistryTagsContext.h"
+
+const FName FCommonValidatorsAssetTags::VersionTag(TEXT("CV_Version"));
+const FName FCommonValidatorsAssetTags::BlockingLoadsTag(TEXT("CV_BlockingLoads"));
+const FName FCommonValidatorsAssetTags::HasTickTag(TEXT("CV_HasTick"));
+const FName FCommonValidatorsAssetTags::HasConstructionScriptTag(TEXT("CV_HasConstructionScript"));
+const FName FCommonValidatorsAssetTags::EmptyTicksTag(TEXT("CV_EmptyTicks"));
+const FName FCommonValidatorsAssetTags::PureMultiExecTag(TEXT("CV_PureMultiExec"));
+const FName FCommonValidatorsAssetTags::PureNodeSettingsTag(TEXT("CV_PureNodeSettings"));
+const FName FCommonValidatorsAssetTags::GraphHashTag(TEXT("CV_GraphHash"));
+const FName FCommonValidatorsAssetTags::CallDependenciesTag(TEXT("CV_CallDependencies"));
+const FName FCommonValidatorsAssetTags::NodeRuleMatchesTag(TEXT("CV_NodeRuleMatches"));
+const FName FCommonValidatorsAssetTags::NodeRulesSettingsTag(TEXT("CV_NodeRulesSettings"));
+const FName FCommonValidatorsAssetTags::DuplicatePureTag(TEXT("CV_DuplicatePure"));
+const FName FCommonValidatorsAssetTags::IdleTicksTag(TEXT("CV_IdleTicks"));
+const FName FCommonValidatorsAssetTags::LargestCopyTag(TEXT("CV_LargestCopy"));
+const FName FCommonValidatorsAssetTags::AnimUpdateFindingsTag(TEXT("CV_AnimUpdateFindings"));
+const FName FCommonValidatorsAssetTags::NetworkedItemsTag(TEXT("CV_NetworkedItems"));
+const FName FCommonValidatorsAssetTags::TickDependenciesTag(TEXT("CV_TickDependencies"));
+const FName FCommonValidatorsAssetTags::HardReferenceBytesTag(TEXT("CV_HardReferenceBytes"));
+const FName FCommonValidatorsAssetTags::HardReferencesHashTag(TEXT("CV_HardReferencesHash"));
+
+FDelegateHandle FCommonValidatorsAssetTags::ExtraObjectTagsHandle;
+
+void FCommonValidatorsAssetTags::Initialize()
+{
+	ExtraObjectTagsHandle = UObject::FAssetRegistryTag::OnGetExtraObjectTagsWithContext.AddStatic(&FCommonValidatorsAssetTags::OnGetExtraObjectTags);
+}
+
+void FCommonValidatorsAssetTags::Shutdown()
+{
+	UObject::FAssetRegistryTag::OnGetExtraObjectTagsWithContext.Remove(ExtraObjectTagsHandle);
+}
+
+uint32 FCommonValidatorsAssetTags::ComputePureNodeSettingsHash()
+{
+	const UCommonValidatorsDeveloperSettings* Settings = GetDefault<UCommonValidatorsDeveloperSettings>();
+
+	uint32 Hash = 0;
+	for (const TSoftClassPtr<UObject>& Class : Settings->HarmlessPureNodeClasses)
+	{
+		Hash = FCrc::StrCrc32(*Class.ToString(), Hash);
+	}
+	for (const FCommonValidatorsFunctionReference& Function : Settings->HarmlessPureNodeFunctions)
+	{
+		Hash = FCrc::StrCrc32(*Function.Class.ToString(), Hash);
+		Hash = FCrc::StrCrc32(*Function.FunctionName.ToString(), Hash);
+	}
+	for (const FName& Tag : Settings->HarmlessPureNodeMetadataTags)
+	{
+		Hash = FCrc::StrCrc32(*Tag.ToString(), Hash);
+	}
+	for (const FString& Substring : Settings->HarmlessPureNodeClassNameSubstrings)
+	{
+		Hash = FCrc::StrCrc32(*Substring, Hash);
+	}
+	return Hash;
+}
+
+void FCommonValidatorsAssetTags::OnGetExtraObjectTags(FAssetRegistryTagsContext Context)
+{
+	// Tags are also gathered when the editor refreshes the registry entry of a loaded asset, the analyses are only worth
+	// running when saving. Entries gathered otherwise lack the tags, which only makes the asset load for validation.
+	// Saving gathers on the game thread, the index cache relies on that. Cooked data doesn't need them.
+	if (!Context.IsSaving() || !IsInGameThread() || IsRunningCookCommandlet())
+	{
+		return;
+	}
+
+	UBlueprint* Blueprint = const_cast<UBlueprint*>(Cast<UBlueprint>(Context.GetObject()));
+	if (!Blueprint || Blueprint->HasAnyFlags(RF_ClassDefaultObject))
+	{
+		return;
+	}
+
+	const TSharedRef<const FCommonValidatorsBlueprintIndex> Index = FCommonValidatorsGraphIndexCache::Get().FindOrBuild(Blueprint);
+
+	TArray<FCommonValidatorsNodeRef> Nodes;
+	UEditorValidator_BlockingLoad::FindBlockingLoads(*Index, Nodes, true);
+	const int32 NumBlockingLoads = Nodes.Num();
+
+	Nodes.Reset();
+	UEditorValidator_EmptyTick::FindEmptyTicks(*Index, Nodes);
+	const int32 NumEmptyTicks = Nodes.Num();
+
+	Nodes.Reset();
+	UEditorValidator_PureNode::FindMultiExecPureNodes(*Index, Nodes);
+	const int32 NumPureMultiExec = Nodes.Num();
+
+	// Trivial copies depend on the Pure Node allowlist, whose hash is tagged below.
+	TArray<FCommonValidatorsDuplicatePure> Duplicates;
+	UEditorValidator_DuplicatePure::FindDuplicatePureComputations(*Index, Duplicates);
+	const int32 NumDuplicatePure = Duplicates.FilterByPredicate([](const FCommonValidatorsDuplicatePure& Duplicate) { return !Duplicate.bIsTrivial; }).Num();
+
+	// Interval suggestions included, they don't depend on any setting but whether they are shown.
+	TArray<int32> IdleTicks;
+	UEditorValidator_IdleTick::FindIdleTicks(*Index, IdleTicks);
+	Nodes.Reset();
+	UEditorValidator_IdleTick::FindTickIntervalCandidates(*Index, Nodes);
+	const int32 NumIdleTicks = IdleTicks.Num() + Nodes.Num();
+
+	// Only the severity depends on settings.
+	TArray<FCommonValidatorsFinding> AnimUpdateFindings;
+	UEditorValidator_AnimUpdate::FindGameThreadWork(*Index, EMessageSeverity::Warning, AnimUpdateFindings);
+
+	// Largest copy of any node, so the tag stays valid whatever the threshold.
+	int32 LargestCopy = 0;
+	bool bHasTick = false;
+	bool bHasConstructionScript = false;
+	for (const FCommonValidatorsIndexedGraph& Graph : Index->Graphs)
+	{
+		for (const FCommonValidatorsIndexedNode& Node : Graph.Nodes)
+		{
+			LargestCopy = FMath::Max(LargestCopy, Node.CopyBytes);
+		}
+		bHasTick |= Graph.Nodes.ContainsByPredicate([](const FCommonValidatorsIndexedNode& Node)
+		{
+			return UEditorValidator_ExpensiveTick::IsTickEntry(Node) && !Node.bIsGhostNode;
+		});
+		bHasConstructionScript |= Graph.Nodes.ContainsByPredicate([](const FCommonValidatorsIndexedNode& Node)
+		{
+			return Node.Kind == ECommonValidatorsNodeKind::FunctionEntry && Node.MemberName == UEdGraphSchema_K2::FN_UserConstructionScript && Node.bExecOutputLinked;
+		});
+	}
+
+	using FTag = UObject::FAssetRegistryTag;
+	Context.AddTag(FTag(VersionTag, LexToString(CurrentVersion), FTag::TT_Hidden));
+	Context.AddTag(FTag(BlockingLoadsTag, LexToString(NumBlockingLoads), FTag::TT_Hidden));
+	Context.AddTag(FTag(HasTickTag, LexToString(bHasTick), FTag::TT_Hidden));
+	Context.AddTag(FTag(HasConstructionScriptTag, LexToString(bHasConstructionScript), FTag::TT_Hidden));
+	Context.AddTag(FTag(EmptyTicksTag, LexToString(NumEmptyTicks), FTag::TT_Hidden));
+	Context.AddTag(FTag(PureMultiExecTag, LexToString(NumPureMultiExec), FTag::TT_Hidden));
+	Context.AddTag(FTag(DuplicatePureTag, LexToString(NumDuplicatePure), FTag::TT_Hidden));
+	Context.AddTag(FTag(IdleTicksTag, LexToString(NumIdleTicks), FTag::TT_Hidden));
+	Context.AddTag(FTag(LargestCopyTag, LexToString(LargestCopy), FTag::TT_Hidden));
+	Context.AddTag(FTag(AnimUpdateFindingsTag, LexToString(AnimUpdateFindings.Num()), FTag::TT_Hidden));
+	Context.AddTag(FTag(NetworkedItemsTag, LexToString(UEditorValidator_Replication::CountNetworkedItems(*Index)), FTag::TT_Hidden));
+	Context.AddTag(FTag(PureNodeSettingsTag, LexToString(ComputePureNodeSettingsHash()), FTag::TT_Hidden));
+	Context.AddTag(FTag(GraphHashTag, LexToString(Index->ContentHash), FTag::TT_Hidden));
+	Context.AddTag(FTag(CallDependenciesTag, LexToString(Index->Dependencies.Num()), FTag::TT_Hidden));
+	Context.AddTag(FTag(TickDependenciesTag, LexToString(Index->NumTickDependencies), FTag::TT_Hidden));
+	Context.AddTag(FTag(NodeRuleMatchesTag, LexToString(UEditorValidator_NodeRules::CountRuleMatches(*Index)), FTag::TT_Hidden));
+	Context.AddTag(FTag(NodeRulesSettingsTag, LexToString(FCommonValidatorsNodeRules::ComputeSettingsHash()), FTag::TT_Hidden));
+
+	// The registry still holds the references of the previous save here, the hash tells the prefilter when they changed.
+	if (GetDefault<UCommonValidatorsDeveloperSettings>()->bEnableHardReferenceValidator)
+	{
+		Context.AddTag(FTag(HardReferenceBytesTag, LexToString(UEditorValidator_HardReferences::GetClosureSize(Index->PackageName)), FTag::TT_Hidden));
+		Context.AddTag(FTag(HardReferencesHashTag, LexToString(UEditorValidator_HardReferences::ComputeReferencesHash(Index->PackageName)), FTag::TT_Hidden));
+	}
+}
+
+bool FCommonValidatorsAssetTags::NeedsLoadForValidation(const FAssetData& AssetData)
+{
+	return NeedsLoadForValidation(AssetData, ComputePureNodeSettingsHash(), FCommonValidatorsNodeRules::ComputeSettingsHash());
+}
+
+void FCommonValidatorsAssetTags::FilterAssetsNeedingLoad(const TArray<FAssetData>& Assets, TArray<FAssetData>& OutAssets)
+{
+	const uint32 PureNodeSettingsHash = ComputePureNodeSettingsHash();
+	const uint32 NodeRulesSettingsHash = FCommonValidatorsNodeRules::ComputeSettingsHash();
+	for (const FAssetData& AssetData : Assets)
+	{
+		if (NeedsLoadForValidation(AssetData, PureNodeSettingsHash, NodeRulesSettingsHash))
+		{
+			OutAssets.Add(AssetData);
+		}
+	}
+}
+
+bool FCommonValidatorsAssetTags::NeedsLoadForValidation(const FAssetData& AssetData, uint32 PureNodeSettingsHash, uint32 NodeRulesSettingsHash)
+{
+	// None of our validators look at anything but Blueprints
+	if (!AssetData.IsInstanceOf(UBlueprint::StaticClass()))
+	{
+		return false;
+	}
+
+	int32 Version = 0;
+	if (!AssetData.GetTagValue(VersionTag, Version) || Version != CurrentVersion)
+	{
+		return true;
+	}
+
+	// A missing count is treated as a finding
+	auto HasFindings = [&AssetData](FName Tag)
+	{
+		int32 Count = 1;
+		AssetData.GetTagValue(Tag, Count);
+		return Count != 0;
+	};
+
+	const UCommonValidatorsDeveloperSettings* Settings = GetDefault<UCommonValidatorsDeveloperSettings>();
+
+	if (Settings->bEnableBlockingLoadValidator && HasFindings(BlockingLoadsTag))
+	{
+		return true;
+	}
+
+	// Functions of other Blueprints may have started blocking since the tags were written.
+	if (Settings->bEnableBlockingLoadValidator && Settings->bBlockingLoadFollowCalls && HasFindings(CallDependenciesTag))
+	{
+		return true;
+	}
+
+	// What runs on Tick depends on the expensive function table and on callees, only Blueprints without a Tick are safe to skip.
+	// Those have nothing to report whatever their parents or callees do, the analysis only starts from their own Tick events.
+	bool bHasTick = true;
+	AssetData.GetTagValue(HasTickTag, bHasTick);
+	if (Settings->bEnableExpensiveTickValidator && bHasTick)
+	{
+		return true;
+	}
+
+	// Costs depend on callees and settings as well, Blueprints with neither a Tick nor a construction script cost nothing.
+	bool bHasConstructionScript = true;
+	AssetData.GetTagValue(HasConstructionScriptTag, bHasConstructionScript);
+	if (Settings->bEnableTickCostValidator && (bHasTick || bHasConstructionScript))
+	{
+		return true;
+	}
+
+	// Whether a tick is idle depends on the Tick events of parent and component Blueprints, which may have changed since.
+	if (Settings->bEnableIdleTickValidator && (HasFindings(IdleTicksTag) || HasFindings(TickDependenciesTag)))
+	{
+		return true;
+	}
+
+	// Struct sizes are taken when saving, a missing tag is treated as a copy over any threshold.
+	if (Settings->bEnableLargeCopyValidator)
+	{
+		int32 LargestCopy = MAX_int32;
+		AssetData.GetTagValue(LargestCopyTag, LargestCopy);
+		if (LargestCopy >= Settings->LargeCopyThresholdBytes)
+		{
+			return true;
+		}
+	}
+
+	// Everything the replication analysis reports depends on settings, only Blueprints without anything networked are safe to skip.
+	if (Settings->bEnableReplicationValidator && HasFindings(NetworkedItemsTag))
+	{
+		return true;
+	}
+
+	if (Settings->bEnableAnimUpdateValidator && HasFindings(AnimUpdateFindingsTag))
+	{
+		return true;
+	}
+
+	// Sizes are taken when saving. Growth further down the closure goes unnoticed until the next save, the direct
+	// references and ignored paths don't.
+	if (Settings->bEnableHardReferenceValidator)
+	{
+		uint32 ReferencesHash = 0;
+		if (!AssetData.GetTagValue(HardReferencesHashTag, ReferencesHash) || ReferencesHash != UEditorValidator_HardReferences::ComputeReferencesHash(AssetData.PackageName))
+		{
+			return true;
+		}
+
+		int64 ClosureSize = MAX_int64;
+		AssetData.GetTagValue(HardReferenceBytesTag, ClosureSize);
+		if (UEditorValidator_HardReferences::IsOverBudget(ClosureSize))
+		{
+			return true;
+		}
+	}
+
+	// Matches only depend on the Blueprint's own nodes and the rules, scopes can only narrow them down.
+	if (Settings->bEnableNodeRuleValidator && Settings->NodeRules.Num() > 0)
+	{
+		uint32 SettingsHash = 0;
+		if (!AssetData.GetTagValue(NodeRulesSettingsTag, SettingsHash) || SettingsHash != NodeRulesSettingsHash)
+		{
+			return true;
+		}
+
+		if (HasFindings(NodeRuleMatchesTag))
+		{
+			return true;
+		}
+	}
+
+#if !(ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 6))
+	if (Settings->bEnableEmptyTickNodeValidator && HasFindings(EmptyTicksTag))
+	{
+		return true;
+	}
+#endif
+
+	if (Settings->bEnableDuplicatePureValidator)
+	{
+		uint32 SettingsHash = 0;
+		if (!AssetData.GetTagValue(PureNodeSettingsTag, SettingsHash) || SettingsHash != PureNodeSettingsHash)
+		{
+			return true;
+		}
+
+		if (HasFindings(DuplicatePureTag))
+		{
+			return true;
+		}
+	}
+
+	if (Settings->bEnablePureNodeMultiExecValidator)
+	{
+		uint32 SettingsHash = 0;
+		if (!AssetData.GetTagValue(PureNodeSettingsTag, SettingsHash) || SettingsHash != PureNodeSettingsHash)
+		{
+			return true;
+		}
+
+		if (HasFindings(PureMultiExecTag))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
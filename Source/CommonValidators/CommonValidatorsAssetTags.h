@@ -0,0 +1,59 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FAssetData;
+class FAssetRegistryTagsContext;
+
+/**
+ * Compact analysis summaries written into the asset registry whenever a Blueprint is saved, so batch
+ * validation can tell from FAssetData alone whether an asset has to be loaded at all.
+ */
+class COMMONVALIDATORS_API FCommonValidatorsAssetTags
+{
+public:
+	// Bump whenever an analysis changes in a way that makes previously written tags unreliable.
+	static constexpr int32 CurrentVersion = 12;
+
+	static const FName VersionTag;
+	static const FName BlockingLoadsTag;
+	static const FName HasTickTag;
+	static const FName HasConstructionScriptTag;
+	static const FName EmptyTicksTag;
+	static const FName PureMultiExecTag;
+	static const FName PureNodeSettingsTag;
+	static const FName GraphHashTag;
+	static const FName CallDependenciesTag;
+	static const FName NodeRuleMatchesTag;
+	static const FName NodeRulesSettingsTag;
+	static const FName DuplicatePureTag;
+	static const FName IdleTicksTag;
+	static const FName LargestCopyTag;
+	static const FName AnimUpdateFindingsTag;
+	static const FName NetworkedItemsTag;
+	static const FName TickDependenciesTag;
+	static const FName HardReferenceBytesTag;
+	static const FName HardReferencesHashTag;
+
+	static void Initialize();
+	static void Shutdown();
+
+	/**
+	 * Returns false only when the asset's tags prove that none of the enabled validators would report anything.
+	 * Assets saved before the tags existed, or with an outdated analysis version or settings, always need loading.
+	 */
+	static bool NeedsLoadForValidation(const FAssetData& AssetData);
+
+	// Keeps only the assets for which NeedsLoadForValidation returns true.
+	static void FilterAssetsNeedingLoad(const TArray<FAssetData>& Assets, TArray<FAssetData>& OutAssets);
+
+	// Hash of the settings that influence the PureNode analysis.
+	static uint32 ComputePureNodeSettingsHash();
+
+private:
+	static bool NeedsLoadForValidation(const FAssetData& AssetData, uint32 PureNodeSettingsHash, uint32 NodeRulesSettingsHash);
+
+	static void OnGetExtraObjectTags(FAssetRegistryTagsContext Context);
+
+	static FDelegateHandle ExtraObjectTagsHandle;
+};
@@ -0,0 +1,104 @@
+#include "CommonValidatorsAsyncValidation.h"
+
+#include "Async/Async.h"
+#include "CommonValidatorsDeveloperSettings.h"
+#include "CommonValidatorsFinding.h"
+#include "CommonValidatorsGraphIndex.h"
+#include "EditorValidator_BlueprintBase.h"
+#include "Engine/Blueprint.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "UObject/GarbageCollection.h"
+#include "UObject/Package.h"
+
+FCommonValidatorsAsyncValidation& FCommonValidatorsAsyncValidation::Get()
+{
+	static FCommonValidatorsAsyncValidation Instance;
+	return Instance;
+}
+
+void FCommonValidatorsAsyncValidation::Shutdown()
+{
+	for (const TPair<FKey, TSharedRef<FJob>>& Pair : Jobs)
+	{
+		Pair.Value->bCancelled = true;
+	}
+	for (const TPair<FKey, TSharedRef<FJob>>& Pair : Jobs)
+	{
+		Pair.Value->Task.Wait();
+	}
+	Jobs.Reset();
+}
+
+void FCommonValidatorsAsyncValidation::Launch(UBlueprint* Blueprint, const TSharedRef<const FCommonValidatorsBlueprintIndex>& Index, const UEditorValidator_BlueprintBase* Validator)
+{
+	check(IsInGameThread());
+
+	FString AssetPath = Blueprint->GetPathName();
+	const FKey Key(AssetPath, Validator->GetClass()->GetFName());
+
+	// The previous save's results would be out of date by the time they arrive.
+	if (const TSharedRef<FJob>* Previous = Jobs.Find(Key))
+	{
+		(*Previous)->bCancelled = true;
+	}
+
+	TSharedRef<FJob> Job = MakeShared<FJob>();
+	Job->Key = Key;
+	Jobs.Add(Key, Job);
+
+	const bool bUseCache = GetDefault<UCommonValidatorsDeveloperSettings>()->bEnableResultCache;
+	TWeakObjectPtr<UBlueprint> WeakBlueprint(Blueprint);
+	TWeakObjectPtr<const UEditorValidator_BlueprintBase> WeakValidator(Validator);
+
+	Job->Task = UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, Job, WeakBlueprint, Index, WeakValidator, AssetPath = MoveTemp(AssetPath), bUseCache]()
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(FCommonValidatorsAsyncValidation::Analyze);
+
+		// Validators are instances the editor validator subsystem creates with NewObject, they can be collected once
+		// it drops them. The guard holds off garbage collection until the analysis is done, so a validator still
+		// alive here stays alive until then.
+		TArray<FCommonValidatorsFinding> Findings;
+		if (!Job->bCancelled)
+		{
+			FGCScopeGuard GCGuard;
+			if (const UEditorValidator_BlueprintBase* Validator = WeakValidator.Get())
+			{
+				Validator->AnalyzeWithCache(AssetPath, *Index, bUseCache, Findings);
+			}
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [this, Job, WeakBlueprint, Index, WeakValidator, Findings = MoveTemp(Findings)]()
+		{
+			OnJobFinished(Job, WeakBlueprint, Index, WeakValidator, Findings);
+		});
+	}, UE::Tasks::ETaskPriority::BackgroundNormal);
+}
+
+void FCommonValidatorsAsyncValidation::OnJobFinished(const TSharedRef<FJob>& Job, TWeakObjectPtr<UBlueprint> WeakBlueprint, TSharedRef<const FCommonValidatorsBlueprintIndex> Index,
+	TWeakObjectPtr<const UEditorValidator_BlueprintBase> WeakValidator, const TArray<FCommonValidatorsFinding>& Findings)
+{
+	// Cancelled jobs were replaced in Jobs or dropped from it already.
+	if (Job->bCancelled)
+	{
+		return;
+	}
+	Jobs.Remove(Job->Key);
+
+	UBlueprint* Blueprint = WeakBlueprint.Get();
+	const UEditorValidator_BlueprintBase* Validator = WeakValidator.Get();
+	if (!Blueprint || !Validator)
+	{
+		return;
+	}
+
+	// Edited since the save: the nodes may be gone, and the next save validates again anyway. Edits drop the cached
+	// index, and building one here just to compare would stall the editor right after the edit, so without a cached
+	// index fall back to whether the package was dirtied.
+	const TSharedPtr<const FCommonValidatorsBlueprintIndex> Cached = FCommonValidatorsGraphIndexCache::Get().Find(Blueprint);
+	if (Cached ? Cached->ContentHash != Index->ContentHash : Blueprint->GetPackage()->IsDirty())
+	{
+		return;
+	}
+
+	Validator->ReportFindingsToMessageLog(Blueprint, *Index, Findings);
+}
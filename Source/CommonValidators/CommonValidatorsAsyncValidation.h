@@ -0,0 +1,43 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/Task.h"
+
+#include <atomic>
+
+struct FCommonValidatorsBlueprintIndex;
+class UBlueprint;
+class UEditorValidator_BlueprintBase;
+
+/**
+ * Background validation of saved Blueprints. Each validator analyzes the index snapshot taken on save on a worker
+ * thread, and its findings are reported to the Message Log back on the game thread. Saving the same Blueprint again
+ * cancels the analyses still pending for the previous save, and results of a Blueprint edited since are dropped.
+ */
+class COMMONVALIDATORS_API FCommonValidatorsAsyncValidation
+{
+public:
+	static FCommonValidatorsAsyncValidation& Get();
+
+	// Cancels every pending analysis and waits for those already running.
+	void Shutdown();
+
+	// Game thread only.
+	void Launch(UBlueprint* Blueprint, const TSharedRef<const FCommonValidatorsBlueprintIndex>& Index, const UEditorValidator_BlueprintBase* Validator);
+
+private:
+	using FKey = TPair<FString, FName>;
+
+	struct FJob
+	{
+		FKey Key;
+		std::atomic<bool> bCancelled = false;
+		UE::Tasks::FTask Task;
+	};
+
+	void OnJobFinished(const TSharedRef<FJob>& Job, TWeakObjectPtr<UBlueprint> Blueprint, TSharedRef<const FCommonValidatorsBlueprintIndex> Index,
+		TWeakObjectPtr<const UEditorValidator_BlueprintBase> Validator, const TArray<struct FCommonValidatorsFinding>& Findings);
+
+	// Latest job of each asset path and validator.
+	TMap<FKey, TSharedRef<FJob>> Jobs;
+};
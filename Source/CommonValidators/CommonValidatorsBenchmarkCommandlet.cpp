@@ -0,0 +1,297 @@
+#include "CommonValidatorsBenchmarkCommandlet.h"
+
+#include "CommonValidatorsGraphIndex.h"
+#include "CommonValidatorsLog.h"
+#include "CommonValidatorsSyntheticBlueprint.h"
+#include "Dom/JsonObject.h"
+#include "EditorValidator_BlueprintBase.h"
+#include "Engine/Blueprint.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/UObjectHash.h"
+
+namespace UE::Internal::BenchmarkCommandletHelpers
+{
+	static constexpr int32 BaselineVersion = 1;
+	static constexpr int32 DefaultIterations = 5;
+	static constexpr double DefaultTolerance = 0.25;
+
+	// Differences below this are timer noise, whatever the relative change.
+	static constexpr double NoiseFloorMs = 0.05;
+
+	static const TCHAR* IndexBuildMetric = TEXT("IndexBuild");
+
+	struct FMeasurement
+	{
+		FString Shape;
+		int32 NumNodes = 0;
+		FString Metric;
+		double Milliseconds = 0.0;
+		int64 Bytes = 0;
+		int32 NumFindings = 0;
+
+		FString GetKey() const
+		{
+			return FString::Printf(TEXT("%s/%d/%s"), *Shape, NumNodes, *Metric);
+		}
+	};
+
+	// Median of Iterations runs, in milliseconds.
+	template <typename FunctionType>
+	static double Time(int32 Iterations, FunctionType&& Function)
+	{
+		TArray<double> Samples;
+		Samples.Reserve(Iterations);
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			const uint64 Start = FPlatformTime::Cycles64();
+			Function();
+			Samples.Add(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - Start));
+		}
+		Samples.Sort();
+		return Samples[Samples.Num() / 2];
+	}
+
+	static TArray<const UEditorValidator_BlueprintBase*> GetAllValidators()
+	{
+		TArray<UClass*> Classes;
+		GetDerivedClasses(UEditorValidator_BlueprintBase::StaticClass(), Classes);
+
+		TArray<const UEditorValidator_BlueprintBase*> Validators;
+		for (const UClass* Class : Classes)
+		{
+			if (!Class->HasAnyClassFlags(CLASS_Abstract | CLASS_Deprecated | CLASS_NewerVersionExists))
+			{
+				Validators.Add(Class->GetDefaultObject<UEditorValidator_BlueprintBase>());
+			}
+		}
+
+		Validators.Sort([](const UEditorValidator_BlueprintBase& A, const UEditorValidator_BlueprintBase& B)
+		{
+			return A.GetClass()->GetFName().LexicalLess(B.GetClass()->GetFName());
+		});
+		return Validators;
+	}
+
+	static bool WriteBaseline(const FString& Path, const TArray<FMeasurement>& Measurements)
+	{
+		TArray<TSharedPtr<FJsonValue>> Results;
+		for (const FMeasurement& Measurement : Measurements)
+		{
+			TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+			Object->SetStringField(TEXT("shape"), Measurement.Shape);
+			Object->SetNumberField(TEXT("nodes"), Measurement.NumNodes);
+			Object->SetStringField(TEXT("metric"), Measurement.Metric);
+			Object->SetNumberField(TEXT("ms"), Measurement.Milliseconds);
+			Object->SetNumberField(TEXT("bytes"), static_cast<double>(Measurement.Bytes));
+			Object->SetNumberField(TEXT("findings"), Measurement.NumFindings);
+			Results.Add(MakeShared<FJsonValueObject>(Object));
+		}
+
+		TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+		Root->SetNumberField(TEXT("version"), BaselineVersion);
+		Root->SetArrayField(TEXT("results"), Results);
+
+		FString Output;
+		FJsonSerializer::Serialize(Root, TJsonWriterFactory<>::Create(&Output));
+		if (!FFileHelper::SaveStringToFile(Output, *Path, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+		{
+			UE_LOG(LogCommonValidators, Error, TEXT("Failed to write %s."), *Path);
+			return false;
+		}
+		return true;
+	}
+
+	static bool ReadBaseline(const FString& Path, TMap<FString, FMeasurement>& OutBaseline)
+	{
+		FString Input;
+		TSharedPtr<FJsonObject> Root;
+		if (!FFileHelper::LoadFileToString(Input, *Path) || !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Input), Root) || !Root)
+		{
+			UE_LOG(LogCommonValidators, Error, TEXT("Failed to read baseline %s."), *Path);
+			return false;
+		}
+
+		if (Root->GetIntegerField(TEXT("version")) != BaselineVersion)
+		{
+			UE_LOG(LogCommonValidators, Error, TEXT("Baseline %s has an unsupported version, record it again with -WriteBaseline."), *Path);
+			return false;
+		}
+
+		for (const TSharedPtr<FJsonValue>& Value : Root->GetArrayField(TEXT("results")))
+		{
+			const TSharedPtr<FJsonObject>& Object = Value->AsObject();
+			if (!Object)
+			{
+				continue;
+			}
+
+			FMeasurement Measurement;
+			Measurement.Shape = Object->GetStringField(TEXT("shape"));
+			Measurement.NumNodes = Object->GetIntegerField(TEXT("nodes"));
+			Measurement.Metric = Object->GetStringField(TEXT("metric"));
+			Measurement.Milliseconds = Object->GetNumberField(TEXT("ms"));
+			Measurement.Bytes = static_cast<int64>(Object->GetNumberField(TEXT("bytes")));
+			Measurement.NumFindings = Object->GetIntegerField(TEXT("findings"));
+			OutBaseline.Add(Measurement.GetKey(), MoveTemp(Measurement));
+		}
+		return true;
+	}
+
+	// Returns the number of regressions.
+	static int32 CompareToBaseline(const TArray<FMeasurement>& Measurements, const TMap<FString, FMeasurement>& Baseline, double Tolerance)
+	{
+		int32 NumRegressions = 0;
+		for (const FMeasurement& Measurement : Measurements)
+		{
+			const FMeasurement* Base = Baseline.Find(Measurement.GetKey());
+			if (!Base)
+			{
+				UE_LOG(LogCommonValidators, Display, TEXT("%s: no baseline"), *Measurement.GetKey());
+				continue;
+			}
+
+			if (Measurement.Milliseconds > Base->Milliseconds * (1.0 + Tolerance) && Measurement.Milliseconds - Base->Milliseconds > NoiseFloorMs)
+			{
+				UE_LOG(LogCommonValidators, Error, TEXT("%s: %.3f ms, baseline %.3f ms"), *Measurement.GetKey(), Measurement.Milliseconds, Base->Milliseconds);
+				++NumRegressions;
+			}
+			if (Measurement.Bytes > Base->Bytes * (1.0 + Tolerance))
+			{
+				UE_LOG(LogCommonValidators, Error, TEXT("%s: %lld bytes, baseline %lld bytes"), *Measurement.GetKey(), Measurement.Bytes, Base->Bytes);
+				++NumRegressions;
+			}
+			if (Measurement.NumFindings != Base->NumFindings)
+			{
+				UE_LOG(LogCommonValidators, Error, TEXT("%s: %d findings, baseline %d"), *Measurement.GetKey(), Measurement.NumFindings, Base->NumFindings);
+				++NumRegressions;
+			}
+		}
+		return NumRegressions;
+	}
+} // namespace UE::Internal::BenchmarkCommandletHelpers
+
+
+UCommonValidatorsBenchmarkCommandlet::UCommonValidatorsBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+int32 UCommonValidatorsBenchmarkCommandlet::Main(const FString& Params)
+{
+	using namespace UE::Internal::BenchmarkCommandletHelpers;
+
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamValues;
+	ParseCommandLine(*Params, Tokens, Switches, ParamValues);
+
+	TArray<ECommonValidatorsSyntheticShape> Shapes;
+	TArray<FString> ShapeNames;
+	ParamValues.FindRef(TEXT("Shapes")).ParseIntoArray(ShapeNames, TEXT("+"));
+	for (const FString& ShapeName : ShapeNames)
+	{
+		ECommonValidatorsSyntheticShape Shape;
+		if (!LexTryParseString(Shape, *ShapeName))
+		{
+			UE_LOG(LogCommonValidators, Error, TEXT("Unknown shape %s."), *ShapeName);
+			return 1;
+		}
+		Shapes.Add(Shape);
+	}
+	if (Shapes.IsEmpty())
+	{
+		for (uint8 Index = 0; Index < static_cast<uint8>(ECommonValidatorsSyntheticShape::Count); ++Index)
+		{
+			Shapes.Add(static_cast<ECommonValidatorsSyntheticShape>(Index));
+		}
+	}
+
+	TArray<int32> Sizes;
+	TArray<FString> SizeStrings;
+	ParamValues.FindRef(TEXT("Sizes")).ParseIntoArray(SizeStrings, TEXT("+"));
+	for (const FString& SizeString : SizeStrings)
+	{
+		Sizes.Add(FMath::Max(1, FCString::Atoi(*SizeString)));
+	}
+	if (Sizes.IsEmpty())
+	{
+		Sizes = { 10, 1000, 10000, 100000 };
+	}
+
+	const FString* IterationsParam = ParamValues.Find(TEXT("Iterations"));
+	const int32 Iterations = FMath::Max(1, IterationsParam ? FCString::Atoi(**IterationsParam) : DefaultIterations);
+	const FString* ToleranceParam = ParamValues.Find(TEXT("Tolerance"));
+	const double Tolerance = ToleranceParam ? FCString::Atod(**ToleranceParam) : DefaultTolerance;
+
+	const TArray<const UEditorValidator_BlueprintBase*> Validators = GetAllValidators();
+
+	TArray<FMeasurement> Measurements;
+	for (const ECommonValidatorsSyntheticShape Shape : Shapes)
+	{
+		for (const int32 Size : Sizes)
+		{
+			UBlueprint* Blueprint = FCommonValidatorsSyntheticBlueprint::Generate(Shape, Size);
+			const FString AssetPath = Blueprint->GetPathName();
+
+			TSharedPtr<FCommonValidatorsBlueprintIndex> Index;
+			FMeasurement& IndexMeasurement = Measurements.AddDefaulted_GetRef();
+			IndexMeasurement.Shape = LexToString(Shape);
+			IndexMeasurement.NumNodes = Size;
+			IndexMeasurement.Metric = IndexBuildMetric;
+			IndexMeasurement.Milliseconds = Time(Iterations, [&Index, Blueprint]() { Index = FCommonValidatorsBlueprintIndex::Build(Blueprint); });
+			IndexMeasurement.Bytes = Index->GetAllocatedSize();
+			UE_LOG(LogCommonValidators, Display, TEXT("%-40s %10.3f ms %12lld bytes (%d nodes, %d pins)"),
+				*IndexMeasurement.GetKey(), IndexMeasurement.Milliseconds, IndexMeasurement.Bytes, Index->NumNodes, Index->NumPins);
+
+			for (const UEditorValidator_BlueprintBase* Validator : Validators)
+			{
+				TArray<FCommonValidatorsFinding> Findings;
+				FMeasurement& Measurement = Measurements.AddDefaulted_GetRef();
+				Measurement.Shape = LexToString(Shape);
+				Measurement.NumNodes = Size;
+				Measurement.Metric = Validator->GetClass()->GetName();
+				Measurement.Milliseconds = Time(Iterations, [&Findings, &Index, &AssetPath, Validator]()
+				{
+					Findings.Reset();
+					Validator->AnalyzeWithCache(AssetPath, *Index, false, Findings);
+				});
+				Measurement.NumFindings = Findings.Num();
+				UE_LOG(LogCommonValidators, Display, TEXT("%-40s %10.3f ms %12d findings"), *Measurement.GetKey(), Measurement.Milliseconds, Measurement.NumFindings);
+			}
+
+			Index.Reset();
+			Blueprint->MarkAsGarbage();
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		}
+	}
+
+	int32 NumRegressions = 0;
+	if (const FString* BaselinePath = ParamValues.Find(TEXT("Baseline")))
+	{
+		TMap<FString, FMeasurement> Baseline;
+		if (!ReadBaseline(*BaselinePath, Baseline))
+		{
+			return 1;
+		}
+		NumRegressions = CompareToBaseline(Measurements, Baseline, Tolerance);
+		UE_LOG(LogCommonValidators, Display, TEXT("%d regressions against %s (tolerance %.0f%%)"), NumRegressions, **BaselinePath, Tolerance * 100.0);
+	}
+
+	if (const FString* WriteBaselinePath = ParamValues.Find(TEXT("WriteBaseline")))
+	{
+		if (!WriteBaseline(*WriteBaselinePath, Measurements))
+		{
+			return 1;
+		}
+	}
+
+	return NumRegressions > 0 ? 1 : 0;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "CommonValidatorsBenchmarkCommandlet.generated.h"
+
+/**
+ * Times the graph index and every Blueprint validator on synthetic Blueprints of various shapes and sizes.
+ *
+ * UnrealEditor-Cmd <Project> -run=CommonValidatorsBenchmark [-Shapes=WideFanOut+Loops] [-Sizes=10+1000+10000+100000]
+ *     [-Iterations=5] [-Baseline=Baseline.json] [-Tolerance=0.25] [-WriteBaseline=Baseline.json]
+ *
+ * Returns 1 when a measurement regressed by more than the tolerance against the baseline, or a validator
+ * reported a different number of findings.
+ */
+UCLASS()
+class UCommonValidatorsBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UCommonValidatorsBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
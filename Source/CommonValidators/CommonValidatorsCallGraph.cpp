@@ -0,0 +1,318 @@
+#include "CommonValidatorsCallGraph.h"
+
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "Engine/Blueprint.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_Composite.h"
+#include "K2Node_FormatText.h"
+#include "K2Node_MacroInstance.h"
+#include "Kismet/KismetTextLibrary.h"
+#include "Misc/TransactionObjectEvent.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace UE::Internal::CallGraphHelpers
+{
+	// Nodes of a graph and of the collapsed graphs nested in it.
+	static void GatherNodes(const UEdGraph* Graph, TArray<const UEdGraphNode*>& OutNodes)
+	{
+		TArray<const UEdGraph*, TInlineAllocator<4>> Graphs;
+		Graphs.Add(Graph);
+		while (Graphs.Num() > 0)
+		{
+			const UEdGraph* Current = Graphs.Pop(EAllowShrinking::No);
+			for (const UEdGraphNode* Node : Current->Nodes)
+			{
+				if (!Node)
+				{
+					continue;
+				}
+
+				OutNodes.Add(Node);
+				if (const UK2Node_Composite* Composite = Cast<UK2Node_Composite>(Node))
+				{
+					if (Composite->BoundGraph)
+					{
+						Graphs.Add(Composite->BoundGraph);
+					}
+				}
+			}
+		}
+	}
+} // namespace UE::Internal::CallGraphHelpers
+
+
+FCommonValidatorsCallGraph& FCommonValidatorsCallGraph::Get()
+{
+	static FCommonValidatorsCallGraph Instance;
+	return Instance;
+}
+
+void FCommonValidatorsCallGraph::Initialize()
+{
+	ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddRaw(this, &FCommonValidatorsCallGraph::OnObjectModified);
+	ObjectTransactedHandle = FCoreUObjectDelegates::OnObjectTransacted.AddRaw(this, &FCommonValidatorsCallGraph::OnObjectTransacted);
+	PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FCommonValidatorsCallGraph::OnPostGarbageCollect);
+}
+
+void FCommonValidatorsCallGraph::Shutdown()
+{
+	FCoreUObjectDelegates::OnObjectModified.Remove(ObjectModifiedHandle);
+	FCoreUObjectDelegates::OnObjectTransacted.Remove(ObjectTransactedHandle);
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+
+	Reset();
+}
+
+bool FCommonValidatorsCallGraph::IsBlockingLoadFunction(FName FunctionName)
+{
+	static const FName LoadAssetBlockingFunctionName(TEXT("LoadAsset_Blocking"));
+	static const FName LoadClassAssetBlockingFunctionName(TEXT("LoadClassAsset_Blocking"));
+
+	return FunctionName == LoadAssetBlockingFunctionName || FunctionName == LoadClassAssetBlockingFunctionName;
+}
+
+FName FCommonValidatorsCallGraph::GetFunctionOwnerName(const UFunction* Function)
+{
+	const UClass* OwnerClass = Function ? Function->GetOwnerClass() : nullptr;
+	if (!OwnerClass)
+	{
+		return NAME_None;
+	}
+
+	// Calls into Blueprints resolve to the skeleton class
+	const UBlueprint* Blueprint = UBlueprint::GetBlueprintFromClass(OwnerClass);
+	if (Blueprint && Blueprint->GeneratedClass)
+	{
+		return Blueprint->GeneratedClass->GetFName();
+	}
+	return OwnerClass->GetFName();
+}
+
+const UFunction* FCommonValidatorsCallGraph::GetExpandedFunction(const UEdGraphNode* Node)
+{
+	if (Node && Node->IsA<UK2Node_FormatText>())
+	{
+		static const UFunction* FormatFunction = UKismetTextLibrary::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UKismetTextLibrary, Format));
+		return FormatFunction;
+	}
+	return nullptr;
+}
+
+TSharedPtr<const FCommonValidatorsCallSummary> FCommonValidatorsCallGraph::GetCallSummary(const UEdGraphNode* Node, TSet<TObjectKey<UBlueprint>>& InOutDependencies)
+{
+	check(IsInGameThread());
+
+	FCallee Callee;
+	if (!ResolveCallee(Node, Callee))
+	{
+		return nullptr;
+	}
+
+	// Nothing is in progress out here, so the outermost summary is always complete.
+	int32 LowestDepth = 0;
+	TSharedPtr<const FCommonValidatorsCallSummary> Summary = Summarize(Callee, LowestDepth);
+	if (Summary)
+	{
+		InOutDependencies.Append(Summary->Dependencies);
+	}
+	return Summary;
+}
+
+void FCommonValidatorsCallGraph::Reset()
+{
+	Summaries.Reset();
+	SummarizedBlueprints.Reset();
+}
+
+bool FCommonValidatorsCallGraph::ResolveCallee(const UEdGraphNode* Node, FCallee& OutCallee)
+{
+	if (const UK2Node_CallFunction* CallNode = Cast<UK2Node_CallFunction>(Node))
+	{
+		const UFunction* Function = CallNode->GetTargetFunction();
+		const UBlueprint* Blueprint = Function ? UBlueprint::GetBlueprintFromClass(Function->GetOwnerClass()) : nullptr;
+		if (!Blueprint)
+		{
+			return false;
+		}
+
+		// Custom events called as functions live in the event graph and aren't followed.
+		const TObjectPtr<UEdGraph>* FunctionGraph = Blueprint->FunctionGraphs.FindByPredicate([Function](const UEdGraph* Graph)
+		{
+			return Graph && Graph->GetFName() == Function->GetFName();
+		});
+		if (!FunctionGraph)
+		{
+			return false;
+		}
+
+		OutCallee.Graph = *FunctionGraph;
+		OutCallee.Blueprint = Blueprint;
+		return true;
+	}
+
+	if (const UK2Node_MacroInstance* MacroNode = Cast<UK2Node_MacroInstance>(Node))
+	{
+		const UEdGraph* MacroGraph = MacroNode->GetMacroGraph();
+		const UBlueprint* Blueprint = MacroGraph ? MacroGraph->GetTypedOuter<UBlueprint>() : nullptr;
+		if (!Blueprint)
+		{
+			return false;
+		}
+
+		OutCallee.Graph = MacroGraph;
+		OutCallee.Blueprint = Blueprint;
+		return true;
+	}
+
+	return false;
+}
+
+TSharedPtr<const FCommonValidatorsCallSummary> FCommonValidatorsCallGraph::Summarize(const FCallee& Callee, int32& InOutLowestDepth)
+{
+	const TObjectKey<UEdGraph> Key(Callee.Graph);
+	if (const TSharedRef<const FCommonValidatorsCallSummary>* Existing = Summaries.Find(Key))
+	{
+		return *Existing;
+	}
+
+	if (const int32* StackDepth = InProgress.Find(Key))
+	{
+		InOutLowestDepth = FMath::Min(InOutLowestDepth, *StackDepth);
+		return nullptr;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(FCommonValidatorsCallGraph::Summarize);
+
+	const int32 Depth = InProgress.Num();
+	InProgress.Add(Key, Depth);
+	SummarizedBlueprints.Add(Callee.Blueprint);
+
+	TArray<const UEdGraphNode*> Nodes;
+	UE::Internal::CallGraphHelpers::GatherNodes(Callee.Graph, Nodes);
+
+	const FName GraphName = Callee.Graph->GetFName();
+	TSharedRef<FCommonValidatorsCallSummary> Summary = MakeShared<FCommonValidatorsCallSummary>();
+	TSet<TObjectKey<UBlueprint>> Dependencies;
+	Dependencies.Add(Callee.Blueprint);
+
+	TSet<TPair<FName, FName>> SeenCalls;
+	auto AddCall = [&Summary, &SeenCalls, GraphName](FName OwnerName, FName FunctionName, TConstArrayView<FName> NestedChain)
+	{
+		if (Summary->Calls.Num() >= FCommonValidatorsCallSummary::MaxReachedCalls)
+		{
+			return;
+		}
+
+		bool bAlreadySeen = false;
+		SeenCalls.Add({ OwnerName, FunctionName }, &bAlreadySeen);
+		if (!bAlreadySeen)
+		{
+			FCommonValidatorsReachedCall& Call = Summary->Calls.AddDefaulted_GetRef();
+			Call.OwnerName = OwnerName;
+			Call.FunctionName = FunctionName;
+			Call.Chain.Reserve(NestedChain.Num() + 1);
+			Call.Chain.Add(GraphName);
+			Call.Chain.Append(NestedChain);
+		}
+	};
+
+	// Direct calls end the chain right here, record them before following any call.
+	for (const UEdGraphNode* Node : Nodes)
+	{
+		if (const UK2Node_CallFunction* CallNode = Cast<UK2Node_CallFunction>(Node))
+		{
+			const FName FunctionName = CallNode->GetFunctionName();
+			if (Summary->BlockingChain.IsEmpty() && IsBlockingLoadFunction(FunctionName))
+			{
+				Summary->BlockingChain = { GraphName, FunctionName };
+			}
+			AddCall(GetFunctionOwnerName(CallNode->GetTargetFunction()), FunctionName, {});
+		}
+		else if (const UFunction* ExpandedFunction = GetExpandedFunction(Node))
+		{
+			AddCall(GetFunctionOwnerName(ExpandedFunction), ExpandedFunction->GetFName(), {});
+		}
+	}
+
+	int32 LowestDepth = Depth;
+	for (const UEdGraphNode* Node : Nodes)
+	{
+		FCallee NestedCallee;
+		if (!ResolveCallee(Node, NestedCallee))
+		{
+			continue;
+		}
+
+		const TSharedPtr<const FCommonValidatorsCallSummary> NestedSummary = Summarize(NestedCallee, LowestDepth);
+		if (!NestedSummary)
+		{
+			continue;
+		}
+
+		Dependencies.Append(NestedSummary->Dependencies);
+		if (Summary->BlockingChain.IsEmpty() && NestedSummary->BlockingChain.Num() > 0)
+		{
+			Summary->BlockingChain.Reserve(NestedSummary->BlockingChain.Num() + 1);
+			Summary->BlockingChain.Add(GraphName);
+			Summary->BlockingChain.Append(NestedSummary->BlockingChain);
+		}
+
+		for (const FCommonValidatorsReachedCall& Call : NestedSummary->Calls)
+		{
+			AddCall(Call.OwnerName, Call.FunctionName, Call.Chain);
+		}
+	}
+
+	InProgress.Remove(Key);
+	Summary->Dependencies = Dependencies.Array();
+
+	// A graph on a recursive cycle can only be trusted once the whole cycle has been summarized, which happens
+	// when the outermost graph of the cycle returns.
+	if (LowestDepth < Depth)
+	{
+		InOutLowestDepth = FMath::Min(InOutLowestDepth, LowestDepth);
+		return Summary;
+	}
+
+	Summaries.Add(Key, Summary);
+	return Summary;
+}
+
+void FCommonValidatorsCallGraph::OnObjectModified(UObject* Object)
+{
+	if (SummarizedBlueprints.IsEmpty() || !Object)
+	{
+		return;
+	}
+
+	const UBlueprint* Blueprint = Cast<UBlueprint>(Object);
+	if (!Blueprint)
+	{
+		Blueprint = Object->GetTypedOuter<UBlueprint>();
+	}
+
+	// Summaries are cheap to rebuild, so any change to a summarized Blueprint drops all of them
+	// rather than tracking which ones went through it.
+	if (Blueprint && SummarizedBlueprints.Contains(Blueprint))
+	{
+		Reset();
+	}
+}
+
+void FCommonValidatorsCallGraph::OnObjectTransacted(UObject* Object, const FTransactionObjectEvent& TransactionEvent)
+{
+	OnObjectModified(Object);
+}
+
+void FCommonValidatorsCallGraph::OnPostGarbageCollect()
+{
+	for (auto It = Summaries.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().ResolveObjectPtr())
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+class UBlueprint;
+class UEdGraph;
+class UEdGraphNode;
+class UFunction;
+
+// A function called somewhere further down a call chain.
+struct FCommonValidatorsReachedCall
+{
+	// Class declaring the function, the generated class for Blueprint functions.
+	FName OwnerName;
+	FName FunctionName;
+
+	// Graphs from the callee down to the one calling FunctionName.
+	TArray<FName> Chain;
+};
+
+// What a Blueprint function or macro does further down its call chain. Immutable once built, so it can be shared with
+// graph indices analyzed on other threads.
+struct FCommonValidatorsCallSummary
+{
+	// Call chain down to a blocking load, e.g. { LoadWeapon, LoadAsset_Blocking }, empty if it never blocks.
+	TArray<FName> BlockingChain;
+
+	// Every function called further down, once each with the shortest chain found first. Capped to MaxReachedCalls.
+	TArray<FCommonValidatorsReachedCall> Calls;
+
+	TArray<TObjectKey<UBlueprint>> Dependencies;
+
+	static constexpr int32 MaxReachedCalls = 512;
+};
+
+/**
+ * Game thread summaries of what Blueprint functions and macros do further down their call chains, so a call
+ * site can be judged without walking the callee's graphs again for every caller. Each function or macro graph
+ * is summarized once and kept until a Blueprint it depends on changes.
+ */
+class COMMONVALIDATORS_API FCommonValidatorsCallGraph
+{
+public:
+	static FCommonValidatorsCallGraph& Get();
+
+	void Initialize();
+	void Shutdown();
+
+	/**
+	 * Summary of the Blueprint function or macro Node calls, null for anything else. Native functions aren't
+	 * followed. Every Blueprint the answer depends on is added to InOutDependencies.
+	 */
+	TSharedPtr<const FCommonValidatorsCallSummary> GetCallSummary(const UEdGraphNode* Node, TSet<TObjectKey<UBlueprint>>& InOutDependencies);
+
+	void Reset();
+
+	static bool IsBlockingLoadFunction(FName FunctionName);
+
+	// Name of the class declaring Function, as written in settings: the generated class rather than the skeleton for Blueprints.
+	static FName GetFunctionOwnerName(const UFunction* Function);
+
+	// Function a node other than a call turns into when compiled, e.g. UKismetTextLibrary::Format for Format Text.
+	// Null for nodes that don't expand into a single call.
+	static const UFunction* GetExpandedFunction(const UEdGraphNode* Node);
+
+private:
+	// Graphs executed by a call or macro instance node.
+	struct FCallee
+	{
+		const UEdGraph* Graph = nullptr;
+		const UBlueprint* Blueprint = nullptr;
+	};
+
+	static bool ResolveCallee(const UEdGraphNode* Node, FCallee& OutCallee);
+
+	/**
+	 * Returns null for a graph that is still being summarized further up the stack (recursion). Summaries depending
+	 * on such a graph lower InOutLowestDepth to its stack depth and aren't memoized, only the outermost graph of a
+	 * recursive cycle is.
+	 */
+	TSharedPtr<const FCommonValidatorsCallSummary> Summarize(const FCallee& Callee, int32& InOutLowestDepth);
+
+	void OnObjectModified(UObject* Object);
+	void OnObjectTransacted(UObject* Object, const class FTransactionObjectEvent& TransactionEvent);
+	void OnPostGarbageCollect();
+
+	TMap<TObjectKey<UEdGraph>, TSharedRef<const FCommonValidatorsCallSummary>> Summaries;
+	// Graphs being summarized, with their depth on the recursion stack.
+	TMap<TObjectKey<UEdGraph>, int32> InProgress;
+	TSet<TObjectKey<UBlueprint>> SummarizedBlueprints;
+
+	FDelegateHandle ObjectModifiedHandle;
+	FDelegateHandle ObjectTransactedHandle;
+	FDelegateHandle PostGarbageCollectHandle;
+};
@@ -0,0 +1,480 @@
+#include "CommonValidatorsCommandlet.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/ParallelFor.h"
+#include "CommonValidatorsAssetTags.h"
+#include "CommonValidatorsDeveloperSettings.h"
+#include "CommonValidatorsFixer.h"
+#include "CommonValidatorsGraphIndex.h"
+#include "CommonValidatorsLog.h"
+#include "CommonValidatorsProfiler.h"
+#include "CommonValidatorsReport.h"
+#include "CommonValidatorsResultCache.h"
+#include "EditorValidator_BlueprintBase.h"
+#include "EditorValidator_TickCost.h"
+#include "Engine/Blueprint.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/DataValidation.h"
+#include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
+#include "Tasks/Task.h"
+#include "UObject/StrongObjectPtr.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/UObjectHash.h"
+
+namespace UE::Internal::CommonValidatorsCommandletHelpers
+{
+	static constexpr int32 DefaultBatchSize = 256;
+
+	// A loaded Blueprint and the index snapshot the workers analyze.
+	struct FBatchAsset
+	{
+		TStrongObjectPtr<UBlueprint> Blueprint;
+		FString AssetPath;
+		TSharedPtr<const FCommonValidatorsBlueprintIndex> Index;
+	};
+
+	// One validator run on one Blueprint.
+	struct FWorkItem
+	{
+		int32 AssetIndex = INDEX_NONE;
+		int32 ValidatorIndex = INDEX_NONE;
+		EDataValidationResult Result = EDataValidationResult::NotValidated;
+		TArray<FCommonValidatorsFinding> Findings;
+	};
+
+	static void LogFinding(const FString& AssetPath, const UEditorValidator_BlueprintBase* Validator, const FCommonValidatorsFinding& Finding, const FText& Message)
+	{
+		const FString ValidatorName = Validator->GetClass()->GetName();
+		switch (Finding.Severity)
+		{
+		case EMessageSeverity::Error:
+			UE_LOG(LogCommonValidators, Error, TEXT("%s [%s]: %s"), *AssetPath, *ValidatorName, *Message.ToString());
+			break;
+		case EMessageSeverity::Warning:
+		case EMessageSeverity::PerformanceWarning:
+			UE_LOG(LogCommonValidators, Warning, TEXT("%s [%s]: %s"), *AssetPath, *ValidatorName, *Message.ToString());
+			break;
+		default:
+			UE_LOG(LogCommonValidators, Display, TEXT("%s [%s]: %s"), *AssetPath, *ValidatorName, *Message.ToString());
+			break;
+		}
+	}
+
+	// Only depends on the package name, so every shard agrees on the split whatever else differs between agents.
+	static int32 GetShardForPackage(FName PackageName, int32 NumShards)
+	{
+		return static_cast<int32>(FCrc::StrCrc32(*PackageName.ToString().ToLower()) % static_cast<uint32>(NumShards));
+	}
+
+	static TArray<FString> ExpandInputPaths(const FString& InputPaths)
+	{
+		TArray<FString> Patterns;
+		InputPaths.ParseIntoArray(Patterns, TEXT("+"));
+
+		TArray<FString> Paths;
+		for (const FString& Pattern : Patterns)
+		{
+			if (!Pattern.Contains(TEXT("*")))
+			{
+				Paths.Add(Pattern);
+				continue;
+			}
+
+			TArray<FString> FileNames;
+			IFileManager::Get().FindFiles(FileNames, *Pattern, true, false);
+			FileNames.Sort();
+			for (const FString& FileName : FileNames)
+			{
+				Paths.Add(FPaths::Combine(FPaths::GetPath(Pattern), FileName));
+			}
+		}
+		return Paths;
+	}
+} // namespace UE::Internal::CommonValidatorsCommandletHelpers
+
+
+UCommonValidatorsCommandlet::UCommonValidatorsCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+int32 UCommonValidatorsCommandlet::Main(const FString& Params)
+{
+	using namespace UE::Internal::CommonValidatorsCommandletHelpers;
+
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamValues;
+	ParseCommandLine(*Params, Tokens, Switches, ParamValues);
+
+	const FString OutputPath = ParamValues.FindRef(TEXT("Output"));
+	const FString SarifPath = ParamValues.FindRef(TEXT("Sarif"));
+	const FString TickCostReportPath = ParamValues.FindRef(TEXT("TickCostReport"));
+	if (const FString* MergeParam = ParamValues.Find(TEXT("Merge")))
+	{
+		return RunMerge(*MergeParam, OutputPath, SarifPath);
+	}
+
+	const FString* NumShardsParam = ParamValues.Find(TEXT("NumShards"));
+	const FString* ShardParam = ParamValues.Find(TEXT("Shard"));
+	const int32 NumShards = NumShardsParam ? FCString::Atoi(**NumShardsParam) : 1;
+	const int32 Shard = ShardParam ? FCString::Atoi(**ShardParam) : 0;
+	if (NumShards < 1 || Shard < 0 || Shard >= NumShards)
+	{
+		UE_LOG(LogCommonValidators, Error, TEXT("Invalid shard %d of %d, -Shard must be in [0, NumShards)."), Shard, NumShards);
+		return 1;
+	}
+
+	TArray<FString> Paths;
+	ParamValues.FindRef(TEXT("Paths")).ParseIntoArray(Paths, TEXT("+"));
+	if (Paths.IsEmpty())
+	{
+		Paths.Add(TEXT("/Game"));
+	}
+
+	const FString* BatchSizeParam = ParamValues.Find(TEXT("BatchSize"));
+	const int32 BatchSize = FMath::Max(1, BatchSizeParam ? FCString::Atoi(**BatchSizeParam) : DefaultBatchSize);
+	const bool bPrefilter = !Switches.Contains(TEXT("NoPrefilter"));
+	const bool bUseCache = !Switches.Contains(TEXT("NoCache")) && GetDefault<UCommonValidatorsDeveloperSettings>()->bEnableResultCache;
+	const bool bFix = Switches.Contains(TEXT("Fix"));
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	FARFilter Filter;
+	Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+	Filter.bRecursiveClasses = true;
+	Filter.bRecursivePaths = true;
+	for (const FString& Path : Paths)
+	{
+		Filter.PackagePaths.Add(FName(*Path));
+	}
+
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssets(Filter, Assets);
+	if (NumShards > 1)
+	{
+		Assets.RemoveAllSwap([Shard, NumShards](const FAssetData& AssetData)
+		{
+			return GetShardForPackage(AssetData.PackageName, NumShards) != Shard;
+		});
+	}
+	const int32 NumFound = Assets.Num();
+
+	if (bPrefilter)
+	{
+		TArray<FAssetData> NeedingLoad;
+		FCommonValidatorsAssetTags::FilterAssetsNeedingLoad(Assets, NeedingLoad);
+		Assets = MoveTemp(NeedingLoad);
+	}
+	Assets.Sort([](const FAssetData& A, const FAssetData& B) { return A.PackageName.LexicalLess(B.PackageName); });
+
+	const TArray<const UEditorValidator_BlueprintBase*> Validators = UEditorValidator_BlueprintBase::GetEnabledValidators();
+	UE_LOG(LogCommonValidators, Display, TEXT("Validating %d of %d Blueprints under %s with %d validators (shard %d of %d)"),
+		Assets.Num(), NumFound, *FString::Join(Paths, TEXT(", ")), Validators.Num(), Shard, NumShards);
+
+	if (Validators.IsEmpty())
+	{
+		// Still write empty result files below, a merge expects one from every shard.
+		Assets.Reset();
+	}
+
+	FCommonValidatorsReportWriter ReportWriter;
+	if (!OutputPath.IsEmpty() && !ReportWriter.Open(OutputPath))
+	{
+		return 1;
+	}
+	TArray<FCommonValidatorsResultRecord> SarifRecords;
+	TArray<FCommonValidatorsTickCostRecord> TickCostRecords;
+
+	auto RequestLoads = [&Assets, BatchSize](int32 BatchStart)
+	{
+		const int32 BatchEnd = FMath::Min(BatchStart + BatchSize, Assets.Num());
+		for (int32 AssetIndex = BatchStart; AssetIndex < BatchEnd; ++AssetIndex)
+		{
+			LoadPackageAsync(Assets[AssetIndex].PackageName.ToString());
+		}
+	};
+
+	int32 NumValidated = 0;
+	int32 NumInvalid = 0;
+	int32 NumFindings = 0;
+	int32 NumFixes = 0;
+	double AnalysisSeconds = 0.0;
+	FCommonValidatorsFixer Fixer;
+
+	RequestLoads(0);
+	for (int32 BatchStart = 0; BatchStart < Assets.Num(); BatchStart += BatchSize)
+	{
+		const int32 BatchEnd = FMath::Min(BatchStart + BatchSize, Assets.Num());
+		FlushAsyncLoading();
+
+		// Snapshot the batch on the game thread. From here on the workers only see the indices.
+		TArray<FBatchAsset> Batch;
+		Batch.Reserve(BatchEnd - BatchStart);
+		for (int32 AssetIndex = BatchStart; AssetIndex < BatchEnd; ++AssetIndex)
+		{
+			UBlueprint* Blueprint = Cast<UBlueprint>(Assets[AssetIndex].GetAsset());
+			if (!Blueprint)
+			{
+				UE_LOG(LogCommonValidators, Warning, TEXT("Failed to load %s"), *Assets[AssetIndex].GetObjectPathString());
+				continue;
+			}
+
+			FBatchAsset& Asset = Batch.AddDefaulted_GetRef();
+			Asset.Blueprint.Reset(Blueprint);
+			Asset.AssetPath = Blueprint->GetPathName();
+			Asset.Index = FCommonValidatorsGraphIndexCache::Get().FindOrBuild(Blueprint);
+		}
+
+		// The previous batch has been reported and released, get rid of it before streaming in the next one.
+		FCommonValidatorsGraphIndexCache::Get().Reset();
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+		if (BatchEnd < Assets.Num())
+		{
+			RequestLoads(BatchEnd);
+		}
+
+		TArray<FWorkItem> WorkItems;
+		WorkItems.Reserve(Batch.Num() * Validators.Num());
+		for (int32 AssetIndex = 0; AssetIndex < Batch.Num(); ++AssetIndex)
+		{
+			for (int32 ValidatorIndex = 0; ValidatorIndex < Validators.Num(); ++ValidatorIndex)
+			{
+				FWorkItem& Item = WorkItems.AddDefaulted_GetRef();
+				Item.AssetIndex = AssetIndex;
+				Item.ValidatorIndex = ValidatorIndex;
+			}
+		}
+
+		const double AnalysisStart = FPlatformTime::Seconds();
+		UE::Tasks::FTask AnalysisTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [&WorkItems, &Batch, &Validators, bUseCache]()
+		{
+			ParallelFor(WorkItems.Num(), [&WorkItems, &Batch, &Validators, bUseCache](int32 ItemIndex)
+			{
+				FWorkItem& Item = WorkItems[ItemIndex];
+				const FBatchAsset& Asset = Batch[Item.AssetIndex];
+				Item.Result = Validators[Item.ValidatorIndex]->AnalyzeWithCache(Asset.AssetPath, *Asset.Index, bUseCache, Item.Findings);
+			});
+		});
+
+		// Keep streaming in the next batch while the workers are busy.
+		while (!AnalysisTask.IsCompleted())
+		{
+			if (IsAsyncLoading())
+			{
+				ProcessAsyncLoading(true, false, 0.005f);
+			}
+			else
+			{
+				FPlatformProcess::Sleep(0.001f);
+			}
+		}
+		AnalysisTask.Wait();
+		AnalysisSeconds += FPlatformTime::Seconds() - AnalysisStart;
+
+		// Messages need node titles, so reporting happens back on the game thread.
+		TBitArray<> InvalidAssets(false, Batch.Num());
+		for (FWorkItem& Item : WorkItems)
+		{
+			const FBatchAsset& Asset = Batch[Item.AssetIndex];
+			for (FCommonValidatorsFinding& Finding : Item.Findings)
+			{
+				UEdGraphNode* Node = UEditorValidator_BlueprintBase::FindNode(*Asset.Index, Finding);
+				const FText Message = UEditorValidator_BlueprintBase::FormatMessage(Finding, Node);
+				LogFinding(Asset.AssetPath, Validators[Item.ValidatorIndex], Finding, Message);
+				if (bFix)
+				{
+					Fixer.AddFinding(Asset.Blueprint.Get(), Node, Finding);
+				}
+				Finding.Message = Message.ToString();
+			}
+
+			NumFindings += Item.Findings.Num();
+
+			// Clean results are left out of the result files, the shard line carries the number of validated assets.
+			if (Item.Result == EDataValidationResult::Invalid || !Item.Findings.IsEmpty())
+			{
+				FCommonValidatorsResultRecord Record;
+				Record.AssetPath = Asset.AssetPath;
+				Record.Validator = Validators[Item.ValidatorIndex]->GetClass()->GetName();
+				Record.Result = Item.Result;
+				Record.Findings = MoveTemp(Item.Findings);
+				ReportWriter.WriteRecord(Record);
+				if (!SarifPath.IsEmpty())
+				{
+					SarifRecords.Add(MoveTemp(Record));
+				}
+			}
+
+			if (Item.Result == EDataValidationResult::Invalid)
+			{
+				InvalidAssets[Item.AssetIndex] = true;
+			}
+		}
+
+		// Every fix of a Blueprint at once, so each is compiled and saved a single time. Compiling needs the next
+		// batch to be done streaming in.
+		if (bFix)
+		{
+			FlushAsyncLoading();
+			NumFixes += Fixer.Apply(true);
+		}
+
+		if (!TickCostReportPath.IsEmpty())
+		{
+			for (const FBatchAsset& Asset : Batch)
+			{
+				FCommonValidatorsTickCost Cost;
+				UEditorValidator_TickCost::ComputeTickCost(*Asset.Index, Cost);
+				if (Cost.TickCost > 0.0f || Cost.ConstructionScriptCost > 0.0f)
+				{
+					TickCostRecords.Add({ Asset.AssetPath, Cost.BudgetClassName, Cost.TickCost, Cost.TickBudget, Cost.ConstructionScriptCost, Cost.ConstructionScriptBudget });
+				}
+			}
+		}
+
+		NumValidated += Batch.Num();
+		NumInvalid += InvalidAssets.CountSetBits();
+
+		UE_LOG(LogCommonValidators, Display, TEXT("Validated %d/%d Blueprints"), BatchEnd, Assets.Num());
+	}
+
+	FCommonValidatorsResultCache::Get().Flush();
+
+	FCommonValidatorsShardInfo ShardInfo;
+	ShardInfo.Shard = Shard;
+	ShardInfo.NumShards = NumShards;
+	ShardInfo.NumValidated = NumValidated;
+	ReportWriter.WriteShardInfo(ShardInfo);
+	ReportWriter.Close();
+
+	if (!SarifPath.IsEmpty() && !FCommonValidatorsReportWriter::WriteSarif(SarifPath, SarifRecords))
+	{
+		return 1;
+	}
+
+	if (!TickCostReportPath.IsEmpty() && !FCommonValidatorsReportWriter::WriteTickCostRanking(TickCostReportPath, MoveTemp(TickCostRecords)))
+	{
+		return 1;
+	}
+
+	if (const FString* SlowestParam = ParamValues.Find(TEXT("Slowest")))
+	{
+		FCommonValidatorsProfiler::Get().PrintSlowest(FCString::Atoi(**SlowestParam));
+	}
+
+	const double TotalSeconds = FPlatformTime::Seconds() - StartTime;
+	UE_LOG(LogCommonValidators, Display, TEXT("Validated %d Blueprints in %.2fs (%.1f assets/sec, %.1f assets/sec analysis only), %d invalid, %d findings"),
+		NumValidated, TotalSeconds, NumValidated / FMath::Max(TotalSeconds, UE_SMALL_NUMBER),
+		NumValidated / FMath::Max(AnalysisSeconds, UE_SMALL_NUMBER), NumInvalid, NumFindings);
+	if (bFix)
+	{
+		UE_LOG(LogCommonValidators, Display, TEXT("Applied %d fixes"), NumFixes);
+	}
+
+	return NumInvalid > 0 ? 1 : 0;
+}
+
+int32 UCommonValidatorsCommandlet::RunMerge(const FString& InputPaths, const FString& OutputPath, const FString& SarifPath)
+{
+	using namespace UE::Internal::CommonValidatorsCommandletHelpers;
+
+	TArray<FCommonValidatorsShardInfo> Shards;
+	TArray<FCommonValidatorsResultRecord> Records;
+	for (const FString& InputPath : ExpandInputPaths(InputPaths))
+	{
+		if (!FCommonValidatorsReportWriter::ReadJsonLines(InputPath, Shards, Records))
+		{
+			return 1;
+		}
+	}
+
+	if (Shards.IsEmpty())
+	{
+		UE_LOG(LogCommonValidators, Error, TEXT("No shard results found in %s."), *InputPaths);
+		return 1;
+	}
+
+	// A missing shard would silently pass every Blueprint it owns.
+	const int32 NumShards = Shards[0].NumShards;
+	TBitArray<> SeenShards(false, NumShards);
+	int32 NumValidated = 0;
+	for (const FCommonValidatorsShardInfo& ShardInfo : Shards)
+	{
+		if (ShardInfo.NumShards != NumShards || ShardInfo.Shard < 0 || ShardInfo.Shard >= NumShards)
+		{
+			UE_LOG(LogCommonValidators, Error, TEXT("Shard %d of %d doesn't belong to a %d shard run."), ShardInfo.Shard, ShardInfo.NumShards, NumShards);
+			return 1;
+		}
+		if (SeenShards[ShardInfo.Shard])
+		{
+			UE_LOG(LogCommonValidators, Warning, TEXT("Shard %d was given more than once, merging its duplicate results."), ShardInfo.Shard);
+			continue;
+		}
+		SeenShards[ShardInfo.Shard] = true;
+		NumValidated += ShardInfo.NumValidated;
+	}
+
+	int32 NumMissing = 0;
+	for (int32 Shard = 0; Shard < NumShards; ++Shard)
+	{
+		if (!SeenShards[Shard])
+		{
+			UE_LOG(LogCommonValidators, Error, TEXT("Results of shard %d of %d are missing."), Shard, NumShards);
+			++NumMissing;
+		}
+	}
+
+	FCommonValidatorsReportWriter::SortAndDeduplicate(Records);
+
+	TSet<FString> InvalidAssets;
+	int32 NumFindings = 0;
+	for (const FCommonValidatorsResultRecord& Record : Records)
+	{
+		NumFindings += Record.Findings.Num();
+		if (Record.Result == EDataValidationResult::Invalid)
+		{
+			InvalidAssets.Add(Record.AssetPath);
+		}
+	}
+	const int32 NumInvalid = InvalidAssets.Num();
+
+	if (!OutputPath.IsEmpty())
+	{
+		FCommonValidatorsReportWriter ReportWriter;
+		if (!ReportWriter.Open(OutputPath))
+		{
+			return 1;
+		}
+
+		for (const FCommonValidatorsResultRecord& Record : Records)
+		{
+			ReportWriter.WriteRecord(Record);
+		}
+
+		FCommonValidatorsShardInfo Merged;
+		Merged.NumValidated = NumValidated;
+		ReportWriter.WriteShardInfo(Merged);
+	}
+
+	if (!SarifPath.IsEmpty() && !FCommonValidatorsReportWriter::WriteSarif(SarifPath, Records))
+	{
+		return 1;
+	}
+
+	UE_LOG(LogCommonValidators, Display, TEXT("Merged %d shards: %d Blueprints validated, %d invalid, %d findings"),
+		NumShards - NumMissing, NumValidated, NumInvalid, NumFindings);
+
+	return NumInvalid > 0 || NumMissing > 0 ? 1 : 0;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "CommonValidatorsCommandlet.generated.h"
+
+/**
+ * Headless validation of every Blueprint under the given content paths with the CommonValidators validators.
+ * Assets are loaded in batches: while one batch is analyzed on worker threads, the next one is streamed in.
+ *
+ * UnrealEditor-Cmd <Project> -run=CommonValidators [-Paths=/Game/A+/Game/B] [-BatchSize=256] [-NoPrefilter] [-NoCache]
+ *     [-Shard=N -NumShards=M] [-Output=Results.jsonl] [-Sarif=Results.sarif] [-Slowest=N]
+ *     [-TickCostReport=TickCosts.csv] [-Fix]
+ *
+ * With -Shard, only the Blueprints whose package name hashes to that shard are validated. The JSON-lines files
+ * of all shards are then combined with:
+ *
+ * UnrealEditor-Cmd <Project> -run=CommonValidators -Merge=Shard0.jsonl+Shard1.jsonl [-Output=Merged.jsonl] [-Sarif=Merged.sarif]
+ *
+ * -Slowest=N logs the N slowest Blueprints of every validator at the end.
+ *
+ * -TickCostReport ranks the validated Blueprints by estimated Tick cost, as CSV for a .csv path and JSON otherwise.
+ *
+ * -Fix applies the fixes findings offer (removing empty Tick nodes), then compiles and saves each fixed Blueprint once.
+ * Findings are still reported as found before fixing.
+ *
+ * Returns 1 when any Blueprint failed validation.
+ */
+UCLASS()
+class UCommonValidatorsCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UCommonValidatorsCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	int32 RunMerge(const FString& InputPaths, const FString& OutputPath, const FString& SarifPath);
+};
@@ -1 +1,87 @@
 #include "CommonValidatorsDeveloperSettings.h"
+
+UCommonValidatorsDeveloperSettings::UCommonValidatorsDeveloperSettings()
+{
+	const TCHAR* HarmlessClassPaths[] = {
+		TEXT("/Script/Engine.KismetMathLibrary"),
+		TEXT("/Script/Engine.KismetSystemLibrary"),
+		TEXT("/Script/Engine.KismetTextLibrary"),
+		TEXT("/Script/Engine.KismetStringTableLibrary"),
+		TEXT("/Script/Engine.KismetRenderingLibrary"),
+		TEXT("/Script/Engine.KismetMaterialLibrary"),
+		TEXT("/Script/Engine.KismetInternationalizationLibrary"),
+		TEXT("/Script/Engine.KismetInputLibrary"),
+		TEXT("/Script/Engine.KismetGuidLibrary"),
+		TEXT("/Script/Engine.KismetArrayLibrary"),
+		TEXT("/Script/Engine.GameplayStatics"),
+		TEXT("/Script/Engine.DataTableFunctionLibrary"),
+		TEXT("/Script/Engine.BlueprintSetLibrary"),
+		TEXT("/Script/Engine.BlueprintPlatformLibrary"),
+		TEXT("/Script/Engine.BlueprintPathsLibrary"),
+		TEXT("/Script/Engine.BlueprintMapLibrary"),
+		TEXT("/Script/Engine.BlueprintInstancedStructLibrary"),
+		TEXT("/Script/Engine.KismetNodeHelperLibrary")
+	};
+
+	for (const TCHAR* ClassPath : HarmlessClassPaths)
+	{
+		HarmlessPureNodeClasses.Emplace(FSoftObjectPath(ClassPath));
+	}
+
+	HarmlessPureNodeMetadataTags = { TEXT("NativeBreakFunc"), TEXT("NativeMakeFunc") };
+
+	const TPair<const TCHAR*, const TCHAR*> ExpensiveTickFunctionPaths[] = {
+		{ TEXT("/Script/Engine.GameplayStatics"), TEXT("GetAllActorsOfClass") },
+		{ TEXT("/Script/Engine.GameplayStatics"), TEXT("GetAllActorsOfClassWithTag") },
+		{ TEXT("/Script/Engine.GameplayStatics"), TEXT("GetAllActorsWithTag") },
+		{ TEXT("/Script/Engine.GameplayStatics"), TEXT("GetAllActorsWithInterface") },
+		{ TEXT("/Script/Engine.GameplayStatics"), TEXT("GetActorOfClass") },
+		{ TEXT("/Script/Engine.Actor"), TEXT("GetComponentByClass") },
+		{ TEXT("/Script/Engine.Actor"), TEXT("K2_GetComponentsByClass") },
+		{ TEXT("/Script/Engine.Actor"), TEXT("GetComponentsByTag") },
+		{ TEXT("/Script/Engine.Actor"), TEXT("GetComponentsByInterface") },
+		{ TEXT("/Script/Engine.KismetMathLibrary"), TEXT("FindLookAtRotation") },
+		{ TEXT("/Script/Engine.KismetSystemLibrary"), TEXT("LineTraceSingle") },
+		{ TEXT("/Script/Engine.KismetSystemLibrary"), TEXT("LineTraceMulti") },
+		{ TEXT("/Script/Engine.KismetSystemLibrary"), TEXT("LineTraceSingleForObjects") },
+		{ TEXT("/Script/Engine.KismetSystemLibrary"), TEXT("LineTraceMultiForObjects") },
+		{ TEXT("/Script/Engine.KismetSystemLibrary"), TEXT("SphereTraceSingle") },
+		{ TEXT("/Script/Engine.KismetSystemLibrary"), TEXT("SphereTraceMulti") },
+		{ TEXT("/Script/Engine.KismetSystemLibrary"), TEXT("BoxTraceSingle") },
+		{ TEXT("/Script/Engine.KismetSystemLibrary"), TEXT("BoxTraceMulti") },
+		{ TEXT("/Script/Engine.KismetSystemLibrary"), TEXT("CapsuleTraceSingle") },
+		{ TEXT("/Script/Engine.KismetSystemLibrary"), TEXT("CapsuleTraceMulti") },
+		{ TEXT("/Script/Engine.KismetSystemLibrary"), TEXT("SphereOverlapActors") },
+		{ TEXT("/Script/Engine.KismetSystemLibrary"), TEXT("BoxOverlapActors") },
+		{ TEXT("/Script/Engine.KismetStringLibrary"), TEXT("Concat_StrStr") },
+		{ TEXT("/Script/Engine.KismetTextLibrary"), TEXT("Format") }
+	};
+
+	for (const TPair<const TCHAR*, const TCHAR*>& FunctionPath : ExpensiveTickFunctionPaths)
+	{
+		FCommonValidatorsFunctionReference& Function = ExpensiveTickFunctions.AddDefaulted_GetRef();
+		Function.Class = TSoftClassPtr<UObject>(FSoftObjectPath(FunctionPath.Key));
+		Function.FunctionName = FunctionPath.Value;
+
+		// Every function too expensive to call every frame costs a lot more than an ordinary node.
+		FCommonValidatorsFunctionCost& Cost = TickCostFunctions.AddDefaulted_GetRef();
+		Cost.Class = Function.Class;
+		Cost.FunctionName = Function.FunctionName;
+		Cost.Cost = 20.0f;
+	}
+
+	const TPair<const TCHAR*, float> TickBudgetClassPaths[] = {
+		{ TEXT("/Script/Engine.Actor"), 200.0f },
+		{ TEXT("/Script/Engine.ActorComponent"), 100.0f },
+		{ TEXT("/Script/UMG.UserWidget"), 100.0f },
+		{ TEXT("/Script/Engine.AnimInstance"), 200.0f }
+	};
+
+	for (const TPair<const TCHAR*, float>& BudgetPath : TickBudgetClassPaths)
+	{
+		FCommonValidatorsTickBudget& Budget = TickCostBudgets.AddDefaulted_GetRef();
+		Budget.ParentClass = TSoftClassPtr<UObject>(FSoftObjectPath(BudgetPath.Key));
+		Budget.TickBudget = BudgetPath.Value;
+		Budget.ConstructionScriptBudget = BudgetPath.Value * 2.0f;
+	}
+}
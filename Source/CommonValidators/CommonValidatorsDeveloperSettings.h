@@ -1,15 +1,121 @@
 #pragma once
 
+#include "EdGraph/EdGraphNode.h"
 #include "Engine/DeveloperSettings.h"
 
 #include "CommonValidatorsDeveloperSettings.generated.h"
 
+// A single function, identified by its owning class and name.
+USTRUCT()
+struct COMMONVALIDATORS_API FCommonValidatorsFunctionReference
+{
+	GENERATED_BODY()
+
+	// Class (native or Blueprint function library) declaring the function.
+	UPROPERTY(EditAnywhere, meta = (AllowAbstract = true))
+	TSoftClassPtr<UObject> Class;
+
+	UPROPERTY(EditAnywhere)
+	FName FunctionName;
+};
+
+// Estimated cost of a single call to a function, in the same units as UCommonValidatorsDeveloperSettings::TickCostPerNode.
+USTRUCT()
+struct COMMONVALIDATORS_API FCommonValidatorsFunctionCost
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, meta = (AllowAbstract = true))
+	TSoftClassPtr<UObject> Class;
+
+	UPROPERTY(EditAnywhere)
+	FName FunctionName;
+
+	UPROPERTY(EditAnywhere, meta = (ClampMin = 0))
+	float Cost = 1.0f;
+};
+
+// Cost budgets of the Blueprints deriving from a class. 0 means no budget.
+USTRUCT()
+struct COMMONVALIDATORS_API FCommonValidatorsTickBudget
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, meta = (AllowAbstract = true))
+	TSoftClassPtr<UObject> ParentClass;
+
+	// Estimated cost of everything the Tick events run every frame.
+	UPROPERTY(EditAnywhere, meta = (ClampMin = 0))
+	float TickBudget = 0.0f;
+
+	// Estimated cost of one run of the construction script.
+	UPROPERTY(EditAnywhere, meta = (ClampMin = 0))
+	float ConstructionScriptBudget = 0.0f;
+};
+
+UENUM()
+enum class ECommonValidatorsRuleSeverity : uint8
+{
+	Info,
+	Warning,
+	Error
+};
+
+// Which nodes of a Blueprint a rule applies to.
+UENUM()
+enum class ECommonValidatorsRuleScope : uint8
+{
+	Anywhere,
+
+	// Nodes run every frame by a Tick event, including the pure nodes they read.
+	Tick,
+
+	// Nodes run by the construction script, including the pure nodes they read.
+	ConstructionScript
+};
+
+// A node that should not be used, see UCommonValidatorsDeveloperSettings::NodeRules. A node matches when it satisfies
+// every criterion that is set, so at least one of them must be.
+USTRUCT()
+struct COMMONVALIDATORS_API FCommonValidatorsNodeRule
+{
+	GENERATED_BODY()
+
+	// Name of the function called.
+	UPROPERTY(EditAnywhere)
+	FName FunctionName;
+
+	// Class declaring the function called.
+	UPROPERTY(EditAnywhere, meta = (AllowAbstract = true))
+	TSoftClassPtr<UObject> OwnerClass;
+
+	// Class of the node, subclasses included.
+	UPROPERTY(EditAnywhere, meta = (AllowAbstract = true))
+	TSoftClassPtr<UEdGraphNode> NodeClass;
+
+	// Metadata tag of the function called, e.g. DevelopmentOnly.
+	UPROPERTY(EditAnywhere)
+	FName MetadataTag;
+
+	UPROPERTY(EditAnywhere)
+	ECommonValidatorsRuleSeverity Severity = ECommonValidatorsRuleSeverity::Warning;
+
+	UPROPERTY(EditAnywhere)
+	ECommonValidatorsRuleScope Scope = ECommonValidatorsRuleScope::Anywhere;
+
+	// Reported for every matching node, {Node} is replaced by its title.
+	UPROPERTY(EditAnywhere)
+	FString Message;
+};
+
 UCLASS(config = Editor, defaultconfig, meta = (DisplayName = "Common Validators"))
 class COMMONVALIDATORS_API UCommonValidatorsDeveloperSettings : public UDeveloperSettings
 {
 	GENERATED_BODY()
 
 public:
+	UCommonValidatorsDeveloperSettings();
+
 	// If true, we will validate for empty tick nodes.
 	UPROPERTY(Config, EditAnywhere)
 	bool bEnableEmptyTickNodeValidator = true;
@@ -25,7 +131,50 @@ public:
 	//If true, we throw an error, otherwise a warning!
 	UPROPERTY(Config, EditAnywhere, meta = (EditCondition = "bEnablePureNodeMultiExecValidator == true"))
 	bool bErrorOnPureNodeMultiExec = true;
+
+	// Pure functions declared by these classes are considered cheap enough to be evaluated more than once.
+	UPROPERTY(Config, EditAnywhere, meta = (EditCondition = "bEnablePureNodeMultiExecValidator == true", AllowAbstract = true))
+	TArray<TSoftClassPtr<UObject>> HarmlessPureNodeClasses;
+
+	// Individual pure functions that are considered cheap enough to be evaluated more than once.
+	UPROPERTY(Config, EditAnywhere, meta = (EditCondition = "bEnablePureNodeMultiExecValidator == true"))
+	TArray<FCommonValidatorsFunctionReference> HarmlessPureNodeFunctions;
+
+	// Pure functions carrying any of these metadata tags are considered cheap enough to be evaluated more than once.
+	UPROPERTY(Config, EditAnywhere, meta = (EditCondition = "bEnablePureNodeMultiExecValidator == true"))
+	TArray<FName> HarmlessPureNodeMetadataTags;
+
+	// Pure functions declared by a class whose name contains any of these strings are considered cheap enough to be
+	// evaluated more than once. This is how the classes above were matched before they became a list of classes, e.g.
+	// "GameplayStatics" also matched subclasses of other libraries named after it. Prefer listing the classes.
+	UPROPERTY(Config, EditAnywhere, AdvancedDisplay, meta = (EditCondition = "bEnablePureNodeMultiExecValidator == true"))
+	TArray<FString> HarmlessPureNodeClassNameSubstrings;
+	
+	// If true, we will validate for identical pure computations wired up more than once in the same graph
+	UPROPERTY(Config, EditAnywhere)
+	bool bEnableDuplicatePureValidator = true;
+
+	//If true, we throw an error, otherwise a warning!
+	UPROPERTY(Config, EditAnywhere, meta = (EditCondition = "bEnableDuplicatePureValidator == true"))
+	bool bErrorOnDuplicatePure = false;
+
+	// Pure nodes a duplicated computation must have, including the node computing the result, to be reported.
+	UPROPERTY(Config, EditAnywhere, meta = (EditCondition = "bEnableDuplicatePureValidator == true", ClampMin = 1))
+	int32 DuplicatePureMinNodes = 2;
 	
+	// If true, we will validate for large by-value copies made inside loops and on Tick
+	UPROPERTY(Config, EditAnywhere)
+	bool bEnableLargeCopyValidator = true;
+
+	//If true, we throw an error, otherwise a warning!
+	UPROPERTY(Config, EditAnywhere, meta = (EditCondition = "bEnableLargeCopyValidator == true"))
+	bool bErrorOnLargeCopy = false;
+
+	// Bytes a node may copy by value every time it runs inside a loop or on Tick. Containers passed by value are
+	// assumed to hold 8 elements.
+	UPROPERTY(Config, EditAnywhere, meta = (EditCondition = "bEnableLargeCopyValidator == true", ClampMin = 1, Units = "Bytes"))
+	int32 LargeCopyThresholdBytes = 256;
+
 	// If true, we will validate for blocking loads in blueprints
 	UPROPERTY(Config, EditAnywhere)
 	bool bEnableBlockingLoadValidator = true;
@@ -33,4 +182,137 @@ public:
 	//If true, we throw an error, otherwise a warning!
 	UPROPERTY(Config, EditAnywhere, meta = (EditCondition = "bEnableBlockingLoadValidator == true"))
 	bool bErrorBlockingLoad = true;
+
+	// If true, calls to Blueprint functions and macros that do a blocking load further down are flagged as well,
+	// across Blueprints and function libraries.
+	UPROPERTY(Config, EditAnywhere, meta = (EditCondition = "bEnableBlockingLoadValidator == true"))
+	bool bBlockingLoadFollowCalls = true;
+
+	// If true, we will validate for expensive calls made every frame by Tick events
+	UPROPERTY(Config, EditAnywhere)
+	bool bEnableExpensiveTickValidator = true;
+
+	//If true, we throw an error, otherwise a warning!
+	UPROPERTY(Config, EditAnywhere, meta = (EditCondition = "bEnableExpensiveTickValidator == true"))
+	bool bErrorOnExpensiveTick = false;
+
+	// Functions too expensive to call every frame. Everything a Tick event executes is checked against them, including
+	// the pure nodes it reads and the Blueprint functions and macros it calls.
+	UPROPERTY(Config, EditAnywhere, meta = (EditCondition = "bEnableExpensiveTickValidator == true"))
+	TArray<FCommonValidatorsFunctionReference> ExpensiveTickFunctions;
+
+	// If true, we will validate actors and component templates that tick without anything to do
+	UPROPERTY(Config, EditAnywhere)
+	bool bEnableIdleTickValidator = true;
+
+	//If true, we throw an error, otherwise a warning!
+	UPROPERTY(Config, EditAnywhere, meta = (EditCondition = "bEnableIdleTickValidator == true"))
+	bool bErrorOnIdleTick = false;
+
+	// If true, Tick events that run every frame without using Delta Seconds get a suggestion to set a Tick Interval.
+	UPROPERTY(Config, EditAnywhere, meta = (EditCondition = "bEnableIdleTickValidator == true"))
+	bool bSuggestTickInterval = true;
+
+	// If true, we will validate replicated variables and RPCs for bandwidth and server CPU costs
+	UPROPERTY(Config, EditAnywhere)
+	bool bEnableReplicationValidator = true;
+
+	//If true, we throw an error, otherwise a warning!
+	UPROPERTY(Config, EditAnywhere, meta = (EditCondition = "bEnableReplicationValidator == true"))
+	bool bErrorOnReplication = false;
+
+	// If true, replicated variables without a replication condition are reported.
+	UPROPERTY(Config, EditAnywhere, meta = (EditCondition = "bEnableReplicationValidator == true"))
+	bool bRequireReplicationCondition = true;
+
+	// Replicated variables estimated at this many bytes or more are reported. Arrays are assumed to hold 8 elements.
+	UPROPERTY(Config, EditAnywhere, meta = (EditCondition = "bEnableReplicationValidator == true", ClampMin = 1, Units = "Bytes"))
+	int32 ReplicatedVariableThresholdBytes = 128;
+
+	// Frames per second assumed for RPCs and writes made from Tick, to estimate their bandwidth.
+	UPROPERTY(Config, EditAnywhere, meta = (EditCondition = "bEnableReplicationValidator == true", ClampMin = 1))
+	float ReplicationTickRate = 30.0f;
+
+	// If true, we will validate that Anim Blueprints update on worker threads
+	UPROPERTY(Config, EditAnywhere)
+	bool bEnableAnimUpdateValidator = true;
+
+	//If true, we throw an error, otherwise a warning!
+	UPROPERTY(Config, EditAnywhere, meta = (EditCondition = "bEnableAnimUpdateValidator == true"))
+	bool bErrorOnAnimUpdate = false;
+
+	// If true, we will estimate what Tick and the construction script cost and compare it to TickCostBudgets
+	UPROPERTY(Config, EditAnywhere)
+	bool bEnableTickCostValidator = true;
+
+	//If true, we throw an error, otherwise a warning!
+	UPROPERTY(Config, EditAnywhere, meta = (EditCondition = "bEnableTickCostValidator == true"))
+	bool bErrorOnTickCostOverBudget = false;
+
+	// Cost of every node run, unless it calls one of TickCostFunctions.
+	UPROPERTY(Config, EditAnywhere, meta = (EditCondition = "bEnableTickCostValidator == true", ClampMin = 0))
+	float TickCostPerNode = 1.0f;
+
+	// Iterations assumed for every loop, the cost of a loop body is multiplied by it.
+	UPROPERTY(Config, EditAnywhere, meta = (EditCondition = "bEnableTickCostValidator == true", ClampMin = 1))
+	float TickCostLoopIterations = 8.0f;
+
+	// Functions costing more (or less) than TickCostPerNode, including those called further down Blueprint functions and macros.
+	UPROPERTY(Config, EditAnywhere, meta = (EditCondition = "bEnableTickCostValidator == true"))
+	TArray<FCommonValidatorsFunctionCost> TickCostFunctions;
+
+	// Budgets per parent class. A Blueprint uses the budget of its closest parent class listed here.
+	UPROPERTY(Config, EditAnywhere, meta = (EditCondition = "bEnableTickCostValidator == true"))
+	TArray<FCommonValidatorsTickBudget> TickCostBudgets;
+
+	// If true, we will validate how much Blueprints pull into memory through hard references
+	UPROPERTY(Config, EditAnywhere)
+	bool bEnableHardReferenceValidator = true;
+
+	//If true, we throw an error, otherwise a warning!
+	UPROPERTY(Config, EditAnywhere, meta = (EditCondition = "bEnableHardReferenceValidator == true"))
+	bool bErrorOnHardReferenceBudget = false;
+
+	// Disk size of everything a Blueprint hard references, directly or not, above which it is reported.
+	UPROPERTY(Config, EditAnywhere, meta = (EditCondition = "bEnableHardReferenceValidator == true", ClampMin = 0, Units = "Megabytes"))
+	float HardReferenceBudgetMB = 100.0f;
+
+	// Packages under these paths are neither counted nor followed, e.g. content that is always loaded anyway.
+	UPROPERTY(Config, EditAnywhere, meta = (EditCondition = "bEnableHardReferenceValidator == true"))
+	TArray<FString> HardReferenceIgnoredPaths = { TEXT("/Engine/") };
+
+	// If true, we will validate Blueprints against NodeRules
+	UPROPERTY(Config, EditAnywhere)
+	bool bEnableNodeRuleValidator = true;
+
+	// Nodes that should not be used, anywhere or on Tick or in construction scripts only. All rules are checked
+	// together while indexing a Blueprint, so adding a rule doesn't add another pass over its nodes.
+	UPROPERTY(Config, EditAnywhere, meta = (EditCondition = "bEnableNodeRuleValidator == true"))
+	TArray<FCommonValidatorsNodeRule> NodeRules;
+
+	// If true, validation results are cached under Saved/CommonValidators and replayed as long as neither the
+	// Blueprint's graphs nor the settings affecting a validator changed.
+	UPROPERTY(Config, EditAnywhere)
+	bool bEnableResultCache = true;
+
+	// Message Log entries each validator adds per asset, findings with the same text on several nodes count once. The
+	// rest is summed up in a single "+N more" entry and every finding of the asset is written to
+	// Saved/CommonValidators/Findings.jsonl. 0 reports everything.
+	UPROPERTY(Config, EditAnywhere, meta = (ClampMin = 0))
+	int32 MaxMessagesPerAsset = 20;
+
+	// If true, saving a Blueprint in the editor doesn't wait for these validators: they analyze a snapshot of its graphs
+	// in the background and their findings show up in the Message Log once done. Commandlets, unattended runs and
+	// explicit validation always wait for the results.
+	UPROPERTY(Config, EditAnywhere)
+	bool bAsyncSaveValidation = true;
+
+	// If true, Blueprints open in an editor are validated as their graphs are edited, and the findings show on the
+	// nodes like compiler messages. Only the edited graphs are analyzed again.
+	UPROPERTY(Config, EditAnywhere)
+	bool bEnableLiveValidation = true;
+
+	// Seconds a Blueprint must be left alone after an edit before it is analyzed again.
+	UPROPERTY(Config, EditAnywhere, meta = (EditCondition = "bEnableLiveValidation == true", ClampMin = 0, Units = "Seconds"))
+	float LiveValidationDelay = 0.3f;
 };
\ No newline at end of file
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Logging/TokenizedMessage.h"
+
+enum class ECommonValidatorsFindingActions : uint8
+{
+	None = 0,
+	FocusNode = 1 << 0,
+	RemoveNode = 1 << 1,
+	CacheInVariable = 1 << 2
+};
+ENUM_CLASS_FLAGS(ECommonValidatorsFindingActions);
+
+/**
+ * A single issue reported by one of the Blueprint validators. Findings only reference their node by graph
+ * name and node GUID, so they can be cached on disk and replayed against a freshly loaded Blueprint.
+ */
+struct FCommonValidatorsFinding
+{
+	TEnumAsByte<EMessageSeverity::Type> Severity = EMessageSeverity::Warning;
+
+	// Message shown in the log. "{Node}" is replaced with the node's title when reported.
+	FString Message;
+
+	FName GraphName;
+	FGuid NodeGuid;
+
+	ECommonValidatorsFindingActions Actions = ECommonValidatorsFindingActions::None;
+
+	// Kind of issue within the validator. Findings sharing a rule, severity and actions are listed as one Message Log
+	// entry, so messages may name per-node details. None for validators reporting a single kind of issue.
+	FName Rule;
+
+	friend FArchive& operator<<(FArchive& Ar, FCommonValidatorsFinding& Finding)
+	{
+		Ar << Finding.Severity;
+		Ar << Finding.Message;
+		Ar << Finding.GraphName;
+		Ar << Finding.NodeGuid;
+		Ar << reinterpret_cast<uint8&>(Finding.Actions);
+		Ar << Finding.Rule;
+		return Ar;
+	}
+};
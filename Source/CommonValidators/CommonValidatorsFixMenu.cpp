@@ -0,0 +1,87 @@
+#include "CommonValidatorsFixMenu.h"
+
+#include "AssetRegistry/AssetData.h"
+#include "CommonValidatorsStatics.h"
+#include "ContentBrowserMenuContexts.h"
+#include "CoreGlobals.h"
+#include "Engine/Blueprint.h"
+#include "Framework/Notifications/NotificationManager.h"
+#include "ToolMenus.h"
+#include "Widgets/Notifications/SNotificationList.h"
+
+#define LOCTEXT_NAMESPACE "CommonValidatorsFixMenu"
+
+namespace UE::Internal::FixMenuHelpers
+{
+	static const FName OwnerName(TEXT("CommonValidatorsFixMenu"));
+}
+
+FDelegateHandle FCommonValidatorsFixMenu::StartupCallbackHandle;
+
+void FCommonValidatorsFixMenu::Initialize()
+{
+	// No menus to extend without an editor UI.
+	if (!GIsEditor || IsRunningCommandlet())
+	{
+		return;
+	}
+
+	StartupCallbackHandle = UToolMenus::RegisterStartupCallback(FSimpleMulticastDelegate::FDelegate::CreateStatic(&FCommonValidatorsFixMenu::RegisterMenus));
+}
+
+void FCommonValidatorsFixMenu::Shutdown()
+{
+	if (UObjectInitialized())
+	{
+		UToolMenus::UnRegisterStartupCallback(StartupCallbackHandle);
+		UToolMenus::UnregisterOwner(UE::Internal::FixMenuHelpers::OwnerName);
+	}
+	StartupCallbackHandle.Reset();
+}
+
+void FCommonValidatorsFixMenu::RegisterMenus()
+{
+	FToolMenuOwnerScoped OwnerScoped(UE::Internal::FixMenuHelpers::OwnerName);
+
+	UToolMenu* Menu = UToolMenus::Get()->ExtendMenu(TEXT("ContentBrowser.AssetContextMenu"));
+	FToolMenuSection& Section = Menu->FindOrAddSection(TEXT("GetAssetActions"));
+	Section.AddDynamicEntry(TEXT("CommonValidatorsFix"), FNewToolMenuSectionDelegate::CreateLambda([](FToolMenuSection& InSection)
+	{
+		const UContentBrowserAssetContextMenuContext* Context = InSection.FindContext<UContentBrowserAssetContextMenuContext>();
+		if (!Context)
+		{
+			return;
+		}
+
+		// The validators only look at Blueprints, the entry is hidden for anything else.
+		TArray<FAssetData> Blueprints = Context->SelectedAssets.FilterByPredicate([](const FAssetData& AssetData)
+		{
+			return AssetData.IsInstanceOf(UBlueprint::StaticClass());
+		});
+		if (Blueprints.IsEmpty())
+		{
+			return;
+		}
+
+		InSection.AddMenuEntry(
+			TEXT("CommonValidatorsFixAssets"),
+			LOCTEXT("FixAssets", "Fix Validation Findings"),
+			LOCTEXT("FixAssetsTooltip", "Applies every fix the Common Validators offer on the selected Blueprints, such as removing empty Tick nodes or caching repeated pure calls in variables, and saves them."),
+			FSlateIcon(),
+			FUIAction(FExecuteAction::CreateLambda([Blueprints]()
+			{
+				FixSelectedAssets(Blueprints);
+			})));
+	}));
+}
+
+void FCommonValidatorsFixMenu::FixSelectedAssets(TArray<FAssetData> Assets)
+{
+	const int32 NumApplied = UCommonValidatorsStatics::FixAssets(Assets, true);
+
+	FNotificationInfo Info(FText::Format(LOCTEXT("FixesApplied", "Applied {0} {0}|plural(one=fix,other=fixes) to {1} {1}|plural(one=Blueprint,other=Blueprints)"), NumApplied, Assets.Num()));
+	Info.ExpireDuration = 5.0f;
+	FSlateNotificationManager::Get().AddNotification(Info);
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FAssetData;
+
+/**
+ * "Fix Validation Findings" in the Content Browser's asset context menu, applying every fix the validators offer
+ * on the selected Blueprints through FCommonValidatorsFixer. Editor only.
+ */
+class COMMONVALIDATORS_API FCommonValidatorsFixMenu
+{
+public:
+	static void Initialize();
+	static void Shutdown();
+
+private:
+	static void RegisterMenus();
+	static void FixSelectedAssets(TArray<FAssetData> Assets);
+
+	static FDelegateHandle StartupCallbackHandle;
+};
@@ -0,0 +1,183 @@
+#include "CommonValidatorsFixer.h"
+
+#include "Async/ParallelFor.h"
+#include "CommonValidatorsDeveloperSettings.h"
+#include "CommonValidatorsFinding.h"
+#include "CommonValidatorsGraphIndex.h"
+#include "CommonValidatorsLog.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "EditorValidator_BlueprintBase.h"
+#include "EditorValidator_PureNode.h"
+#include "Engine/Blueprint.h"
+#include "FileHelpers.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Misc/ScopedSlowTask.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ScopedTransaction.h"
+#include "UObject/Package.h"
+
+#define LOCTEXT_NAMESPACE "CommonValidatorsFixer"
+
+void FCommonValidatorsFixer::AddFinding(UBlueprint* Blueprint, UEdGraphNode* Node, const FCommonValidatorsFinding& Finding)
+{
+	if (!Blueprint || !Node || !EnumHasAnyFlags(Finding.Actions, ECommonValidatorsFindingActions::RemoveNode | ECommonValidatorsFindingActions::CacheInVariable))
+	{
+		return;
+	}
+
+	int32& FixIndex = PendingFixIndices.FindOrAdd(Blueprint, INDEX_NONE);
+	if (FixIndex == INDEX_NONE)
+	{
+		FixIndex = PendingFixes.Num();
+		PendingFixes.AddDefaulted_GetRef().Blueprint = Blueprint;
+	}
+
+	// Several validators may ask for the same node to go, removing wins over caching.
+	FBlueprintFixes& Fixes = PendingFixes[FixIndex];
+	if (EnumHasAnyFlags(Finding.Actions, ECommonValidatorsFindingActions::RemoveNode))
+	{
+		Fixes.NodesToRemove.AddUnique(Node);
+	}
+	else
+	{
+		Fixes.NodesToCache.AddUnique(Node);
+	}
+}
+
+int32 FCommonValidatorsFixer::Apply(bool bSave)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FCommonValidatorsFixer::Apply);
+
+	int32 NumApplied = 0;
+	TArray<UPackage*> PackagesToSave;
+	for (const FBlueprintFixes& Fixes : PendingFixes)
+	{
+		UBlueprint* Blueprint = Fixes.Blueprint.Get();
+		if (!Blueprint)
+		{
+			continue;
+		}
+
+		int32 NumFixed = 0;
+		{
+			const FScopedTransaction Transaction(LOCTEXT("ApplyFixes", "Apply Validation Fixes"));
+			Blueprint->Modify();
+
+			// Rewritten together, so the Blueprint is indexed once per pass rather than once per node.
+			TArray<UEdGraphNode*> NodesToCache;
+			for (const TWeakObjectPtr<UEdGraphNode>& WeakNode : Fixes.NodesToCache)
+			{
+				UEdGraphNode* Node = WeakNode.Get();
+				if (Node && !Fixes.NodesToRemove.Contains(WeakNode))
+				{
+					NodesToCache.Add(Node);
+				}
+			}
+			NumFixed += UEditorValidator_PureNode::CacheInVariables(Blueprint, NodesToCache);
+
+			for (const TWeakObjectPtr<UEdGraphNode>& WeakNode : Fixes.NodesToRemove)
+			{
+				UEdGraphNode* Node = WeakNode.Get();
+				UEdGraph* Graph = Node ? Node->GetGraph() : nullptr;
+				if (!Graph)
+				{
+					continue;
+				}
+
+				Graph->Modify();
+				Node->Modify();
+				Node->DestroyNode();
+				++NumFixed;
+			}
+		}
+
+		if (NumFixed == 0)
+		{
+			continue;
+		}
+
+		// One compile for every fix of the Blueprint, instead of the structural modification DeleteNodeFromBlueprint does per node.
+		// New cache variables still regenerate the skeleton class once each, their getters and setters need the property.
+		FKismetEditorUtilities::CompileBlueprint(Blueprint, EBlueprintCompileOptions::SkipGarbageCollection);
+		Blueprint->MarkPackageDirty();
+		PackagesToSave.Add(Blueprint->GetPackage());
+
+		UE_LOG(LogCommonValidators, Display, TEXT("%s: applied %d fixes"), *Blueprint->GetPathName(), NumFixed);
+		NumApplied += NumFixed;
+	}
+
+	PendingFixes.Reset();
+	PendingFixIndices.Reset();
+
+	if (bSave && PackagesToSave.Num() > 0 && !UEditorLoadingAndSavingUtils::SavePackages(PackagesToSave, true))
+	{
+		UE_LOG(LogCommonValidators, Error, TEXT("Failed to save some of the %d fixed packages."), PackagesToSave.Num());
+	}
+
+	return NumApplied;
+}
+
+int32 FCommonValidatorsFixer::FixAssets(TConstArrayView<FAssetData> Assets, bool bSave, int32 BatchSize)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FCommonValidatorsFixer::FixAssets);
+
+	const TArray<const UEditorValidator_BlueprintBase*> Validators = UEditorValidator_BlueprintBase::GetEnabledValidators();
+	if (Validators.IsEmpty())
+	{
+		return 0;
+	}
+
+	const bool bUseCache = GetDefault<UCommonValidatorsDeveloperSettings>()->bEnableResultCache;
+	BatchSize = FMath::Max(1, BatchSize);
+
+	FScopedSlowTask SlowTask(static_cast<float>(Assets.Num()), LOCTEXT("FixingAssets", "Applying validation fixes..."));
+	SlowTask.MakeDialog(true);
+
+	FCommonValidatorsFixer Fixer;
+	int32 NumApplied = 0;
+	for (int32 BatchStart = 0; BatchStart < Assets.Num() && !SlowTask.ShouldCancel(); BatchStart += BatchSize)
+	{
+		const int32 BatchEnd = FMath::Min(BatchStart + BatchSize, Assets.Num());
+		SlowTask.EnterProgressFrame(static_cast<float>(BatchEnd - BatchStart));
+
+		TArray<UBlueprint*> Blueprints;
+		TArray<FString> AssetPaths;
+		TArray<TSharedPtr<const FCommonValidatorsBlueprintIndex>> Indices;
+		for (int32 AssetIndex = BatchStart; AssetIndex < BatchEnd; ++AssetIndex)
+		{
+			if (UBlueprint* Blueprint = Cast<UBlueprint>(Assets[AssetIndex].GetAsset()))
+			{
+				Blueprints.Add(Blueprint);
+				AssetPaths.Add(Blueprint->GetPathName());
+				Indices.Add(FCommonValidatorsGraphIndexCache::Get().FindOrBuild(Blueprint));
+			}
+		}
+
+		// Analysis only reads the indices, fixing edits the Blueprints and stays on the game thread.
+		TArray<TArray<FCommonValidatorsFinding>> Findings;
+		Findings.SetNum(Blueprints.Num() * Validators.Num());
+		ParallelFor(Findings.Num(), [&Findings, &Validators, &AssetPaths, &Indices, bUseCache](int32 ItemIndex)
+		{
+			const int32 AssetIndex = ItemIndex / Validators.Num();
+			Validators[ItemIndex % Validators.Num()]->AnalyzeWithCache(AssetPaths[AssetIndex], *Indices[AssetIndex], bUseCache, Findings[ItemIndex]);
+		});
+
+		for (int32 ItemIndex = 0; ItemIndex < Findings.Num(); ++ItemIndex)
+		{
+			const int32 AssetIndex = ItemIndex / Validators.Num();
+			for (const FCommonValidatorsFinding& Finding : Findings[ItemIndex])
+			{
+				Fixer.AddFinding(Blueprints[AssetIndex], UEditorValidator_BlueprintBase::FindNode(*Indices[AssetIndex], Finding), Finding);
+			}
+		}
+
+		NumApplied += Fixer.Apply(bSave);
+	}
+
+	UE_LOG(LogCommonValidators, Display, TEXT("Applied %d fixes to %d assets."), NumApplied, Assets.Num());
+	return NumApplied;
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+struct FAssetData;
+struct FCommonValidatorsFinding;
+class UBlueprint;
+class UEdGraphNode;
+
+/**
+ * Applies the fixes validators attach to their findings, grouped by Blueprint: all fixes of a Blueprint go through
+ * one transaction, one compile and one save, rather than a structural modification per removed node.
+ * Fixes are collected first and only applied by Apply, so findings can be added while iterating over an index.
+ */
+class COMMONVALIDATORS_API FCommonValidatorsFixer
+{
+public:
+	// Queues the finding's fix, if it has one. Findings without a resolved node are ignored. Game thread only.
+	void AddFinding(UBlueprint* Blueprint, UEdGraphNode* Node, const FCommonValidatorsFinding& Finding);
+
+	// Applies and clears the queued fixes, saving the fixed packages when bSave is set. Returns the number of fixes applied.
+	int32 Apply(bool bSave);
+
+	/**
+	 * Analyzes the assets with every enabled validator and applies all fixes found. Assets are loaded and fixed in
+	 * batches, each batch analyzed on worker threads. Returns the number of fixes applied.
+	 */
+	static int32 FixAssets(TConstArrayView<FAssetData> Assets, bool bSave, int32 BatchSize = 64);
+
+private:
+	struct FBlueprintFixes
+	{
+		TWeakObjectPtr<UBlueprint> Blueprint;
+		TArray<TWeakObjectPtr<UEdGraphNode>> NodesToRemove;
+		TArray<TWeakObjectPtr<UEdGraphNode>> NodesToCache;
+	};
+
+	TArray<FBlueprintFixes> PendingFixes;
+	TMap<TObjectKey<UBlueprint>, int32> PendingFixIndices;
+};
@@ -0,0 +1,1527 @@
+#include "CommonValidatorsGraphIndex.h"
+
+#include "AnimationGraphSchema.h"
+#include "AnimGraphNode_Base.h"
+#include "Animation/AnimBlueprint.h"
+#include "Components/ActorComponent.h"
+#include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "Engine/SCS_Node.h"
+#include "Engine/SimpleConstructionScript.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "EdGraphSchema_K2.h"
+#include "GameFramework/Actor.h"
+#include "K2Node.h"
+#include "K2Node_BreakStruct.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_Event.h"
+#include "K2Node_ExecutionSequence.h"
+#include "K2Node_FunctionEntry.h"
+#include "K2Node_FunctionResult.h"
+#include "K2Node_GetArrayItem.h"
+#include "K2Node_IfThenElse.h"
+#include "K2Node_Knot.h"
+#include "K2Node_StructMemberGet.h"
+#include "K2Node_MacroInstance.h"
+#include "K2Node_MakeStruct.h"
+#include "K2Node_MultiGate.h"
+#include "K2Node_Switch.h"
+#include "K2Node_Variable.h"
+#include "K2Node_VariableGet.h"
+#include "K2Node_VariableSet.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "CommonValidatorsCallGraph.h"
+#include "CommonValidatorsNodeRules.h"
+#include "CommonValidatorsPureNodeAllowlist.h"
+#include "CommonValidatorsProfiler.h"
+#include "HAL/PlatformTime.h"
+#include "Hash/xxhash.h"
+#include "Misc/StringBuilder.h"
+#include "Misc/TransactionObjectEvent.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Runtime/Launch/Resources/Version.h"
+#include "UObject/UObjectGlobals.h"
+
+DECLARE_CYCLE_STAT(TEXT("Build Graph Index"), STAT_CommonValidators_BuildGraphIndex, STATGROUP_CommonValidators);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Indexed Nodes"), STAT_CommonValidators_IndexedNodes, STATGROUP_CommonValidators);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Indexed Pins"), STAT_CommonValidators_IndexedPins, STATGROUP_CommonValidators);
+
+namespace UE::Internal::GraphIndexHelpers
+{
+	static bool IsExecPin(const UEdGraphPin* Pin)
+	{
+		return Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec;
+	}
+
+	static const FName StandardMacrosPackageName(TEXT("/Engine/EditorBlueprintResources/StandardMacros"));
+
+	// Input each standard loop macro reads again on every iteration, keyed by macro graph name.
+	static FName FindPerIterationPinName(const UK2Node_MacroInstance* MacroNode)
+	{
+		static const FName ArrayPinName(TEXT("Array"));
+		static const FName LastIndexPinName(TEXT("LastIndex"));
+		static const FName ConditionPinName(TEXT("Condition"));
+		static const TMap<FName, FName> StandardLoops = {
+			{ TEXT("ForLoop"), LastIndexPinName },
+			{ TEXT("ForLoopWithBreak"), LastIndexPinName },
+			{ TEXT("ForEachLoop"), ArrayPinName },
+			{ TEXT("ForEachLoopWithBreak"), ArrayPinName },
+			{ TEXT("ReverseForEachLoop"), ArrayPinName },
+			{ TEXT("WhileLoop"), ConditionPinName }
+		};
+
+		const UEdGraph* MacroGraph = MacroNode->GetMacroGraph();
+		if (!MacroGraph || MacroGraph->GetOutermost()->GetFName() != StandardMacrosPackageName)
+		{
+			return NAME_None;
+		}
+
+		const FName* PinName = StandardLoops.Find(MacroGraph->GetFName());
+		return PinName ? *PinName : NAME_None;
+	}
+
+	// Nodes that only decide where execution goes next. Knots are flow control too but already have their own kind.
+	static bool IsFlowControl(const UEdGraphNode* Node)
+	{
+		if (Node->IsA<UK2Node_IfThenElse>() || Node->IsA<UK2Node_ExecutionSequence>() || Node->IsA<UK2Node_Switch>() || Node->IsA<UK2Node_MultiGate>())
+		{
+			return true;
+		}
+
+		// Standard macros (loops, DoOnce, Gate, FlipFlop, IsValid...) only keep state local to the macro instance.
+		const UK2Node_MacroInstance* MacroNode = Cast<UK2Node_MacroInstance>(Node);
+		const UEdGraph* MacroGraph = MacroNode ? MacroNode->GetMacroGraph() : nullptr;
+		return MacroGraph && MacroGraph->GetOutermost()->GetFName() == StandardMacrosPackageName;
+	}
+
+	// ForLoop names its body pin "LoopBody", the array and while loops "Loop Body".
+	static bool IsLoopBodyPin(const UEdGraphPin* Pin)
+	{
+		static const FName LoopBodyPinName(TEXT("LoopBody"));
+		static const FName SpacedLoopBodyPinName(TEXT("Loop Body"));
+		return Pin->PinName == LoopBodyPinName || Pin->PinName == SpacedLoopBodyPinName;
+	}
+
+	static ECommonValidatorsNodeKind ClassifyNode(const UEdGraphNode* Node, FName& OutMemberName, const UFunction*& OutFunction)
+	{
+		if (const UK2Node_CallFunction* CallNode = Cast<UK2Node_CallFunction>(Node))
+		{
+			OutMemberName = CallNode->GetFunctionName();
+			OutFunction = CallNode->GetTargetFunction();
+			return ECommonValidatorsNodeKind::CallFunction;
+		}
+		if (const UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node))
+		{
+			OutMemberName = EventNode->GetFunctionName();
+			return ECommonValidatorsNodeKind::Event;
+		}
+		if (const UK2Node_FunctionEntry* EntryNode = Cast<UK2Node_FunctionEntry>(Node))
+		{
+			OutMemberName = EntryNode->FunctionReference.GetMemberName();
+			return ECommonValidatorsNodeKind::FunctionEntry;
+		}
+		if (Node->IsA<UK2Node_FunctionResult>())
+		{
+			return ECommonValidatorsNodeKind::FunctionResult;
+		}
+		if (const UK2Node_MacroInstance* MacroNode = Cast<UK2Node_MacroInstance>(Node))
+		{
+			if (const UEdGraph* MacroGraph = MacroNode->GetMacroGraph())
+			{
+				OutMemberName = MacroGraph->GetFName();
+			}
+			return ECommonValidatorsNodeKind::MacroInstance;
+		}
+		if (const UK2Node_VariableGet* GetNode = Cast<UK2Node_VariableGet>(Node))
+		{
+			OutMemberName = GetNode->GetVarName();
+			return ECommonValidatorsNodeKind::VariableGet;
+		}
+		if (const UK2Node_VariableSet* SetNode = Cast<UK2Node_VariableSet>(Node))
+		{
+			OutMemberName = SetNode->GetVarName();
+			return ECommonValidatorsNodeKind::VariableSet;
+		}
+		if (Node->IsA<UK2Node_BreakStruct>())
+		{
+			return ECommonValidatorsNodeKind::BreakStruct;
+		}
+		if (Node->IsA<UK2Node_MakeStruct>())
+		{
+			return ECommonValidatorsNodeKind::MakeStruct;
+		}
+		if (Node->IsA<UK2Node_Knot>())
+		{
+			return ECommonValidatorsNodeKind::Knot;
+		}
+
+		// Still not a call node, but matched by function like one.
+		if (const UFunction* ExpandedFunction = FCommonValidatorsCallGraph::GetExpandedFunction(Node))
+		{
+			OutMemberName = ExpandedFunction->GetFName();
+			OutFunction = ExpandedFunction;
+		}
+		return ECommonValidatorsNodeKind::Other;
+	}
+
+	static void HashString(FXxHash64Builder& Builder, FStringView String)
+	{
+		const int32 Len = String.Len();
+		Builder.Update(&Len, sizeof(Len));
+		Builder.Update(String.GetData(), Len * sizeof(TCHAR));
+	}
+
+	// Node type, target and the literals of the unlinked inputs: what decides the value of a pure node besides its inputs.
+	static uint64 ComputePureSignature(const UEdGraphNode* Node, const FCommonValidatorsIndexedNode& Indexed)
+	{
+		FXxHash64Builder Builder;
+		HashString(Builder, WriteToString<128>(Node->GetClass()->GetFName()));
+		HashString(Builder, WriteToString<128>(Indexed.MemberName));
+		HashString(Builder, WriteToString<128>(Indexed.FunctionOwnerName));
+
+		for (const UEdGraphPin* Pin : Node->Pins)
+		{
+			// Split structs are hashed through their sub pins.
+			if (Pin->Direction != EGPD_Input || IsExecPin(Pin) || Pin->LinkedTo.Num() > 0 || Pin->SubPins.Num() > 0)
+			{
+				continue;
+			}
+
+			HashString(Builder, WriteToString<128>(Pin->PinName));
+			HashString(Builder, Pin->DefaultValue);
+			HashString(Builder, Pin->DefaultObject ? WriteToString<256>(Pin->DefaultObject->GetPathName()).ToView() : FStringView());
+			HashString(Builder, Pin->DefaultTextValue.ToString());
+		}
+		return Builder.Finalize().Hash;
+	}
+
+	// Pin a value really comes from, through any reroute knots.
+	static const UEdGraphPin* SkipKnots(const UEdGraphPin* Pin)
+	{
+		for (int32 Depth = 0; Pin && Depth < 1024; ++Depth)
+		{
+			const UK2Node_Knot* Knot = Cast<UK2Node_Knot>(Pin->GetOwningNode());
+			const UEdGraphPin* KnotInput = Knot ? Knot->GetInputPin() : nullptr;
+			if (!KnotInput || KnotInput->LinkedTo.Num() == 0)
+			{
+				return Knot ? nullptr : Pin;
+			}
+			Pin = KnotInput->LinkedTo[0];
+		}
+		return nullptr;
+	}
+
+	static uint32 HashPinNames(const UEdGraphPin* Input, const UEdGraphPin* Output)
+	{
+		FXxHash64Builder Builder;
+		HashString(Builder, WriteToString<128>(Input->PinName));
+		HashString(Builder, Output ? WriteToString<128>(Output->PinName).ToView() : FStringView());
+		return static_cast<uint32>(Builder.Finalize().Hash);
+	}
+
+	// Everything a loop body executes, up to the loop node itself: going through it again would lead on to Completed.
+	static void FindLoopBodies(FCommonValidatorsIndexedGraph& Graph)
+	{
+		TBitArray<> InBody;
+		for (FCommonValidatorsIndexedLoop& Loop : Graph.Loops)
+		{
+			InBody.Init(false, Graph.Nodes.Num());
+			InBody[Loop.NodeIndex] = true;
+			for (const int32 Target : Loop.BodyTargets)
+			{
+				if (!InBody[Target])
+				{
+					InBody[Target] = true;
+					Loop.BodyNodes.Add(Target);
+				}
+			}
+
+			for (int32 Head = 0; Head < Loop.BodyNodes.Num(); ++Head)
+			{
+				for (const int32 Next : Graph.GetExecSuccessors(Loop.BodyNodes[Head]))
+				{
+					if (!InBody[Next])
+					{
+						InBody[Next] = true;
+						Loop.BodyNodes.Add(Next);
+					}
+				}
+			}
+		}
+	}
+
+	static void CollectSubGraphs(const UEdGraph* Graph, TArray<UEdGraph*>& OutGraphs)
+	{
+		for (UEdGraph* SubGraph : Graph->SubGraphs)
+		{
+			if (SubGraph)
+			{
+				OutGraphs.Add(SubGraph);
+				CollectSubGraphs(SubGraph, OutGraphs);
+			}
+		}
+	}
+
+	// Whether the fast path copies the value of Source without the Blueprint VM: a member variable, one of its struct
+	// members, a negated bool or a property access node. Anything else is evaluated by the VM on every update.
+	static bool IsFastPathSource(const UEdGraphPin* Source)
+	{
+		static const FName NotPreBoolName(TEXT("Not_PreBool"));
+		static const FName PropertyAccessClassName(TEXT("K2Node_PropertyAccess"));
+
+		for (int32 Depth = 0; Source && Depth < 64; ++Depth)
+		{
+			const UEdGraphNode* Node = Source->GetOwningNode();
+			if (Cast<UK2Node_VariableGet>(Node))
+			{
+				const UEdGraphPin* SelfPin = Node->FindPin(UEdGraphSchema_K2::PN_Self, EGPD_Input);
+				return !SelfPin || SelfPin->LinkedTo.Num() == 0;
+			}
+
+			// Lives in the PropertyAccessNode plugin, which we don't depend on.
+			if (Node->GetClass()->GetFName() == PropertyAccessClassName)
+			{
+				return true;
+			}
+
+			const UK2Node_CallFunction* Call = Cast<UK2Node_CallFunction>(Node);
+			const bool bIsNot = Call && Call->FunctionReference.GetMemberName() == NotPreBoolName;
+			if (!bIsNot && !Cast<UK2Node_BreakStruct>(Node) && !Cast<UK2Node_StructMemberGet>(Node))
+			{
+				return false;
+			}
+
+			// The one input these nodes have, unlinked means a literal.
+			const UEdGraphPin* Input = nullptr;
+			for (const UEdGraphPin* Pin : Node->Pins)
+			{
+				if (Pin->Direction == EGPD_Input && !IsExecPin(Pin) && Pin->PinName != UEdGraphSchema_K2::PN_Self)
+				{
+					Input = Pin;
+					break;
+				}
+			}
+			if (!Input || Input->LinkedTo.Num() == 0)
+			{
+				return true;
+			}
+			Source = SkipKnots(Input->LinkedTo[0]);
+		}
+		return false;
+	}
+
+	// Elements assumed in a container passed by value, its real length is only known at runtime.
+	static constexpr int32 AssumedContainerElements = 8;
+
+	static int32 GetTerminalSize(FName Category, const UObject* SubCategoryObject)
+	{
+		if (Category == UEdGraphSchema_K2::PC_Struct)
+		{
+			const UScriptStruct* Struct = Cast<UScriptStruct>(SubCategoryObject);
+			return Struct ? Struct->GetStructureSize() : 0;
+		}
+		if (Category == UEdGraphSchema_K2::PC_Boolean || Category == UEdGraphSchema_K2::PC_Byte)
+		{
+			return 1;
+		}
+		if (Category == UEdGraphSchema_K2::PC_Int)
+		{
+			return 4;
+		}
+		if (Category == UEdGraphSchema_K2::PC_String)
+		{
+			return sizeof(FString);
+		}
+		if (Category == UEdGraphSchema_K2::PC_Text)
+		{
+			return sizeof(FText);
+		}
+		return 8;
+	}
+
+	static int32 GetPinValueSize(const FEdGraphPinType& PinType)
+	{
+		int32 Size = GetTerminalSize(PinType.PinCategory, PinType.PinSubCategoryObject.Get());
+		if (PinType.IsMap())
+		{
+			Size += GetTerminalSize(PinType.PinValueType.TerminalCategory, PinType.PinValueType.TerminalSubCategoryObject.Get());
+		}
+		return PinType.IsContainer() ? Size * AssumedContainerElements : Size;
+	}
+
+	// What Array Get (a copy) and calls copy each time they run. Loops are handled along with their per-iteration pin.
+	static void EstimateCopies(const UEdGraphNode* Node, FCommonValidatorsIndexedNode& Indexed)
+	{
+		if (const UK2Node_GetArrayItem* ArrayGet = Cast<UK2Node_GetArrayItem>(Node))
+		{
+			if (!ArrayGet->IsSetToReturnRef() && ArrayGet->GetResultPin())
+			{
+				Indexed.CopyBytes = GetPinValueSize(ArrayGet->GetResultPin()->PinType);
+				Indexed.CopyKinds = ECommonValidatorsCopyKind::ArrayGetCopy;
+			}
+			return;
+		}
+
+		if (Indexed.Kind != ECommonValidatorsNodeKind::CallFunction || !Indexed.Function)
+		{
+			return;
+		}
+
+		const bool bIsBlueprintFunction = Cast<UBlueprintGeneratedClass>(Indexed.Function->GetOwnerClass()) != nullptr;
+		for (const UEdGraphPin* Pin : Node->Pins)
+		{
+			// Split struct pins are copied as a whole through their parent.
+			if (IsExecPin(Pin) || Pin->ParentPin || Pin->PinName == UEdGraphSchema_K2::PN_Self)
+			{
+				continue;
+			}
+
+			const FProperty* Param = Indexed.Function->FindPropertyByName(Pin->PinName);
+			if (!Param)
+			{
+				continue;
+			}
+
+			if (Pin->Direction == EGPD_Output)
+			{
+				Indexed.CopyBytes += GetPinValueSize(Pin->PinType);
+				Indexed.CopyKinds |= ECommonValidatorsCopyKind::Output;
+			}
+			else if (!Param->HasAnyPropertyFlags(CPF_ReferenceParm))
+			{
+				Indexed.CopyBytes += GetPinValueSize(Pin->PinType);
+				Indexed.CopyKinds |= bIsBlueprintFunction ? ECommonValidatorsCopyKind::BlueprintByValueInput : ECommonValidatorsCopyKind::NativeByValueInput;
+			}
+		}
+	}
+
+	// RPC calls and sets of replicated variables, see ECommonValidatorsNetKind.
+	static void ClassifyNetAccess(const UEdGraphNode* Node, FCommonValidatorsIndexedNode& Indexed)
+	{
+		if (Indexed.Kind == ECommonValidatorsNodeKind::CallFunction && Indexed.Function && Indexed.Function->HasAnyFunctionFlags(FUNC_Net))
+		{
+			Indexed.NetKind = Indexed.Function->HasAnyFunctionFlags(FUNC_NetReliable) ? ECommonValidatorsNetKind::ReliableRpc : ECommonValidatorsNetKind::UnreliableRpc;
+			for (const UEdGraphPin* Pin : Node->Pins)
+			{
+				if (Pin->Direction == EGPD_Input && !IsExecPin(Pin) && !Pin->ParentPin && Pin->PinName != UEdGraphSchema_K2::PN_Self)
+				{
+					Indexed.NetBytes += GetPinValueSize(Pin->PinType);
+				}
+			}
+			return;
+		}
+
+		const UK2Node_VariableSet* VariableSet = Cast<UK2Node_VariableSet>(Node);
+		const FProperty* Property = VariableSet ? VariableSet->GetPropertyForVariable() : nullptr;
+		if (Property && Property->HasAnyPropertyFlags(CPF_Net))
+		{
+			Indexed.NetKind = Property->HasAnyPropertyFlags(CPF_RepNotify) ? ECommonValidatorsNetKind::RepNotifyWrite : ECommonValidatorsNetKind::ReplicatedWrite;
+			const UEdGraphPin* ValuePin = Node->FindPin(Indexed.MemberName, EGPD_Input);
+			Indexed.NetBytes = ValuePin ? GetPinValueSize(ValuePin->PinType) : 0;
+		}
+	}
+
+	static void BuildGraph(UEdGraph* Graph, ECommonValidatorsGraphKind Kind, FCommonValidatorsIndexedGraph& OutGraph, int32& InOutNumPins, TSet<TObjectKey<UBlueprint>>& InOutDependencies)
+	{
+		OutGraph.Graph = Graph;
+		OutGraph.GraphName = Graph->GetFName();
+		OutGraph.Kind = Kind;
+
+		TMap<const UEdGraphNode*, int32> NodeToIndex;
+		NodeToIndex.Reserve(Graph->Nodes.Num());
+		OutGraph.Nodes.Reserve(Graph->Nodes.Num());
+
+		TArray<int32> MatchedRules;
+
+		for (UEdGraphNode* Node : Graph->Nodes)
+		{
+			if (!Node)
+			{
+				continue;
+			}
+
+			FCommonValidatorsIndexedNode& Indexed = OutGraph.Nodes.AddDefaulted_GetRef();
+			Indexed.Node = Node;
+			Indexed.NodeGuid = Node->NodeGuid;
+			Indexed.Kind = ClassifyNode(Node, Indexed.MemberName, Indexed.Function);
+			Indexed.FunctionOwnerName = FCommonValidatorsCallGraph::GetFunctionOwnerName(Indexed.Function);
+			Indexed.bIsGhostNode = Node->IsAutomaticallyPlacedGhostNode();
+			Indexed.bIsFlowControl = IsFlowControl(Node);
+
+			if (const UK2Node_Variable* VariableNode = Cast<UK2Node_Variable>(Node))
+			{
+				Indexed.bIsLocalVariable = VariableNode->VariableReference.IsLocalScope();
+			}
+
+			if (const UK2Node* K2Node = Cast<UK2Node>(Node))
+			{
+				Indexed.bIsPure = K2Node->IsNodePure();
+			}
+
+			if (Indexed.bIsPure && Indexed.Kind == ECommonValidatorsNodeKind::CallFunction)
+			{
+				Indexed.bIsHarmlessPure = FCommonValidatorsPureNodeAllowlist::Get().IsHarmless(Indexed.Function);
+			}
+
+			if (Indexed.Kind == ECommonValidatorsNodeKind::CallFunction)
+			{
+				Indexed.bIsThreadSafe = Indexed.Function && FBlueprintEditorUtils::HasFunctionBlueprintThreadSafeMetaData(Indexed.Function);
+			}
+			else if (const UK2Node_FunctionEntry* FunctionEntry = Cast<UK2Node_FunctionEntry>(Node))
+			{
+				Indexed.bIsThreadSafe = FunctionEntry->MetaData.bThreadSafe;
+			}
+
+			EstimateCopies(Node, Indexed);
+			ClassifyNetAccess(Node, Indexed);
+
+			MatchedRules.Reset();
+			FCommonValidatorsNodeRules::Get().Match(Node, Indexed, MatchedRules);
+			for (const int32 RuleIndex : MatchedRules)
+			{
+				OutGraph.RuleMatches.Emplace(OutGraph.Nodes.Num() - 1, RuleIndex);
+			}
+
+			if (Indexed.Kind == ECommonValidatorsNodeKind::CallFunction || Indexed.Kind == ECommonValidatorsNodeKind::MacroInstance)
+			{
+				const TSharedPtr<const FCommonValidatorsCallSummary> Summary = FCommonValidatorsCallGraph::Get().GetCallSummary(Node, InOutDependencies);
+				if (Summary && (Summary->BlockingChain.Num() > 0 || Summary->Calls.Num() > 0))
+				{
+					OutGraph.CallSummaries.Add(OutGraph.Nodes.Num() - 1, Summary.ToSharedRef());
+				}
+			}
+
+			if (Indexed.Kind == ECommonValidatorsNodeKind::MacroInstance)
+			{
+				const FName PerIterationPinName = FindPerIterationPinName(CastChecked<UK2Node_MacroInstance>(Node));
+				if (!PerIterationPinName.IsNone())
+				{
+					FCommonValidatorsIndexedLoop& Loop = OutGraph.Loops.AddDefaulted_GetRef();
+					Loop.NodeIndex = OutGraph.Nodes.Num() - 1;
+					Loop.PerIterationPinName = PerIterationPinName;
+
+					static const FName ArrayElementPinName(TEXT("Array Element"));
+					if (const UEdGraphPin* ElementPin = Node->FindPin(ArrayElementPinName, EGPD_Output))
+					{
+						Indexed.CopyBytes = GetPinValueSize(ElementPin->PinType);
+						Indexed.CopyKinds = ECommonValidatorsCopyKind::LoopElement;
+					}
+				}
+			}
+
+			NodeToIndex.Add(Node, OutGraph.Nodes.Num() - 1);
+		}
+
+		const int32 NumNodes = OutGraph.Nodes.Num();
+		OutGraph.ExecOffsets.Reserve(NumNodes + 1);
+		OutGraph.DataOffsets.Reserve(NumNodes + 1);
+		OutGraph.PureInputOffsets.Reserve(NumNodes + 1);
+
+		auto AddLinks = [&NodeToIndex](const UEdGraphPin* Pin, TArray<int32>& OutTargets)
+		{
+			for (const UEdGraphPin* Link : Pin->LinkedTo)
+			{
+				if (const int32* TargetIndex = NodeToIndex.Find(Link->GetOwningNode()))
+				{
+					OutTargets.Add(*TargetIndex);
+				}
+			}
+		};
+
+		for (FCommonValidatorsIndexedLoop& Loop : OutGraph.Loops)
+		{
+			for (const UEdGraphPin* Pin : OutGraph.Nodes[Loop.NodeIndex].Node->Pins)
+			{
+				if (Pin->Direction == EGPD_Output && IsExecPin(Pin) && IsLoopBodyPin(Pin))
+				{
+					AddLinks(Pin, Loop.BodyTargets);
+				}
+				else if (Pin->Direction == EGPD_Input && Pin->PinName == Loop.PerIterationPinName)
+				{
+					AddLinks(Pin, Loop.PerIterationProducers);
+				}
+			}
+		}
+
+		for (int32 NodeIndex = 0; NodeIndex < NumNodes; ++NodeIndex)
+		{
+			FCommonValidatorsIndexedNode& Indexed = OutGraph.Nodes[NodeIndex];
+			OutGraph.ExecOffsets.Add(OutGraph.ExecTargets.Num());
+			OutGraph.DataOffsets.Add(OutGraph.DataTargets.Num());
+
+			OutGraph.NumPins += Indexed.Node->Pins.Num();
+			InOutNumPins += Indexed.Node->Pins.Num();
+			for (const UEdGraphPin* Pin : Indexed.Node->Pins)
+			{
+				if (IsExecPin(Pin))
+				{
+					if (Pin->Direction == EGPD_Input)
+					{
+						// Matches FindPin(PN_Execute, EGPD_Input): only the canonical exec input makes a node impure.
+						if (Pin->PinName == UEdGraphSchema_K2::PN_Execute)
+						{
+							Indexed.bHasExecInput = true;
+							Indexed.bExecInputLinked |= Pin->LinkedTo.Num() > 0;
+						}
+						else
+						{
+							Indexed.bHasOtherExecInputs = true;
+						}
+					}
+					else
+					{
+						Indexed.bHasExecOutput = true;
+						if (Pin->LinkedTo.Num() > 0)
+						{
+							Indexed.bSeveralExecOutputsLinked |= Indexed.bExecOutputLinked;
+							Indexed.bExecOutputLinked = true;
+						}
+						AddLinks(Pin, OutGraph.ExecTargets);
+					}
+				}
+				else if (Pin->Direction == EGPD_Output)
+				{
+					// Split struct pins list their sub pins in Node->Pins as well, so they are visited on their own.
+					AddLinks(Pin, OutGraph.DataTargets);
+				}
+				else if (!Indexed.bIsPure && Pin->PinType.bIsReference && !Pin->PinType.bIsConst && Pin->LinkedTo.Num() > 0
+					&& !OutGraph.Loops.ContainsByPredicate([NodeIndex](const FCommonValidatorsIndexedLoop& Loop) { return Loop.NodeIndex == NodeIndex; }))
+				{
+					// The standard loops take their array by reference but only read it.
+					const UEdGraphPin* Source = SkipKnots(Pin->LinkedTo[0]);
+					if (const int32* Producer = Source ? NodeToIndex.Find(Source->GetOwningNode()) : nullptr)
+					{
+						OutGraph.ByRefWrites.Emplace(NodeIndex, *Producer);
+					}
+				}
+			}
+
+			if (!Indexed.bHasExecInput)
+			{
+				OutGraph.EntryNodes.Add(NodeIndex);
+			}
+
+			OutGraph.PureInputOffsets.Add(OutGraph.PureInputs.Num());
+			if (Indexed.bIsPure && Indexed.Kind != ECommonValidatorsNodeKind::Knot)
+			{
+				Indexed.PureSignature = ComputePureSignature(Indexed.Node, Indexed);
+				for (const UEdGraphPin* Pin : Indexed.Node->Pins)
+				{
+					if (Pin->Direction == EGPD_Input && !IsExecPin(Pin) && Pin->LinkedTo.Num() > 0)
+					{
+						const UEdGraphPin* Source = SkipKnots(Pin->LinkedTo[0]);
+						const int32* Producer = Source ? NodeToIndex.Find(Source->GetOwningNode()) : nullptr;
+						OutGraph.PureInputs.Add({ Producer ? *Producer : INDEX_NONE, HashPinNames(Pin, Source) });
+					}
+				}
+			}
+
+			if (Cast<UAnimGraphNode_Base>(Indexed.Node))
+			{
+				for (const UEdGraphPin* Pin : Indexed.Node->Pins)
+				{
+					if (Pin->Direction != EGPD_Input || Pin->LinkedTo.Num() == 0 || UAnimationGraphSchema::IsPosePin(Pin->PinType))
+					{
+						continue;
+					}
+
+					const UEdGraphPin* Source = SkipKnots(Pin->LinkedTo[0]);
+					if (Source && !IsFastPathSource(Source))
+					{
+						const int32* Producer = NodeToIndex.Find(Source->GetOwningNode());
+						OutGraph.SlowPathBindings.Add({ NodeIndex, Pin->PinName, Producer ? *Producer : INDEX_NONE });
+					}
+				}
+			}
+		}
+
+		OutGraph.ExecOffsets.Add(OutGraph.ExecTargets.Num());
+		OutGraph.DataOffsets.Add(OutGraph.DataTargets.Num());
+		OutGraph.PureInputOffsets.Add(OutGraph.PureInputs.Num());
+
+		// Exec reachability from every entry.
+		OutGraph.ExecReachable.Init(false, NumNodes);
+		TArray<int32> Queue;
+		Queue.Reserve(NumNodes);
+		for (int32 Entry : OutGraph.EntryNodes)
+		{
+			OutGraph.ExecReachable[Entry] = true;
+			Queue.Add(Entry);
+		}
+
+		while (Queue.Num() > 0)
+		{
+			const int32 Current = Queue.Pop(EAllowShrinking::No);
+			for (int32 Next : OutGraph.GetExecSuccessors(Current))
+			{
+				if (!OutGraph.ExecReachable[Next])
+				{
+					OutGraph.ExecReachable[Next] = true;
+					Queue.Add(Next);
+				}
+			}
+		}
+
+		FindLoopBodies(OutGraph);
+	}
+
+	// Whether the Blueprint of the class, or of one of its Blueprint parents, implements ReceiveTick with anything linked.
+	static bool HasBlueprintTick(const UClass* Class, TSet<TObjectKey<UBlueprint>>& InOutDependencies)
+	{
+		static const FName ReceiveTickName(TEXT("ReceiveTick"));
+
+		for (; Class; Class = Class->GetSuperClass())
+		{
+			UBlueprint* Blueprint = UBlueprint::GetBlueprintFromClass(Class);
+			if (!Blueprint)
+			{
+				// Blueprint classes only derive from native ones, there is nothing left above.
+				return false;
+			}
+
+			InOutDependencies.Add(Blueprint);
+			for (const UEdGraph* Graph : Blueprint->UbergraphPages)
+			{
+				if (!Graph)
+				{
+					continue;
+				}
+
+				for (const UEdGraphNode* Node : Graph->Nodes)
+				{
+					const UK2Node_Event* Event = Cast<UK2Node_Event>(Node);
+					if (!Event || Event->IsAutomaticallyPlacedGhostNode() || Event->EventReference.GetMemberName() != ReceiveTickName)
+					{
+						continue;
+					}
+
+					const UEdGraphPin* Then = Event->FindPin(UEdGraphSchema_K2::PN_Then, EGPD_Output);
+					if (Then && Then->LinkedTo.Num() > 0)
+					{
+						return true;
+					}
+				}
+			}
+		}
+		return false;
+	}
+
+	static void AddTickConfig(FName ComponentName, const UObject* Object, const FTickFunction& TickFunction, const FTickFunction& NativeTickFunction, TArray<FCommonValidatorsTickConfig>& OutConfigs, TSet<TObjectKey<UBlueprint>>& InOutDependencies)
+	{
+		FCommonValidatorsTickConfig& Config = OutConfigs.AddDefaulted_GetRef();
+		Config.ComponentName = ComponentName;
+		Config.ClassName = Object->GetClass()->GetFName();
+		Config.TickInterval = TickFunction.TickInterval;
+		Config.TickGroup = static_cast<uint8>(TickFunction.TickGroup.GetValue());
+		Config.bIsComponent = !ComponentName.IsNone();
+		Config.bCanEverTick = TickFunction.bCanEverTick;
+		Config.bStartWithTickEnabled = TickFunction.bStartWithTickEnabled;
+		Config.bNativeCanEverTick = NativeTickFunction.bCanEverTick;
+		Config.bHasBlueprintTick = HasBlueprintTick(Object->GetClass(), InOutDependencies);
+	}
+
+	// Reads the class defaults and component templates, which only change along with the Blueprint.
+	static void BuildReplication(const UBlueprint* Blueprint, FCommonValidatorsBlueprintIndex& OutIndex)
+	{
+		for (const FBPVariableDescription& Variable : Blueprint->NewVariables)
+		{
+			if ((Variable.PropertyFlags & CPF_Net) == 0)
+			{
+				continue;
+			}
+
+			FCommonValidatorsReplicatedVariable& Replicated = OutIndex.ReplicatedVariables.AddDefaulted_GetRef();
+			Replicated.Name = Variable.VarName;
+			Replicated.Bytes = GetPinValueSize(Variable.VarType);
+			Replicated.Condition = Variable.ReplicationCondition;
+			Replicated.bHasRepNotify = !Variable.RepNotifyFunc.IsNone();
+			Replicated.bIsContainer = Variable.VarType.IsContainer();
+		}
+
+		const UObject* Defaults = Blueprint->GeneratedClass ? Blueprint->GeneratedClass->GetDefaultObject(false) : nullptr;
+		if (const AActor* Actor = Cast<AActor>(Defaults))
+		{
+			OutIndex.bReplicates = Actor->GetIsReplicated();
+#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 5)
+			OutIndex.NetUpdateFrequency = Actor->GetNetUpdateFrequency();
+#else
+			OutIndex.NetUpdateFrequency = Actor->NetUpdateFrequency;
+#endif
+		}
+		else if (const UActorComponent* Component = Cast<UActorComponent>(Defaults))
+		{
+			OutIndex.bReplicates = Component->GetIsReplicated();
+		}
+	}
+
+	static void BuildTickConfigs(const UBlueprint* Blueprint, TArray<FCommonValidatorsTickConfig>& OutConfigs, TSet<TObjectKey<UBlueprint>>& InOutDependencies)
+	{
+		const UClass* GeneratedClass = Blueprint->GeneratedClass;
+		if (!GeneratedClass)
+		{
+			return;
+		}
+
+		const UClass* NativeClass = FBlueprintEditorUtils::FindFirstNativeClass(const_cast<UClass*>(GeneratedClass));
+		if (const AActor* Actor = Cast<AActor>(GeneratedClass->GetDefaultObject(false)))
+		{
+			AddTickConfig(NAME_None, Actor, Actor->PrimaryActorTick, CastChecked<AActor>(NativeClass->GetDefaultObject())->PrimaryActorTick, OutConfigs, InOutDependencies);
+		}
+		else if (const UActorComponent* Component = Cast<UActorComponent>(GeneratedClass->GetDefaultObject(false)))
+		{
+			AddTickConfig(NAME_None, Component, Component->PrimaryComponentTick, CastChecked<UActorComponent>(NativeClass->GetDefaultObject())->PrimaryComponentTick, OutConfigs, InOutDependencies);
+			return;
+		}
+		else
+		{
+			return;
+		}
+
+		if (!Blueprint->SimpleConstructionScript)
+		{
+			return;
+		}
+
+		for (const USCS_Node* SCSNode : Blueprint->SimpleConstructionScript->GetAllNodes())
+		{
+			const UActorComponent* Template = SCSNode ? Cast<UActorComponent>(SCSNode->ComponentTemplate) : nullptr;
+			if (!Template)
+			{
+				continue;
+			}
+
+			const UClass* NativeComponentClass = FBlueprintEditorUtils::FindFirstNativeClass(Template->GetClass());
+			AddTickConfig(SCSNode->GetVariableName(), Template, Template->PrimaryComponentTick,
+				CastChecked<UActorComponent>(NativeComponentClass->GetDefaultObject())->PrimaryComponentTick, OutConfigs, InOutDependencies);
+		}
+	}
+
+	static void HashName(FXxHash64Builder& Builder, FName Name)
+	{
+		TStringBuilder<128> String;
+		Name.AppendString(String);
+		const int32 Len = String.Len();
+		Builder.Update(&Len, sizeof(Len));
+		Builder.Update(String.GetData(), Len * sizeof(TCHAR));
+	}
+
+	template <typename ElementType>
+	static void HashArray(FXxHash64Builder& Builder, const TArray<ElementType>& Array)
+	{
+		const int32 Num = Array.Num();
+		Builder.Update(&Num, sizeof(Num));
+		Builder.Update(Array.GetData(), Num * sizeof(ElementType));
+	}
+
+	// Hashes names rather than pointers or FName indices, so the result is stable across processes.
+	static uint64 ComputeContentHash(const FCommonValidatorsBlueprintIndex& Index)
+	{
+		FXxHash64Builder Builder;
+
+		for (const FName ParentClassName : Index.ParentClassNames)
+		{
+			HashName(Builder, ParentClassName);
+		}
+
+		const uint8 ClassFlags = (Index.bIsAnimBlueprint << 0) | (Index.bMultiThreadedAnimationUpdate << 1) | (Index.bReplicates << 2);
+		Builder.Update(&ClassFlags, sizeof(ClassFlags));
+		Builder.Update(&Index.NetUpdateFrequency, sizeof(Index.NetUpdateFrequency));
+
+		for (const FCommonValidatorsReplicatedVariable& Variable : Index.ReplicatedVariables)
+		{
+			HashName(Builder, Variable.Name);
+			const uint8 Flags = (Variable.bHasRepNotify << 0) | (Variable.bIsContainer << 1);
+			Builder.Update(&Variable.Bytes, sizeof(Variable.Bytes));
+			Builder.Update(&Variable.Condition, sizeof(Variable.Condition));
+			Builder.Update(&Flags, sizeof(Flags));
+		}
+
+		for (const FCommonValidatorsTickConfig& Config : Index.TickConfigs)
+		{
+			HashName(Builder, Config.ComponentName);
+			HashName(Builder, Config.ClassName);
+			const uint8 Flags = (Config.bIsComponent << 0) | (Config.bCanEverTick << 1) | (Config.bStartWithTickEnabled << 2)
+				| (Config.bNativeCanEverTick << 3) | (Config.bHasBlueprintTick << 4);
+			Builder.Update(&Config.TickInterval, sizeof(Config.TickInterval));
+			Builder.Update(&Config.TickGroup, sizeof(Config.TickGroup));
+			Builder.Update(&Flags, sizeof(Flags));
+		}
+
+		for (const FCommonValidatorsIndexedGraph& Graph : Index.Graphs)
+		{
+			HashName(Builder, Graph.GraphName);
+			Builder.Update(&Graph.Kind, sizeof(Graph.Kind));
+
+			const int32 NumNodes = Graph.Nodes.Num();
+			Builder.Update(&NumNodes, sizeof(NumNodes));
+			for (const FCommonValidatorsIndexedNode& Node : Graph.Nodes)
+			{
+				// bIsHarmlessPure is left out on purpose, it depends on settings rather than content
+				const uint16 Flags = (Node.bIsPure << 0) | (Node.bHasExecInput << 1) | (Node.bExecInputLinked << 2)
+					| (Node.bHasExecOutput << 3) | (Node.bExecOutputLinked << 4) | (Node.bIsGhostNode << 5) | (Node.bIsThreadSafe << 6)
+					| (Node.bHasOtherExecInputs << 7) | (Node.bSeveralExecOutputsLinked << 8) | (Node.bIsFlowControl << 9) | (Node.bIsLocalVariable << 10);
+				// Cached findings point at nodes by GUID, so a node replaced by an identical one must miss the cache.
+				Builder.Update(&Node.NodeGuid, sizeof(Node.NodeGuid));
+				Builder.Update(&Node.Kind, sizeof(Node.Kind));
+				Builder.Update(&Flags, sizeof(Flags));
+				HashName(Builder, Node.MemberName);
+				HashName(Builder, Node.FunctionOwnerName);
+				Builder.Update(&Node.PureSignature, sizeof(Node.PureSignature));
+				Builder.Update(&Node.CopyBytes, sizeof(Node.CopyBytes));
+				Builder.Update(&Node.CopyKinds, sizeof(Node.CopyKinds));
+				Builder.Update(&Node.NetBytes, sizeof(Node.NetBytes));
+				Builder.Update(&Node.NetKind, sizeof(Node.NetKind));
+			}
+
+			HashArray(Builder, Graph.ExecOffsets);
+			HashArray(Builder, Graph.ExecTargets);
+			HashArray(Builder, Graph.DataOffsets);
+			HashArray(Builder, Graph.DataTargets);
+			HashArray(Builder, Graph.PureInputOffsets);
+			HashArray(Builder, Graph.PureInputs);
+
+			const int32 NumBindings = Graph.SlowPathBindings.Num();
+			Builder.Update(&NumBindings, sizeof(NumBindings));
+			for (const FCommonValidatorsAnimBinding& Binding : Graph.SlowPathBindings)
+			{
+				Builder.Update(&Binding.NodeIndex, sizeof(Binding.NodeIndex));
+				HashName(Builder, Binding.PinName);
+				Builder.Update(&Binding.Producer, sizeof(Binding.Producer));
+			}
+
+			const int32 NumLoops = Graph.Loops.Num();
+			Builder.Update(&NumLoops, sizeof(NumLoops));
+			for (const FCommonValidatorsIndexedLoop& Loop : Graph.Loops)
+			{
+				Builder.Update(&Loop.NodeIndex, sizeof(Loop.NodeIndex));
+				HashName(Builder, Loop.PerIterationPinName);
+				HashArray(Builder, Loop.BodyTargets);
+				HashArray(Builder, Loop.PerIterationProducers);
+			}
+			HashArray(Builder, Graph.ByRefWrites);
+
+			// Summaries depend on other Blueprints, hashing them keeps cached results in sync with the callees.
+			for (const TPair<int32, TSharedRef<const FCommonValidatorsCallSummary>>& Pair : Graph.CallSummaries)
+			{
+				Builder.Update(&Pair.Key, sizeof(Pair.Key));
+				for (const FName Name : Pair.Value->BlockingChain)
+				{
+					HashName(Builder, Name);
+				}
+
+				const int32 NumCalls = Pair.Value->Calls.Num();
+				Builder.Update(&NumCalls, sizeof(NumCalls));
+				for (const FCommonValidatorsReachedCall& Call : Pair.Value->Calls)
+				{
+					HashName(Builder, Call.OwnerName);
+					HashName(Builder, Call.FunctionName);
+					for (const FName Name : Call.Chain)
+					{
+						HashName(Builder, Name);
+					}
+				}
+			}
+		}
+
+		return Builder.Finalize().Hash;
+	}
+} // namespace UE::Internal::GraphIndexHelpers
+
+
+void FCommonValidatorsIndexedGraph::BuildDataProducers(TArray<int32>& OutOffsets, TArray<int32>& OutProducers) const
+{
+	const int32 NumNodes = Nodes.Num();
+	OutOffsets.SetNumZeroed(NumNodes + 1);
+	for (const int32 Consumer : DataTargets)
+	{
+		++OutOffsets[Consumer + 1];
+	}
+	for (int32 NodeIndex = 0; NodeIndex < NumNodes; ++NodeIndex)
+	{
+		OutOffsets[NodeIndex + 1] += OutOffsets[NodeIndex];
+	}
+
+	OutProducers.SetNumUninitialized(DataTargets.Num());
+	TArray<int32> Cursors(OutOffsets);
+	for (int32 Producer = 0; Producer < NumNodes; ++Producer)
+	{
+		for (const int32 Consumer : GetDataConsumers(Producer))
+		{
+			OutProducers[Cursors[Consumer]++] = Producer;
+		}
+	}
+}
+
+void FCommonValidatorsIndexedGraph::BuildExecPredecessors(TArray<int32>& OutOffsets, TArray<int32>& OutPredecessors) const
+{
+	const int32 NumNodes = Nodes.Num();
+	OutOffsets.SetNumZeroed(NumNodes + 1);
+	for (const int32 Successor : ExecTargets)
+	{
+		++OutOffsets[Successor + 1];
+	}
+	for (int32 NodeIndex = 0; NodeIndex < NumNodes; ++NodeIndex)
+	{
+		OutOffsets[NodeIndex + 1] += OutOffsets[NodeIndex];
+	}
+
+	OutPredecessors.SetNumUninitialized(ExecTargets.Num());
+	TArray<int32> Cursors(OutOffsets);
+	for (int32 Predecessor = 0; Predecessor < NumNodes; ++Predecessor)
+	{
+		for (const int32 Successor : GetExecSuccessors(Predecessor))
+		{
+			OutPredecessors[Cursors[Successor]++] = Predecessor;
+		}
+	}
+}
+
+void FCommonValidatorsExecDominators::Build(const FCommonValidatorsIndexedGraph& Graph)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FCommonValidatorsExecDominators::Build);
+
+	// Cooper, Harvey and Kennedy's iterative algorithm. The virtual root is node NumNodes, its successors the entries.
+	const int32 NumNodes = Graph.Nodes.Num();
+	const int32 Root = NumNodes;
+	auto GetSuccessors = [&Graph, Root](int32 NodeIndex)
+	{
+		return NodeIndex == Root ? TArrayView<const int32>(Graph.EntryNodes) : Graph.GetExecSuccessors(NodeIndex);
+	};
+
+	// Post-order of everything the root reaches, iteratively.
+	PostOrder.Init(INDEX_NONE, NumNodes + 1);
+	TArray<int32> Order;
+	Order.Reserve(NumNodes + 1);
+	{
+		TBitArray<> Visited(false, NumNodes + 1);
+		TArray<TPair<int32, int32>> Stack;
+		Stack.Emplace(Root, 0);
+		Visited[Root] = true;
+		while (Stack.Num() > 0)
+		{
+			const int32 Current = Stack.Last().Key;
+			const TArrayView<const int32> Successors = GetSuccessors(Current);
+			if (Stack.Last().Value < Successors.Num())
+			{
+				const int32 Successor = Successors[Stack.Last().Value++];
+				if (!Visited[Successor])
+				{
+					Visited[Successor] = true;
+					Stack.Emplace(Successor, 0);
+				}
+				continue;
+			}
+
+			PostOrder[Current] = Order.Num();
+			Order.Add(Current);
+			Stack.Pop(EAllowShrinking::No);
+		}
+	}
+
+	// Exec predecessors of the reachable nodes, the root counting as the predecessor of every entry.
+	TArray<int32> PredecessorOffsets;
+	TArray<int32> Predecessors;
+	PredecessorOffsets.SetNumZeroed(NumNodes + 2);
+	for (const int32 Node : Order)
+	{
+		for (const int32 Successor : GetSuccessors(Node))
+		{
+			++PredecessorOffsets[Successor + 1];
+		}
+	}
+	for (int32 NodeIndex = 0; NodeIndex <= NumNodes; ++NodeIndex)
+	{
+		PredecessorOffsets[NodeIndex + 1] += PredecessorOffsets[NodeIndex];
+	}
+	Predecessors.SetNumUninitialized(PredecessorOffsets[NumNodes + 1]);
+	{
+		TArray<int32> Cursors(PredecessorOffsets);
+		for (const int32 Node : Order)
+		{
+			for (const int32 Successor : GetSuccessors(Node))
+			{
+				Predecessors[Cursors[Successor]++] = Node;
+			}
+		}
+	}
+
+	TArray<int32> Dominators;
+	Dominators.Init(INDEX_NONE, NumNodes + 1);
+	Dominators[Root] = Root;
+	auto Intersect = [this, &Dominators](int32 A, int32 B)
+	{
+		while (A != B)
+		{
+			while (PostOrder[A] < PostOrder[B])
+			{
+				A = Dominators[A];
+			}
+			while (PostOrder[B] < PostOrder[A])
+			{
+				B = Dominators[B];
+			}
+		}
+		return A;
+	};
+
+	bool bChanged = true;
+	while (bChanged)
+	{
+		bChanged = false;
+		for (int32 OrderIndex = Order.Num() - 2; OrderIndex >= 0; --OrderIndex)
+		{
+			const int32 Node = Order[OrderIndex];
+			int32 NewDominator = INDEX_NONE;
+			for (int32 Offset = PredecessorOffsets[Node]; Offset < PredecessorOffsets[Node + 1]; ++Offset)
+			{
+				const int32 Predecessor = Predecessors[Offset];
+				if (Dominators[Predecessor] != INDEX_NONE)
+				{
+					NewDominator = NewDominator == INDEX_NONE ? Predecessor : Intersect(Predecessor, NewDominator);
+				}
+			}
+
+			if (Dominators[Node] != NewDominator)
+			{
+				Dominators[Node] = NewDominator;
+				bChanged = true;
+			}
+		}
+	}
+
+	// The root only exists while building.
+	ImmediateDominators.SetNumUninitialized(NumNodes);
+	for (int32 NodeIndex = 0; NodeIndex < NumNodes; ++NodeIndex)
+	{
+		ImmediateDominators[NodeIndex] = Dominators[NodeIndex] == Root ? INDEX_NONE : Dominators[NodeIndex];
+	}
+	PostOrder.SetNum(NumNodes);
+}
+
+bool FCommonValidatorsExecDominators::Dominates(int32 A, int32 B) const
+{
+	if (!IsReachable(A) || !IsReachable(B))
+	{
+		return false;
+	}
+
+	// Dominators come later in post-order, so the walk up can stop as soon as it passes A.
+	while (B != INDEX_NONE && PostOrder[B] <= PostOrder[A])
+	{
+		if (B == A)
+		{
+			return true;
+		}
+		B = ImmediateDominators[B];
+	}
+	return false;
+}
+
+int32 FCommonValidatorsExecDominators::FindCommonDominator(int32 A, int32 B) const
+{
+	if (!IsReachable(A) || !IsReachable(B))
+	{
+		return INDEX_NONE;
+	}
+
+	while (A != B)
+	{
+		if (PostOrder[A] < PostOrder[B])
+		{
+			A = ImmediateDominators[A];
+		}
+		else
+		{
+			B = ImmediateDominators[B];
+		}
+
+		if (A == INDEX_NONE || B == INDEX_NONE)
+		{
+			return INDEX_NONE;
+		}
+	}
+	return A;
+}
+
+const TArray<FName>* FCommonValidatorsIndexedGraph::FindBlockingChain(int32 NodeIndex) const
+{
+	const TSharedRef<const FCommonValidatorsCallSummary>* Summary = CallSummaries.Find(NodeIndex);
+	return Summary && (*Summary)->BlockingChain.Num() > 0 ? &(*Summary)->BlockingChain : nullptr;
+}
+
+int32 FCommonValidatorsIndexedGraph::FindNodeIndex(const UEdGraphNode* Node) const
+{
+	return Nodes.IndexOfByPredicate([Node](const FCommonValidatorsIndexedNode& Indexed) { return Indexed.Node == Node; });
+}
+
+SIZE_T FCommonValidatorsIndexedGraph::GetAllocatedSize() const
+{
+	SIZE_T Size = Nodes.GetAllocatedSize() + ExecOffsets.GetAllocatedSize() + ExecTargets.GetAllocatedSize()
+		+ DataOffsets.GetAllocatedSize() + DataTargets.GetAllocatedSize() + EntryNodes.GetAllocatedSize() + ExecReachable.GetAllocatedSize()
+		+ Loops.GetAllocatedSize() + ByRefWrites.GetAllocatedSize() + CallSummaries.GetAllocatedSize() + RuleMatches.GetAllocatedSize()
+		+ PureInputOffsets.GetAllocatedSize() + PureInputs.GetAllocatedSize() + SlowPathBindings.GetAllocatedSize();
+	for (const FCommonValidatorsIndexedLoop& Loop : Loops)
+	{
+		Size += Loop.BodyTargets.GetAllocatedSize() + Loop.BodyNodes.GetAllocatedSize() + Loop.PerIterationProducers.GetAllocatedSize();
+	}
+	return Size;
+}
+
+SIZE_T FCommonValidatorsBlueprintIndex::GetAllocatedSize() const
+{
+	SIZE_T Size = Graphs.GetAllocatedSize() + ParentClassNames.GetAllocatedSize() + TickConfigs.GetAllocatedSize() + ReplicatedVariables.GetAllocatedSize()
+		+ Dependencies.GetAllocatedSize();
+	for (const FCommonValidatorsIndexedGraph& Graph : Graphs)
+	{
+		Size += Graph.GetAllocatedSize();
+	}
+	return Size;
+}
+
+void FCommonValidatorsBlueprintIndex::CollectSubGraphs(const UBlueprint* Blueprint, TArray<UEdGraph*>& OutGraphs)
+{
+	if (!Cast<UAnimBlueprint>(Blueprint))
+	{
+		return;
+	}
+
+	for (const UEdGraph* Graph : Blueprint->FunctionGraphs)
+	{
+		if (Graph)
+		{
+			UE::Internal::GraphIndexHelpers::CollectSubGraphs(Graph, OutGraphs);
+		}
+	}
+}
+
+TSharedRef<FCommonValidatorsBlueprintIndex> FCommonValidatorsBlueprintIndex::Build(const UBlueprint* Blueprint)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FCommonValidatorsBlueprintIndex::Build);
+	SCOPE_CYCLE_COUNTER(STAT_CommonValidators_BuildGraphIndex);
+
+	TSharedRef<FCommonValidatorsBlueprintIndex> Index = MakeShared<FCommonValidatorsBlueprintIndex>();
+	Index->Graphs.Reserve(Blueprint->FunctionGraphs.Num() + Blueprint->UbergraphPages.Num());
+
+	TSet<TObjectKey<UBlueprint>> Dependencies;
+	auto AddGraphs = [&Index, &Dependencies](const auto& Graphs, ECommonValidatorsGraphKind Kind)
+	{
+		for (UEdGraph* Graph : Graphs)
+		{
+			if (Graph)
+			{
+				UE::Internal::GraphIndexHelpers::BuildGraph(Graph, Kind, Index->Graphs.AddDefaulted_GetRef(), Index->NumPins, Dependencies);
+				Index->NumNodes += Index->Graphs.Last().Nodes.Num();
+			}
+		}
+	};
+
+	Index->PackageName = Blueprint->GetPackage()->GetFName();
+	for (const UClass* Class = Blueprint->ParentClass; Class; Class = Class->GetSuperClass())
+	{
+		Index->ParentClassNames.Add(Class->GetFName());
+	}
+
+	AddGraphs(Blueprint->FunctionGraphs, ECommonValidatorsGraphKind::Function);
+	AddGraphs(Blueprint->UbergraphPages, ECommonValidatorsGraphKind::Ubergraph);
+
+	TArray<UEdGraph*> SubGraphs;
+	CollectSubGraphs(Blueprint, SubGraphs);
+	AddGraphs(SubGraphs, ECommonValidatorsGraphKind::SubGraph);
+
+	if (const UAnimBlueprint* AnimBlueprint = Cast<UAnimBlueprint>(Blueprint))
+	{
+		Index->bIsAnimBlueprint = true;
+		Index->bMultiThreadedAnimationUpdate = AnimBlueprint->bUseMultiThreadedAnimationUpdate;
+	}
+
+	TSet<TObjectKey<UBlueprint>> TickDependencies;
+	UE::Internal::GraphIndexHelpers::BuildTickConfigs(Blueprint, Index->TickConfigs, TickDependencies);
+	TickDependencies.Remove(Blueprint);
+	Index->NumTickDependencies = TickDependencies.Num();
+	Dependencies.Append(TickDependencies);
+	UE::Internal::GraphIndexHelpers::BuildReplication(Blueprint, *Index);
+
+	Dependencies.Remove(Blueprint);
+	Index->Dependencies = Dependencies.Array();
+
+	Index->ContentHash = UE::Internal::GraphIndexHelpers::ComputeContentHash(*Index);
+
+	INC_DWORD_STAT_BY(STAT_CommonValidators_IndexedNodes, Index->NumNodes);
+	INC_DWORD_STAT_BY(STAT_CommonValidators_IndexedPins, Index->NumPins);
+
+	return Index;
+}
+
+TSharedRef<FCommonValidatorsBlueprintIndex> FCommonValidatorsBlueprintIndex::Rebuild(const UBlueprint* Blueprint, const FCommonValidatorsBlueprintIndex& Previous, const TSet<const UEdGraph*>& ChangedGraphs)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FCommonValidatorsBlueprintIndex::Rebuild);
+
+	// Call summaries of the other graphs may depend on an edited function, and added or removed graphs shift every index.
+	TArray<UEdGraph*, TInlineAllocator<32>> CurrentGraphs;
+	TArray<ECommonValidatorsGraphKind, TInlineAllocator<32>> CurrentKinds;
+	for (UEdGraph* Graph : Blueprint->FunctionGraphs)
+	{
+		if (Graph)
+		{
+			CurrentGraphs.Add(Graph);
+			CurrentKinds.Add(ECommonValidatorsGraphKind::Function);
+		}
+	}
+	for (UEdGraph* Graph : Blueprint->UbergraphPages)
+	{
+		if (Graph)
+		{
+			CurrentGraphs.Add(Graph);
+			CurrentKinds.Add(ECommonValidatorsGraphKind::Ubergraph);
+		}
+	}
+
+	TArray<UEdGraph*> SubGraphs;
+	CollectSubGraphs(Blueprint, SubGraphs);
+	for (UEdGraph* Graph : SubGraphs)
+	{
+		CurrentGraphs.Add(Graph);
+		CurrentKinds.Add(ECommonValidatorsGraphKind::SubGraph);
+	}
+
+	bool bCanReuse = CurrentGraphs.Num() == Previous.Graphs.Num();
+	for (int32 GraphIndex = 0; bCanReuse && GraphIndex < CurrentGraphs.Num(); ++GraphIndex)
+	{
+		bCanReuse = Previous.Graphs[GraphIndex].Graph == CurrentGraphs[GraphIndex]
+			&& !(CurrentKinds[GraphIndex] == ECommonValidatorsGraphKind::Function && ChangedGraphs.Contains(CurrentGraphs[GraphIndex]));
+	}
+	if (!bCanReuse)
+	{
+		return Build(Blueprint);
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_CommonValidators_BuildGraphIndex);
+
+	TSharedRef<FCommonValidatorsBlueprintIndex> Index = MakeShared<FCommonValidatorsBlueprintIndex>();
+	Index->PackageName = Previous.PackageName;
+	Index->ParentClassNames = Previous.ParentClassNames;
+	Index->bIsAnimBlueprint = Previous.bIsAnimBlueprint;
+	Index->bMultiThreadedAnimationUpdate = Previous.bMultiThreadedAnimationUpdate;
+	Index->Graphs.Reserve(CurrentGraphs.Num());
+
+	TSet<TObjectKey<UBlueprint>> Dependencies(Previous.Dependencies);
+	for (int32 GraphIndex = 0; GraphIndex < CurrentGraphs.Num(); ++GraphIndex)
+	{
+		if (ChangedGraphs.Contains(CurrentGraphs[GraphIndex]))
+		{
+			UE::Internal::GraphIndexHelpers::BuildGraph(CurrentGraphs[GraphIndex], CurrentKinds[GraphIndex], Index->Graphs.AddDefaulted_GetRef(), Index->NumPins, Dependencies);
+		}
+		else
+		{
+			Index->NumPins += Index->Graphs.Add_GetRef(Previous.Graphs[GraphIndex]).NumPins;
+		}
+		Index->NumNodes += Index->Graphs.Last().Nodes.Num();
+	}
+
+	TSet<TObjectKey<UBlueprint>> TickDependencies;
+	UE::Internal::GraphIndexHelpers::BuildTickConfigs(Blueprint, Index->TickConfigs, TickDependencies);
+	TickDependencies.Remove(Blueprint);
+	Index->NumTickDependencies = TickDependencies.Num();
+	Dependencies.Append(TickDependencies);
+	UE::Internal::GraphIndexHelpers::BuildReplication(Blueprint, *Index);
+
+	// Dependencies of the old graph versions are kept, they only make the index invalidated more often than needed.
+	Dependencies.Remove(Blueprint);
+	Index->Dependencies = Dependencies.Array();
+
+	Index->ContentHash = UE::Internal::GraphIndexHelpers::ComputeContentHash(*Index);
+	return Index;
+}
+
+
+FCommonValidatorsGraphIndexCache& FCommonValidatorsGraphIndexCache::Get()
+{
+	static FCommonValidatorsGraphIndexCache Instance;
+	return Instance;
+}
+
+void FCommonValidatorsGraphIndexCache::Initialize()
+{
+	ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddRaw(this, &FCommonValidatorsGraphIndexCache::OnObjectModified);
+	ObjectPropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddRaw(this, &FCommonValidatorsGraphIndexCache::OnObjectPropertyChanged);
+	ObjectTransactedHandle = FCoreUObjectDelegates::OnObjectTransacted.AddRaw(this, &FCommonValidatorsGraphIndexCache::OnObjectTransacted);
+	PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FCommonValidatorsGraphIndexCache::OnPostGarbageCollect);
+}
+
+void FCommonValidatorsGraphIndexCache::Shutdown()
+{
+	FCoreUObjectDelegates::OnObjectModified.Remove(ObjectModifiedHandle);
+	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(ObjectPropertyChangedHandle);
+	FCoreUObjectDelegates::OnObjectTransacted.Remove(ObjectTransactedHandle);
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+
+	Reset();
+}
+
+TSharedRef<const FCommonValidatorsBlueprintIndex> FCommonValidatorsGraphIndexCache::FindOrBuild(UBlueprint* Blueprint)
+{
+	check(IsInGameThread());
+	check(Blueprint);
+
+	FCommonValidatorsPureNodeAllowlist& Allowlist = FCommonValidatorsPureNodeAllowlist::Get();
+	Allowlist.Refresh();
+	FCommonValidatorsNodeRules& NodeRules = FCommonValidatorsNodeRules::Get();
+	NodeRules.Refresh();
+
+	const TObjectKey<UBlueprint> Key(Blueprint);
+	if (const FEntry* Existing = Entries.Find(Key))
+	{
+		if (Existing->AllowlistGeneration == Allowlist.GetGeneration() && Existing->NodeRulesGeneration == NodeRules.GetGeneration())
+		{
+			return Existing->Index.ToSharedRef();
+		}
+		RemoveEntry(Key);
+	}
+
+	// Build before adding: anything Build ends up calling may add entries and reallocate the map.
+	const double StartTime = FPlatformTime::Seconds();
+	TSharedRef<const FCommonValidatorsBlueprintIndex> Index = FCommonValidatorsBlueprintIndex::Build(Blueprint);
+	FCommonValidatorsProfiler::Get().Record(TEXT("GraphIndex"), Blueprint->GetPathName(), Index->NumNodes, Index->NumPins, FPlatformTime::Seconds() - StartTime);
+
+	FEntry& Entry = Entries.Add(Key);
+	Entry.Index = Index;
+	Entry.Blueprint = Blueprint;
+	Entry.AllowlistGeneration = Allowlist.GetGeneration();
+	Entry.NodeRulesGeneration = NodeRules.GetGeneration();
+
+	// Structural modifications and compiles are broadcast on the Blueprint, node adds/removes on the graphs.
+	// Pin edits go through Modify() and are caught by OnObjectModified.
+	Entry.ChangedHandle = Blueprint->OnChanged().AddLambda([this, Key](UBlueprint*) { RemoveEntry(Key); });
+	Entry.CompiledHandle = Blueprint->OnCompiled().AddLambda([this, Key](UBlueprint*) { RemoveEntry(Key); });
+
+	for (const FCommonValidatorsIndexedGraph& IndexedGraph : Entry.Index->Graphs)
+	{
+		const FDelegateHandle Handle = IndexedGraph.Graph->AddOnGraphChangedHandler(FOnGraphChanged::FDelegate::CreateLambda(
+			[this, Key](const FEdGraphEditAction& Action)
+			{
+				// Selection and node refreshes (e.g. validators setting compiler messages) leave the structure intact.
+				if ((Action.Action & (GRAPHACTION_AddNode | GRAPHACTION_RemoveNode)) != 0 || Action.Action == GRAPHACTION_Default)
+				{
+					RemoveEntry(Key);
+				}
+			}));
+		Entry.GraphHandles.Emplace(IndexedGraph.Graph, Handle);
+	}
+
+	return Entry.Index.ToSharedRef();
+}
+
+TSharedPtr<const FCommonValidatorsBlueprintIndex> FCommonValidatorsGraphIndexCache::Find(const UBlueprint* Blueprint) const
+{
+	check(IsInGameThread());
+
+	const FEntry* Entry = Entries.Find(TObjectKey<UBlueprint>(Blueprint));
+	return Entry ? Entry->Index : nullptr;
+}
+
+void FCommonValidatorsGraphIndexCache::Invalidate(const UBlueprint* Blueprint)
+{
+	RemoveEntry(TObjectKey<UBlueprint>(Blueprint));
+}
+
+void FCommonValidatorsGraphIndexCache::Reset()
+{
+	TArray<TObjectKey<UBlueprint>> Keys;
+	Entries.GetKeys(Keys);
+	for (const TObjectKey<UBlueprint>& Key : Keys)
+	{
+		RemoveEntry(Key);
+	}
+}
+
+void FCommonValidatorsGraphIndexCache::RemoveEntry(const TObjectKey<UBlueprint>& Key)
+{
+	FEntry Entry;
+	if (!Entries.RemoveAndCopyValue(Key, Entry))
+	{
+		return;
+	}
+
+	if (UBlueprint* Blueprint = Entry.Blueprint.Get())
+	{
+		Blueprint->OnChanged().Remove(Entry.ChangedHandle);
+		Blueprint->OnCompiled().Remove(Entry.CompiledHandle);
+	}
+
+	for (const TPair<TWeakObjectPtr<UEdGraph>, FDelegateHandle>& GraphHandle : Entry.GraphHandles)
+	{
+		if (UEdGraph* Graph = GraphHandle.Key.Get())
+		{
+			Graph->RemoveOnGraphChangedHandler(GraphHandle.Value);
+		}
+	}
+}
+
+void FCommonValidatorsGraphIndexCache::InvalidateOwningBlueprint(const UObject* Object)
+{
+	if (Entries.IsEmpty() || !Object)
+	{
+		return;
+	}
+
+	const UBlueprint* Blueprint = Cast<UBlueprint>(Object);
+	if (!Blueprint)
+	{
+		Blueprint = Object->GetTypedOuter<UBlueprint>();
+	}
+	if (!Blueprint)
+	{
+		// Class defaults and component templates are owned by the generated class, not the Blueprint.
+		const UClass* Class = Object->HasAnyFlags(RF_ClassDefaultObject) ? Object->GetClass() : Object->GetTypedOuter<UClass>();
+		Blueprint = Class ? UBlueprint::GetBlueprintFromClass(Class) : nullptr;
+	}
+
+	if (Blueprint)
+	{
+		Invalidate(Blueprint);
+
+		// Indices that followed calls into this Blueprint are stale as well.
+		const TObjectKey<UBlueprint> Key(Blueprint);
+		TArray<TObjectKey<UBlueprint>, TInlineAllocator<8>> Dependents;
+		for (const TPair<TObjectKey<UBlueprint>, FEntry>& Pair : Entries)
+		{
+			if (Pair.Value.Index->Dependencies.Contains(Key))
+			{
+				Dependents.Add(Pair.Key);
+			}
+		}
+
+		for (const TObjectKey<UBlueprint>& Dependent : Dependents)
+		{
+			RemoveEntry(Dependent);
+		}
+	}
+}
+
+void FCommonValidatorsGraphIndexCache::OnObjectModified(UObject* Object)
+{
+	InvalidateOwningBlueprint(Object);
+}
+
+void FCommonValidatorsGraphIndexCache::OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent)
+{
+	InvalidateOwningBlueprint(Object);
+}
+
+void FCommonValidatorsGraphIndexCache::OnObjectTransacted(UObject* Object, const FTransactionObjectEvent& TransactionEvent)
+{
+	// Undo/redo restores graphs without going through Modify().
+	InvalidateOwningBlueprint(Object);
+}
+
+void FCommonValidatorsGraphIndexCache::OnPostGarbageCollect()
+{
+	for (auto It = Entries.CreateIterator(); It; ++It)
+	{
+		if (!It.Value().Blueprint.IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
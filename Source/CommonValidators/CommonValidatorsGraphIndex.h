@@ -0,0 +1,447 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+class UBlueprint;
+class UEdGraph;
+class UEdGraphNode;
+class UFunction;
+struct FCommonValidatorsCallSummary;
+
+// Coarse node classification, so validators don't have to cast every node they look at.
+enum class ECommonValidatorsNodeKind : uint8
+{
+	Other,
+	CallFunction,
+	Event,
+	FunctionEntry,
+	FunctionResult,
+	MacroInstance,
+	VariableGet,
+	VariableSet,
+	BreakStruct,
+	MakeStruct,
+	Knot
+};
+
+enum class ECommonValidatorsGraphKind : uint8
+{
+	Ubergraph,
+	Function,
+
+	// Graph nested in a function graph of an Anim Blueprint: state machines, states, transition rules.
+	SubGraph
+};
+
+// Ways a node copies values by value each time it runs.
+enum class ECommonValidatorsCopyKind : uint8
+{
+	None = 0,
+
+	// Array Get (a copy).
+	ArrayGetCopy = 1 << 0,
+
+	// ForEachLoop and its variants copy the element on every iteration.
+	LoopElement = 1 << 1,
+
+	// Input of a Blueprint function without Pass-by-Reference.
+	BlueprintByValueInput = 1 << 2,
+
+	// By-value input of a native function.
+	NativeByValueInput = 1 << 3,
+
+	// Return values and output parameters, copied into a temporary on every call.
+	Output = 1 << 4
+};
+ENUM_CLASS_FLAGS(ECommonValidatorsCopyKind);
+
+// Network traffic a node causes every time it runs.
+enum class ECommonValidatorsNetKind : uint8
+{
+	None,
+	UnreliableRpc,
+	ReliableRpc,
+
+	// Set of a replicated variable.
+	ReplicatedWrite,
+
+	// Set of a replicated variable with a RepNotify, which Blueprints also call on the server.
+	RepNotifyWrite
+};
+
+// Flattened view of a single graph node.
+struct FCommonValidatorsIndexedNode
+{
+	// Bit-fields can't have default member initializers before C++20.
+	FCommonValidatorsIndexedNode()
+		: bIsPure(false)
+		, bIsHarmlessPure(false)
+		, bHasExecInput(false)
+		, bExecInputLinked(false)
+		, bHasOtherExecInputs(false)
+		, bHasExecOutput(false)
+		, bExecOutputLinked(false)
+		, bSeveralExecOutputsLinked(false)
+		, bIsGhostNode(false)
+		, bIsThreadSafe(false)
+		, bIsFlowControl(false)
+		, bIsLocalVariable(false)
+	{
+	}
+
+	// Source node, used for reporting only.
+	UEdGraphNode* Node = nullptr;
+
+	FGuid NodeGuid;
+
+	// Target function for call nodes, event/function name for events and entries, variable name for
+	// variable nodes and the macro graph name for macro instances.
+	FName MemberName;
+
+	// Resolved target function of call nodes (identity only, may be null).
+	const UFunction* Function = nullptr;
+
+	// Class declaring Function, see FCommonValidatorsCallGraph::GetFunctionOwnerName.
+	FName FunctionOwnerName;
+
+	// Estimated bytes copied by value every time the node runs (every iteration for loops), see CopyKinds.
+	int32 CopyBytes = 0;
+	ECommonValidatorsCopyKind CopyKinds = ECommonValidatorsCopyKind::None;
+
+	// Estimated payload of an RPC call, or size of the replicated variable a set node writes, see NetKind.
+	int32 NetBytes = 0;
+	ECommonValidatorsNetKind NetKind = ECommonValidatorsNetKind::None;
+
+	// Hash of the node class, target and literals of the unlinked inputs, for pure nodes other than knots.
+	uint64 PureSignature = 0;
+
+	ECommonValidatorsNodeKind Kind = ECommonValidatorsNodeKind::Other;
+
+	uint8 bIsPure : 1;
+	// Pure call to a function allowlisted in UCommonValidatorsDeveloperSettings.
+	uint8 bIsHarmlessPure : 1;
+	uint8 bHasExecInput : 1;
+	uint8 bExecInputLinked : 1;
+	// Exec inputs other than PN_Execute, e.g. Play and Stop on a timeline or Open on a gate.
+	uint8 bHasOtherExecInputs : 1;
+	uint8 bHasExecOutput : 1;
+	uint8 bExecOutputLinked : 1;
+	// More than one exec output pin is linked, e.g. both branches of a Branch node.
+	uint8 bSeveralExecOutputsLinked : 1;
+	uint8 bIsGhostNode : 1;
+	// Call to a function marked BlueprintThreadSafe, or entry of a Blueprint function marked Thread Safe.
+	uint8 bIsThreadSafe : 1;
+	// Only routes execution without touching any state: branches, sequences, switches, gates and the standard macros.
+	uint8 bIsFlowControl : 1;
+	// Get or set of a function local variable.
+	uint8 bIsLocalVariable : 1;
+};
+
+// Linked data input of a pure node.
+struct FCommonValidatorsPureInput
+{
+	// Node the value comes from, reroute knots skipped. INDEX_NONE if it isn't part of the graph.
+	int32 Producer = INDEX_NONE;
+
+	// Hash of the input pin name and of the producer's output pin name.
+	uint32 PinHash = 0;
+};
+
+// Instance of one of the engine's standard loop macros (ForLoop, ForEachLoop, WhileLoop and their variants).
+struct FCommonValidatorsIndexedLoop
+{
+	int32 NodeIndex = INDEX_NONE;
+
+	// Input the macro reads again on every iteration: Array, LastIndex or Condition.
+	FName PerIterationPinName;
+
+	// Nodes linked to the loop body exec output.
+	TArray<int32> BodyTargets;
+
+	// Every node the loop body executes, BodyTargets first. Nested loops and their bodies are included.
+	TArray<int32> BodyNodes;
+
+	// Nodes linked to PerIterationPinName.
+	TArray<int32> PerIterationProducers;
+};
+
+// Input of an anim graph node linked to Blueprint logic the fast path can't copy by itself.
+struct FCommonValidatorsAnimBinding
+{
+	int32 NodeIndex = INDEX_NONE;
+	FName PinName;
+
+	// First node of the logic, reroute knots skipped. INDEX_NONE if it isn't part of the graph.
+	int32 Producer = INDEX_NONE;
+};
+
+/**
+ * Flattened view of a single graph. Nodes are addressed by index and adjacency is stored CSR-style:
+ * the successors of node N are Targets[Offsets[N] .. Offsets[N + 1]).
+ */
+struct FCommonValidatorsIndexedGraph
+{
+	UEdGraph* Graph = nullptr;
+	FName GraphName;
+	ECommonValidatorsGraphKind Kind = ECommonValidatorsGraphKind::Ubergraph;
+
+	TArray<FCommonValidatorsIndexedNode> Nodes;
+	int32 NumPins = 0;
+
+	// Nodes reached through exec output pins.
+	TArray<int32> ExecOffsets;
+	TArray<int32> ExecTargets;
+
+	// Nodes reading one of the node's data outputs (sub pins included).
+	TArray<int32> DataOffsets;
+	TArray<int32> DataTargets;
+
+	// Linked data inputs of pure nodes, in pin order. Empty for the other nodes.
+	TArray<int32> PureInputOffsets;
+	TArray<FCommonValidatorsPureInput> PureInputs;
+
+	// Nodes without an exec input: events, function entries and pure nodes.
+	TArray<int32> EntryNodes;
+
+	// Nodes reachable via exec pins from EntryNodes.
+	TBitArray<> ExecReachable;
+
+	// Standard loop macro instances, which execute their body and re-read some inputs once per iteration.
+	TArray<FCommonValidatorsIndexedLoop> Loops;
+
+	// Impure node and the node linked to one of its non-const by-ref inputs, e.g. the array an Array Remove changes.
+	TArray<TPair<int32, int32>> ByRefWrites;
+
+	// What the Blueprint functions and macros called by call and macro nodes do further down.
+	TMap<int32, TSharedRef<const FCommonValidatorsCallSummary>> CallSummaries;
+
+	// Node and index in UCommonValidatorsDeveloperSettings::NodeRules of every rule a node matches, by node.
+	TArray<TPair<int32, int32>> RuleMatches;
+
+	// Anim graph node inputs evaluated by the Blueprint VM on every update, see FCommonValidatorsAnimBinding.
+	TArray<FCommonValidatorsAnimBinding> SlowPathBindings;
+
+	TArrayView<const int32> GetExecSuccessors(int32 NodeIndex) const
+	{
+		return MakeArrayView(ExecTargets.GetData() + ExecOffsets[NodeIndex], ExecOffsets[NodeIndex + 1] - ExecOffsets[NodeIndex]);
+	}
+
+	TArrayView<const int32> GetDataConsumers(int32 NodeIndex) const
+	{
+		return MakeArrayView(DataTargets.GetData() + DataOffsets[NodeIndex], DataOffsets[NodeIndex + 1] - DataOffsets[NodeIndex]);
+	}
+
+	TArrayView<const FCommonValidatorsPureInput> GetPureInputs(int32 NodeIndex) const
+	{
+		return MakeArrayView(PureInputs.GetData() + PureInputOffsets[NodeIndex], PureInputOffsets[NodeIndex + 1] - PureInputOffsets[NodeIndex]);
+	}
+
+	// Inverts the data links, so the nodes feeding node N are OutProducers[OutOffsets[N] .. OutOffsets[N + 1]).
+	void BuildDataProducers(TArray<int32>& OutOffsets, TArray<int32>& OutProducers) const;
+
+	// Inverts the exec links, so the nodes running right before node N are OutPredecessors[OutOffsets[N] .. OutOffsets[N + 1]).
+	void BuildExecPredecessors(TArray<int32>& OutOffsets, TArray<int32>& OutPredecessors) const;
+
+	// Chain of graphs from the call or macro node down to a blocking load, null if it never blocks.
+	const TArray<FName>* FindBlockingChain(int32 NodeIndex) const;
+
+	int32 FindNodeIndex(const UEdGraphNode* Node) const;
+
+	SIZE_T GetAllocatedSize() const;
+};
+
+/**
+ * Dominator tree of a graph's exec flow: node A dominates node B when every exec path from an entry to B goes
+ * through A. Entries hang off a virtual root, so nodes of different events only share that root.
+ */
+struct COMMONVALIDATORS_API FCommonValidatorsExecDominators
+{
+	// Immediate dominator of each node, INDEX_NONE for entries and nodes no entry reaches.
+	TArray<int32> ImmediateDominators;
+
+	// Position of each node in the post-order walk from the root, INDEX_NONE for unreachable nodes.
+	TArray<int32> PostOrder;
+
+	void Build(const FCommonValidatorsIndexedGraph& Graph);
+
+	bool IsReachable(int32 NodeIndex) const { return PostOrder[NodeIndex] != INDEX_NONE; }
+
+	// Whether A dominates B. A node dominates itself.
+	bool Dominates(int32 A, int32 B) const;
+
+	// Closest node dominating both, INDEX_NONE when only the virtual root does or either one is unreachable.
+	int32 FindCommonDominator(int32 A, int32 B) const;
+};
+
+// Tick settings of a Blueprint's class defaults or of one of the component templates it adds.
+struct FCommonValidatorsTickConfig
+{
+	FCommonValidatorsTickConfig()
+		: bIsComponent(false)
+		, bCanEverTick(false)
+		, bStartWithTickEnabled(false)
+		, bNativeCanEverTick(false)
+		, bHasBlueprintTick(false)
+	{
+	}
+
+	// Component variable name, NAME_None for the class defaults.
+	FName ComponentName;
+
+	// Class of the actor or component.
+	FName ClassName;
+
+	float TickInterval = 0.0f;
+	uint8 TickGroup = 0;
+
+	uint8 bIsComponent : 1;
+	uint8 bCanEverTick : 1;
+	uint8 bStartWithTickEnabled : 1;
+
+	// Whether the first native class of ClassName can tick by itself, i.e. its C++ constructor enabled ticking.
+	uint8 bNativeCanEverTick : 1;
+
+	// Whether a Blueprint of the class or one of its Blueprint parents implements ReceiveTick with anything linked.
+	uint8 bHasBlueprintTick : 1;
+};
+
+// Member variable a Blueprint declares as replicated.
+struct FCommonValidatorsReplicatedVariable
+{
+	FCommonValidatorsReplicatedVariable()
+		: bHasRepNotify(false)
+		, bIsContainer(false)
+	{
+	}
+
+	FName Name;
+
+	// Estimated bytes sent when it replicates, containers are assumed to hold a few elements.
+	int32 Bytes = 0;
+
+	// ELifetimeCondition, COND_None when it replicates to everyone.
+	uint8 Condition = 0;
+
+	uint8 bHasRepNotify : 1;
+	uint8 bIsContainer : 1;
+};
+
+// Addresses a single node of a FCommonValidatorsBlueprintIndex.
+struct FCommonValidatorsNodeRef
+{
+	int32 GraphIndex = INDEX_NONE;
+	int32 NodeIndex = INDEX_NONE;
+};
+
+// Flattened view of every graph of a Blueprint, shared by all validators.
+struct FCommonValidatorsBlueprintIndex
+{
+	FCommonValidatorsBlueprintIndex()
+		: bReplicates(true)
+		, bIsAnimBlueprint(false)
+		, bMultiThreadedAnimationUpdate(false)
+	{
+	}
+
+	TArray<FCommonValidatorsIndexedGraph> Graphs;
+
+	int32 NumNodes = 0;
+	int32 NumPins = 0;
+
+	// Stable hash of everything the validators look at, identical across processes and machines.
+	uint64 ContentHash = 0;
+
+	FName PackageName;
+
+	// Parent class chain, from the direct parent up. Generated class names for Blueprint parents.
+	TArray<FName> ParentClassNames;
+
+	// Class defaults first, then the component templates added by the Blueprint. Empty for other than actors and components.
+	TArray<FCommonValidatorsTickConfig> TickConfigs;
+
+	TArray<FCommonValidatorsReplicatedVariable> ReplicatedVariables;
+
+	// Of the class defaults of actors, 0 for other classes.
+	float NetUpdateFrequency = 0.0f;
+
+	// Whether the class defaults replicate, always true for other than actors and components.
+	uint8 bReplicates : 1;
+	uint8 bIsAnimBlueprint : 1;
+	// Use Multi Threaded Animation Update of an Anim Blueprint's class settings.
+	uint8 bMultiThreadedAnimationUpdate : 1;
+
+	// Other Blueprints whose graphs were followed by the call analysis. The index is stale once any of them changes.
+	TArray<TObjectKey<UBlueprint>> Dependencies;
+
+	// How many of the Dependencies are parent or component Blueprints the tick configs were read from.
+	int32 NumTickDependencies = 0;
+
+	const FCommonValidatorsIndexedNode& GetNode(const FCommonValidatorsNodeRef& Ref) const
+	{
+		return Graphs[Ref.GraphIndex].Nodes[Ref.NodeIndex];
+	}
+
+	SIZE_T GetAllocatedSize() const;
+
+	// Graphs nested in the function graphs of an Anim Blueprint (state machines, states, transition rules), indexed after the others.
+	static void CollectSubGraphs(const UBlueprint* Blueprint, TArray<UEdGraph*>& OutGraphs);
+
+	static TSharedRef<FCommonValidatorsBlueprintIndex> Build(const UBlueprint* Blueprint);
+
+	/**
+	 * Builds the index again for the given graphs only, copying every other graph from Previous. Falls back to a full
+	 * build when graphs were added or removed, or an edited graph is a function other graphs may call.
+	 */
+	static TSharedRef<FCommonValidatorsBlueprintIndex> Rebuild(const UBlueprint* Blueprint, const FCommonValidatorsBlueprintIndex& Previous, const TSet<const UEdGraph*>& ChangedGraphs);
+};
+
+/**
+ * Game thread cache of Blueprint indices. An index is built the first time any validator asks for it
+ * and dropped again as soon as the Blueprint or one of its graphs changes.
+ * Indices reference no UObject besides the Node/Graph pointers kept for reporting, so once built they
+ * can be analyzed from any thread.
+ */
+class COMMONVALIDATORS_API FCommonValidatorsGraphIndexCache
+{
+public:
+	static FCommonValidatorsGraphIndexCache& Get();
+
+	void Initialize();
+	void Shutdown();
+
+	TSharedRef<const FCommonValidatorsBlueprintIndex> FindOrBuild(UBlueprint* Blueprint);
+
+	// Index currently cached for the Blueprint, null if none was built since it last changed. Never builds.
+	TSharedPtr<const FCommonValidatorsBlueprintIndex> Find(const UBlueprint* Blueprint) const;
+
+	void Invalidate(const UBlueprint* Blueprint);
+	void Reset();
+
+private:
+	struct FEntry
+	{
+		TSharedPtr<const FCommonValidatorsBlueprintIndex> Index;
+		TWeakObjectPtr<UBlueprint> Blueprint;
+		uint32 AllowlistGeneration = 0;
+		uint32 NodeRulesGeneration = 0;
+		TArray<TPair<TWeakObjectPtr<UEdGraph>, FDelegateHandle>> GraphHandles;
+		FDelegateHandle ChangedHandle;
+		FDelegateHandle CompiledHandle;
+	};
+
+	void RemoveEntry(const TObjectKey<UBlueprint>& Key);
+	void InvalidateOwningBlueprint(const UObject* Object);
+
+	void OnObjectModified(UObject* Object);
+	void OnObjectPropertyChanged(UObject* Object, struct FPropertyChangedEvent& PropertyChangedEvent);
+	void OnObjectTransacted(UObject* Object, const class FTransactionObjectEvent& TransactionEvent);
+	void OnPostGarbageCollect();
+
+	TMap<TObjectKey<UBlueprint>, FEntry> Entries;
+
+	FDelegateHandle ObjectModifiedHandle;
+	FDelegateHandle ObjectPropertyChangedHandle;
+	FDelegateHandle ObjectTransactedHandle;
+	FDelegateHandle PostGarbageCollectHandle;
+};
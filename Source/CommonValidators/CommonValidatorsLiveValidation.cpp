@@ -0,0 +1,457 @@
+#include "CommonValidatorsLiveValidation.h"
+
+#include "Async/Async.h"
+#include "CommonValidatorsDeveloperSettings.h"
+#include "CommonValidatorsGraphIndex.h"
+#include "CommonValidatorsMessageReport.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "Editor.h"
+#include "EditorValidator_BlueprintBase.h"
+#include "Engine/Blueprint.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CoreDelegates.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Subsystems/AssetEditorSubsystem.h"
+#include "UObject/GarbageCollection.h"
+
+FCommonValidatorsLiveValidation& FCommonValidatorsLiveValidation::Get()
+{
+	static FCommonValidatorsLiveValidation Instance;
+	return Instance;
+}
+
+void FCommonValidatorsLiveValidation::Initialize()
+{
+	if (!GIsEditor || IsRunningCommandlet())
+	{
+		return;
+	}
+
+	// The asset editor subsystem only exists once the editor engine is up.
+	if (GEditor)
+	{
+		OnPostEngineInit();
+	}
+	else
+	{
+		PostEngineInitHandle = FCoreDelegates::OnPostEngineInit.AddRaw(this, &FCommonValidatorsLiveValidation::OnPostEngineInit);
+	}
+
+	ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddRaw(this, &FCommonValidatorsLiveValidation::OnObjectModified);
+	TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FCommonValidatorsLiveValidation::Tick));
+}
+
+void FCommonValidatorsLiveValidation::Shutdown()
+{
+	FCoreDelegates::OnPostEngineInit.Remove(PostEngineInitHandle);
+	FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+	FCoreUObjectDelegates::OnObjectModified.Remove(ObjectModifiedHandle);
+	if (UAssetEditorSubsystem* AssetEditorSubsystem = GEditor ? GEditor->GetEditorSubsystem<UAssetEditorSubsystem>() : nullptr)
+	{
+		AssetEditorSubsystem->OnAssetOpenedInEditor().Remove(AssetOpenedHandle);
+		AssetEditorSubsystem->OnAssetClosedInEditor().Remove(AssetClosedHandle);
+	}
+
+	TArray<TObjectKey<UBlueprint>> Keys;
+	Watched.GetKeys(Keys);
+	for (const TObjectKey<UBlueprint>& Key : Keys)
+	{
+		Unwatch(Key, false);
+	}
+}
+
+void FCommonValidatorsLiveValidation::Watch(UBlueprint* Blueprint)
+{
+	const TObjectKey<UBlueprint> Key(Blueprint);
+	if (Watched.Contains(Key))
+	{
+		return;
+	}
+
+	FWatchedBlueprint& Entry = Watched.Add(Key);
+	Entry.Blueprint = Blueprint;
+	Entry.LastEditTime = FPlatformTime::Seconds();
+
+	// Graphs added or removed, compiles and structural changes: start over from a full index.
+	Entry.ChangedHandle = Blueprint->OnChanged().AddLambda([this, Key](UBlueprint*)
+	{
+		if (FWatchedBlueprint* Found = Watched.Find(Key))
+		{
+			WatchGraphs(*Found);
+			MarkDirty(*Found, nullptr);
+		}
+	});
+	WatchGraphs(Entry);
+}
+
+void FCommonValidatorsLiveValidation::Unwatch(const TObjectKey<UBlueprint>& Key, bool bClearOverlays)
+{
+	FWatchedBlueprint Entry;
+	if (!Watched.RemoveAndCopyValue(Key, Entry))
+	{
+		return;
+	}
+
+	if (Entry.Job.IsValid())
+	{
+		Entry.Job->bCancelled = true;
+	}
+
+	for (const TPair<TWeakObjectPtr<UEdGraph>, FDelegateHandle>& GraphHandle : Entry.GraphHandles)
+	{
+		GraphOwners.Remove(GraphHandle.Key.Get());
+		if (UEdGraph* Graph = GraphHandle.Key.Get())
+		{
+			Graph->RemoveOnGraphChangedHandler(GraphHandle.Value);
+		}
+	}
+
+	if (UBlueprint* Blueprint = Entry.Blueprint.Get())
+	{
+		Blueprint->OnChanged().Remove(Entry.ChangedHandle);
+	}
+
+	if (bClearOverlays)
+	{
+		Entry.Findings.Reset();
+		ApplyOverlays(Entry);
+	}
+}
+
+void FCommonValidatorsLiveValidation::WatchGraphs(FWatchedBlueprint& Entry)
+{
+	UBlueprint* Blueprint = Entry.Blueprint.Get();
+	if (!Blueprint)
+	{
+		return;
+	}
+
+	for (const TPair<TWeakObjectPtr<UEdGraph>, FDelegateHandle>& GraphHandle : Entry.GraphHandles)
+	{
+		GraphOwners.Remove(GraphHandle.Key.Get());
+		if (UEdGraph* Graph = GraphHandle.Key.Get())
+		{
+			Graph->RemoveOnGraphChangedHandler(GraphHandle.Value);
+		}
+	}
+	Entry.GraphHandles.Reset();
+
+	const TObjectKey<UBlueprint> Key(Blueprint);
+	auto WatchGraph = [this, &Entry, Key](UEdGraph* Graph)
+	{
+		if (!Graph)
+		{
+			return;
+		}
+
+		GraphOwners.Add(Graph, Key);
+		const FDelegateHandle Handle = Graph->AddOnGraphChangedHandler(FOnGraphChanged::FDelegate::CreateLambda(
+			[this, Key, Graph](const FEdGraphEditAction& Action)
+			{
+				// Same filter as the index cache: our own overlays refresh nodes without changing the structure.
+				if ((Action.Action & (GRAPHACTION_AddNode | GRAPHACTION_RemoveNode)) != 0 || Action.Action == GRAPHACTION_Default)
+				{
+					if (FWatchedBlueprint* Found = Watched.Find(Key))
+					{
+						MarkDirty(*Found, Graph);
+					}
+				}
+			}));
+		Entry.GraphHandles.Emplace(Graph, Handle);
+	};
+
+	for (UEdGraph* Graph : Blueprint->FunctionGraphs)
+	{
+		WatchGraph(Graph);
+	}
+	for (UEdGraph* Graph : Blueprint->UbergraphPages)
+	{
+		WatchGraph(Graph);
+	}
+
+	TArray<UEdGraph*> SubGraphs;
+	FCommonValidatorsBlueprintIndex::CollectSubGraphs(Blueprint, SubGraphs);
+	for (UEdGraph* Graph : SubGraphs)
+	{
+		WatchGraph(Graph);
+	}
+}
+
+void FCommonValidatorsLiveValidation::MarkDirty(FWatchedBlueprint& Entry, const UEdGraph* Graph)
+{
+	// Runs on every edit, so it only records what changed.
+	if (Graph)
+	{
+		Entry.DirtyGraphs.Add(Graph);
+	}
+	else
+	{
+		Entry.bFullyDirty = true;
+	}
+	Entry.LastEditTime = FPlatformTime::Seconds();
+
+	// A running analysis is about to be out of date, its graphs go back to the dirty ones.
+	if (Entry.Job.IsValid())
+	{
+		Entry.Job->bCancelled = true;
+		Entry.Job.Reset();
+		Entry.DirtyGraphs.Append(Entry.JobGraphs);
+		Entry.bFullyDirty |= Entry.bJobFull;
+		Entry.JobGraphs.Reset();
+	}
+}
+
+bool FCommonValidatorsLiveValidation::Tick(float DeltaTime)
+{
+	const UCommonValidatorsDeveloperSettings* Settings = GetDefault<UCommonValidatorsDeveloperSettings>();
+	if (!Settings->bEnableLiveValidation || Watched.IsEmpty())
+	{
+		return true;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	for (TPair<TObjectKey<UBlueprint>, FWatchedBlueprint>& Pair : Watched)
+	{
+		FWatchedBlueprint& Entry = Pair.Value;
+		const bool bDirty = Entry.bFullyDirty || Entry.DirtyGraphs.Num() > 0;
+		if (bDirty && !Entry.Job.IsValid() && Now - Entry.LastEditTime >= Settings->LiveValidationDelay && Entry.Blueprint.IsValid())
+		{
+			Launch(Entry);
+		}
+	}
+	return true;
+}
+
+void FCommonValidatorsLiveValidation::Launch(FWatchedBlueprint& Entry)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FCommonValidatorsLiveValidation::Launch);
+
+	UBlueprint* Blueprint = Entry.Blueprint.Get();
+	const bool bFull = Entry.bFullyDirty || !Entry.Index.IsValid();
+
+	// Indexing reads the graphs, so it stays on the game thread. Only the edited graphs are indexed again.
+	const TSharedRef<const FCommonValidatorsBlueprintIndex> Index = bFull
+		? FCommonValidatorsBlueprintIndex::Build(Blueprint)
+		: FCommonValidatorsBlueprintIndex::Rebuild(Blueprint, *Entry.Index, Entry.DirtyGraphs);
+
+	// What graph-local validators have to look at: the edited graphs.
+	TSharedPtr<FCommonValidatorsBlueprintIndex> DirtyIndex;
+	TSet<FName> DirtyGraphNames;
+	if (!bFull)
+	{
+		DirtyIndex = MakeShared<FCommonValidatorsBlueprintIndex>();
+		DirtyIndex->PackageName = Index->PackageName;
+		DirtyIndex->ParentClassNames = Index->ParentClassNames;
+		for (const FCommonValidatorsIndexedGraph& Graph : Index->Graphs)
+		{
+			if (Entry.DirtyGraphs.Contains(Graph.Graph))
+			{
+				DirtyIndex->Graphs.Add(Graph);
+				DirtyIndex->NumNodes += Graph.Nodes.Num();
+				DirtyIndex->NumPins += Graph.NumPins;
+				DirtyGraphNames.Add(Graph.GraphName);
+			}
+		}
+	}
+
+	TSharedRef<FJob> Job = MakeShared<FJob>();
+	Entry.Job = Job;
+	Entry.JobGraphs = MoveTemp(Entry.DirtyGraphs);
+	Entry.bJobFull = bFull;
+	Entry.DirtyGraphs.Reset();
+	Entry.bFullyDirty = false;
+
+	const TObjectKey<UBlueprint> Key(Blueprint);
+	TArray<TWeakObjectPtr<const UEditorValidator_BlueprintBase>> Validators;
+	for (const UEditorValidator_BlueprintBase* Validator : UEditorValidator_BlueprintBase::GetEnabledValidators())
+	{
+		Validators.Add(Validator);
+	}
+	FString AssetPath = Blueprint->GetPathName();
+	TMap<FName, TArray<FCommonValidatorsFinding>> PreviousFindings = Entry.Findings;
+
+	Job->Task = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+		[this, Key, Job, Index, DirtyIndex, DirtyGraphNames = MoveTemp(DirtyGraphNames), Validators = MoveTemp(Validators), AssetPath = MoveTemp(AssetPath), PreviousFindings = MoveTemp(PreviousFindings)]() mutable
+		{
+			TRACE_CPUPROFILER_EVENT_SCOPE(FCommonValidatorsLiveValidation::Analyze);
+
+			TMap<FName, TArray<FCommonValidatorsFinding>> Findings;
+			for (const TWeakObjectPtr<const UEditorValidator_BlueprintBase>& WeakValidator : Validators)
+			{
+				if (Job->bCancelled)
+				{
+					return;
+				}
+
+				// Validators are instances the editor validator subsystem can drop, see FCommonValidatorsAsyncValidation::Launch.
+				FGCScopeGuard GCGuard;
+				const UEditorValidator_BlueprintBase* Validator = WeakValidator.Get();
+				if (!Validator)
+				{
+					continue;
+				}
+
+				const FName ValidatorName = Validator->GetClass()->GetFName();
+				TArray<FCommonValidatorsFinding>& ValidatorFindings = Findings.Add(ValidatorName);
+
+				// Intermediate states of a graph being edited aren't worth a cache entry.
+				const TArray<FCommonValidatorsFinding>* Previous = PreviousFindings.Find(ValidatorName);
+				if (DirtyIndex.IsValid() && Validator->IsGraphLocal() && Previous)
+				{
+					for (const FCommonValidatorsFinding& Finding : *Previous)
+					{
+						if (!DirtyGraphNames.Contains(Finding.GraphName))
+						{
+							ValidatorFindings.Add(Finding);
+						}
+					}
+					Validator->AnalyzeWithCache(AssetPath, *DirtyIndex, false, ValidatorFindings);
+				}
+				else
+				{
+					Validator->AnalyzeWithCache(AssetPath, *Index, false, ValidatorFindings);
+				}
+			}
+
+			AsyncTask(ENamedThreads::GameThread, [this, Key, Job, Index, Findings = MoveTemp(Findings)]() mutable
+			{
+				OnJobFinished(Key, Job, Index, MoveTemp(Findings));
+			});
+		}, UE::Tasks::ETaskPriority::BackgroundNormal);
+}
+
+void FCommonValidatorsLiveValidation::OnJobFinished(const TObjectKey<UBlueprint>& Key, const TSharedRef<FJob>& Job, TSharedRef<const FCommonValidatorsBlueprintIndex> Index, TMap<FName, TArray<FCommonValidatorsFinding>> Findings)
+{
+	FWatchedBlueprint* Entry = Watched.Find(Key);
+	if (Job->bCancelled || !Entry || Entry->Job != Job)
+	{
+		return;
+	}
+
+	Entry->Job.Reset();
+	Entry->JobGraphs.Reset();
+	Entry->Index = Index;
+	Entry->Findings = MoveTemp(Findings);
+	ApplyOverlays(*Entry);
+}
+
+void FCommonValidatorsLiveValidation::ApplyOverlays(FWatchedBlueprint& Entry)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FCommonValidatorsLiveValidation::ApplyOverlays);
+
+	// Every finding of a node in one overlay, with the most severe of their severities.
+	TMap<UEdGraphNode*, TPair<FString, EMessageSeverity::Type>> NodeMessages;
+	if (Entry.Index.IsValid())
+	{
+		for (const TPair<FName, TArray<FCommonValidatorsFinding>>& Pair : Entry.Findings)
+		{
+			for (const FCommonValidatorsFinding& Finding : Pair.Value)
+			{
+				UEdGraphNode* Node = UEditorValidator_BlueprintBase::FindNode(*Entry.Index, Finding);
+				if (!Node)
+				{
+					continue;
+				}
+
+				const FString Message = UEditorValidator_BlueprintBase::FormatMessage(Finding, Node).ToString();
+				TPair<FString, EMessageSeverity::Type>* Existing = NodeMessages.Find(Node);
+				if (!Existing)
+				{
+					NodeMessages.Add(Node, { Message, Finding.Severity.GetValue() });
+				}
+				else
+				{
+					Existing->Key += TEXT("\n") + Message;
+					Existing->Value = FMath::Min(Existing->Value, Finding.Severity.GetValue());
+				}
+			}
+		}
+	}
+
+	FCommonValidatorsNodeChangeBatch ChangedNodes;
+
+	// Clear the overlays that went away, unless the compiler replaced them with its own message since.
+	for (auto It = Entry.Overlays.CreateIterator(); It; ++It)
+	{
+		UEdGraphNode* Node = It.Key().Get();
+		if (!Node || NodeMessages.Contains(Node))
+		{
+			continue;
+		}
+
+		if (Node->bHasCompilerMessage && Node->ErrorMsg == It.Value())
+		{
+			Node->bHasCompilerMessage = false;
+			Node->ErrorMsg.Reset();
+			ChangedNodes.Add(Node);
+		}
+		It.RemoveCurrent();
+	}
+
+	for (const TPair<UEdGraphNode*, TPair<FString, EMessageSeverity::Type>>& Pair : NodeMessages)
+	{
+		UEdGraphNode* Node = Pair.Key;
+		if (Node->bHasCompilerMessage && Node->ErrorMsg == Pair.Value.Key && Node->ErrorType == Pair.Value.Value)
+		{
+			continue;
+		}
+
+		// Compiler errors win, they block the Blueprint from running.
+		if (Node->bHasCompilerMessage && Node->ErrorType == EMessageSeverity::Error && !Entry.Overlays.Contains(Node))
+		{
+			continue;
+		}
+
+		Node->ErrorMsg = Pair.Value.Key;
+		Node->ErrorType = Pair.Value.Value;
+		Node->bHasCompilerMessage = true;
+		ChangedNodes.Add(Node);
+		Entry.Overlays.Add(Node, Pair.Value.Key);
+	}
+}
+
+void FCommonValidatorsLiveValidation::OnPostEngineInit()
+{
+	if (UAssetEditorSubsystem* AssetEditorSubsystem = GEditor ? GEditor->GetEditorSubsystem<UAssetEditorSubsystem>() : nullptr)
+	{
+		AssetOpenedHandle = AssetEditorSubsystem->OnAssetOpenedInEditor().AddRaw(this, &FCommonValidatorsLiveValidation::OnAssetOpened);
+		AssetClosedHandle = AssetEditorSubsystem->OnAssetClosedInEditor().AddRaw(this, &FCommonValidatorsLiveValidation::OnAssetClosed);
+	}
+}
+
+void FCommonValidatorsLiveValidation::OnAssetOpened(UObject* Asset, IAssetEditorInstance* EditorInstance)
+{
+	if (UBlueprint* Blueprint = Cast<UBlueprint>(Asset))
+	{
+		Watch(Blueprint);
+	}
+}
+
+void FCommonValidatorsLiveValidation::OnAssetClosed(UObject* Asset, IAssetEditorInstance* EditorInstance)
+{
+	if (UBlueprint* Blueprint = Cast<UBlueprint>(Asset))
+	{
+		Unwatch(TObjectKey<UBlueprint>(Blueprint), true);
+	}
+}
+
+void FCommonValidatorsLiveValidation::OnObjectModified(UObject* Object)
+{
+	// Pin links and defaults change through Modify() on the node, without a graph notification.
+	// Called for every object modified in the editor, so only a couple of lookups.
+	if (GraphOwners.IsEmpty())
+	{
+		return;
+	}
+
+	const UEdGraphNode* Node = Cast<UEdGraphNode>(Object);
+	const UEdGraph* Graph = Node ? Node->GetGraph() : Cast<UEdGraph>(Object);
+	if (const TObjectKey<UBlueprint>* Key = Graph ? GraphOwners.Find(Graph) : nullptr)
+	{
+		if (FWatchedBlueprint* Entry = Watched.Find(*Key))
+		{
+			MarkDirty(*Entry, Graph);
+		}
+	}
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CommonValidatorsFinding.h"
+#include "Containers/Ticker.h"
+#include "Tasks/Task.h"
+#include "UObject/ObjectKey.h"
+
+#include <atomic>
+
+struct FCommonValidatorsBlueprintIndex;
+struct FEdGraphEditAction;
+class IAssetEditorInstance;
+class UBlueprint;
+class UEdGraph;
+class UEdGraphNode;
+
+/**
+ * Keeps findings up to date on the nodes of Blueprints open in an editor, as compiler-style node overlays.
+ * Edits only mark their graph dirty. Once the Blueprint has been left alone for LiveValidationDelay, the dirty
+ * graphs are indexed again, the others reused from the previous index, and analyzed in the background: validators
+ * whose findings are local to a graph only look at the dirty graphs and keep their findings in the other ones.
+ */
+class COMMONVALIDATORS_API FCommonValidatorsLiveValidation
+{
+public:
+	static FCommonValidatorsLiveValidation& Get();
+
+	void Initialize();
+	void Shutdown();
+
+private:
+	struct FJob
+	{
+		std::atomic<bool> bCancelled = false;
+		UE::Tasks::FTask Task;
+	};
+
+	struct FWatchedBlueprint
+	{
+		TWeakObjectPtr<UBlueprint> Blueprint;
+
+		// Index and findings per validator as of the last finished analysis.
+		TSharedPtr<const FCommonValidatorsBlueprintIndex> Index;
+		TMap<FName, TArray<FCommonValidatorsFinding>> Findings;
+
+		TSet<const UEdGraph*> DirtyGraphs;
+		bool bFullyDirty = true;
+		double LastEditTime = 0.0;
+
+		TSharedPtr<FJob> Job;
+		TSet<const UEdGraph*> JobGraphs;
+		bool bJobFull = false;
+
+		// Nodes showing one of our overlays, with the message we set, so compiler messages are left alone.
+		TMap<TWeakObjectPtr<UEdGraphNode>, FString> Overlays;
+
+		TArray<TPair<TWeakObjectPtr<UEdGraph>, FDelegateHandle>> GraphHandles;
+		FDelegateHandle ChangedHandle;
+	};
+
+	void Watch(UBlueprint* Blueprint);
+	void Unwatch(const TObjectKey<UBlueprint>& Key, bool bClearOverlays);
+	void WatchGraphs(FWatchedBlueprint& Watched);
+	void MarkDirty(FWatchedBlueprint& Watched, const UEdGraph* Graph);
+
+	bool Tick(float DeltaTime);
+	void Launch(FWatchedBlueprint& Watched);
+	void OnJobFinished(const TObjectKey<UBlueprint>& Key, const TSharedRef<FJob>& Job, TSharedRef<const FCommonValidatorsBlueprintIndex> Index, TMap<FName, TArray<FCommonValidatorsFinding>> Findings);
+	static void ApplyOverlays(FWatchedBlueprint& Watched);
+
+	void OnPostEngineInit();
+	void OnAssetOpened(UObject* Asset, IAssetEditorInstance* EditorInstance);
+	void OnAssetClosed(UObject* Asset, IAssetEditorInstance* EditorInstance);
+	void OnObjectModified(UObject* Object);
+
+	TMap<TObjectKey<UBlueprint>, FWatchedBlueprint> Watched;
+
+	// Graph of each watched Blueprint, to map modified nodes back to them quickly.
+	TMap<const UEdGraph*, TObjectKey<UBlueprint>> GraphOwners;
+
+	FTSTicker::FDelegateHandle TickHandle;
+	FDelegateHandle PostEngineInitHandle;
+	FDelegateHandle AssetOpenedHandle;
+	FDelegateHandle AssetClosedHandle;
+	FDelegateHandle ObjectModifiedHandle;
+};
@@ -0,0 +1,5 @@
+#pragma once
+
+#include "Logging/LogMacros.h"
+
+COMMONVALIDATORS_API DECLARE_LOG_CATEGORY_EXTERN(LogCommonValidators, Log, All);
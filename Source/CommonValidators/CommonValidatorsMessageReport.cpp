@@ -0,0 +1,91 @@
+#include "CommonValidatorsMessageReport.h"
+
+#include "CommonValidatorsLog.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "Misc/Paths.h"
+
+FCommonValidatorsMessageReport& FCommonValidatorsMessageReport::Get()
+{
+	static FCommonValidatorsMessageReport Instance;
+	return Instance;
+}
+
+void FCommonValidatorsMessageReport::Shutdown()
+{
+	ExportPipe.WaitUntilEmpty();
+	Writer.Close();
+	bWriterOpened = false;
+	ExportPath.Reset();
+}
+
+void FCommonValidatorsMessageReport::GroupFindings(const TArray<FCommonValidatorsFinding>& Findings, TArray<TArray<int32>>& OutGroups)
+{
+	// Messages name per-node details like counts and functions, so they are left out of the key.
+	TMap<TTuple<uint8, ECommonValidatorsFindingActions, FName>, int32> GroupsByRule;
+	for (int32 FindingIndex = 0; FindingIndex < Findings.Num(); ++FindingIndex)
+	{
+		const FCommonValidatorsFinding& Finding = Findings[FindingIndex];
+		int32& GroupIndex = GroupsByRule.FindOrAdd({ Finding.Severity.GetValue(), Finding.Actions, Finding.Rule }, INDEX_NONE);
+		if (GroupIndex == INDEX_NONE)
+		{
+			GroupIndex = OutGroups.AddDefaulted();
+		}
+		OutGroups[GroupIndex].Add(FindingIndex);
+	}
+}
+
+FString FCommonValidatorsMessageReport::Export(FCommonValidatorsResultRecord&& Record)
+{
+	check(IsInGameThread());
+
+	if (ExportPath.IsEmpty())
+	{
+		ExportPath = FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir() / TEXT("CommonValidators") / TEXT("Findings.jsonl"));
+	}
+
+	// Serializing and flushing stays off the save path, the pipe keeps records in order.
+	ExportPipe.Launch(UE_SOURCE_LOCATION, [this, Path = ExportPath, Record = MoveTemp(Record)]()
+	{
+		if (!bWriterOpened)
+		{
+			bWriterOpened = true;
+			if (!Writer.Open(Path))
+			{
+				return;
+			}
+			UE_LOG(LogCommonValidators, Log, TEXT("Writing every validation finding reported to the Message Log to %s."), *Path);
+		}
+
+		Writer.WriteRecord(Record);
+		Writer.Flush();
+	});
+	return ExportPath;
+}
+
+FCommonValidatorsNodeChangeBatch::~FCommonValidatorsNodeChangeBatch()
+{
+	Flush();
+}
+
+void FCommonValidatorsNodeChangeBatch::Add(UEdGraphNode* Node)
+{
+	if (UEdGraph* Graph = Node ? Node->GetGraph() : nullptr)
+	{
+		NodesByGraph.FindOrAdd(Graph).Add(Node);
+	}
+}
+
+void FCommonValidatorsNodeChangeBatch::Flush()
+{
+	for (const TPair<UEdGraph*, TSet<const UEdGraphNode*>>& Pair : NodesByGraph)
+	{
+		// What NotifyNodeChanged broadcasts, for every node at once.
+		FEdGraphEditAction Action;
+		Action.Action = GRAPHACTION_EditNode;
+		Action.Graph = Pair.Key;
+		Action.Nodes = Pair.Value;
+		Pair.Key->NotifyGraphChanged(Action);
+	}
+	NodesByGraph.Reset();
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CommonValidatorsFinding.h"
+#include "CommonValidatorsReport.h"
+#include "Tasks/Pipe.h"
+
+class UEdGraph;
+class UEdGraphNode;
+
+/**
+ * Keeps project-wide validation runs from flooding the Message Log. Findings of a validator on an asset are grouped by
+ * rule, severity and actions, and past UCommonValidatorsDeveloperSettings::MaxMessagesPerAsset groups the rest is summed
+ * up in a single entry. Every finding reported is also written to an export file, in the commandlet's JSON-lines format.
+ * Game thread only, the file is written on a background pipe.
+ */
+class COMMONVALIDATORS_API FCommonValidatorsMessageReport
+{
+public:
+	static FCommonValidatorsMessageReport& Get();
+
+	void Shutdown();
+
+	// Indices of the findings sharing a rule, severity and actions, groups ordered by their first finding.
+	static void GroupFindings(const TArray<FCommonValidatorsFinding>& Findings, TArray<TArray<int32>>& OutGroups);
+
+	/**
+	 * Queues a record for the export file, created on first use for this editor session, and returns the file's path.
+	 * Messages are written as the validators made them, "{Node}" placeholders and node GUIDs rather than node titles.
+	 */
+	FString Export(FCommonValidatorsResultRecord&& Record);
+
+private:
+	UE::Tasks::FPipe ExportPipe{ TEXT("CommonValidatorsMessageReport") };
+
+	// Only touched by tasks of ExportPipe.
+	FCommonValidatorsReportWriter Writer;
+	bool bWriterOpened = false;
+
+	FString ExportPath;
+};
+
+/**
+ * Refreshes nodes whose overlay changed with one notification per graph, rather than a NotifyNodeChanged per node
+ * which has the graph editor update once for each. Flushed when destroyed.
+ */
+class COMMONVALIDATORS_API FCommonValidatorsNodeChangeBatch
+{
+public:
+	~FCommonValidatorsNodeChangeBatch();
+
+	void Add(UEdGraphNode* Node);
+	void Flush();
+
+private:
+	TMap<UEdGraph*, TSet<const UEdGraphNode*>> NodesByGraph;
+};
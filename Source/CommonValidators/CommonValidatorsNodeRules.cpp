@@ -0,0 +1,279 @@
+#include "CommonValidatorsNodeRules.h"
+
+#include "CommonValidatorsDeveloperSettings.h"
+#include "CommonValidatorsGraphIndex.h"
+#include "EdGraph/EdGraphNode.h"
+#include "Misc/Crc.h"
+#include "Modules/ModuleManager.h"
+#include "UObject/Class.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace UE::Internal::NodeRulesHelpers
+{
+	// Native classes are never loaded on demand, they become resolvable once their module is loaded.
+	static const UClass* ResolveClass(const TSoftClassPtr<UEdGraphNode>& SoftClass)
+	{
+		if (SoftClass.ToSoftObjectPath().GetLongPackageName().StartsWith(TEXT("/Script/")))
+		{
+			return SoftClass.Get();
+		}
+		return SoftClass.LoadSynchronous();
+	}
+}
+
+FCommonValidatorsNodeRules& FCommonValidatorsNodeRules::Get()
+{
+	static FCommonValidatorsNodeRules Instance;
+	return Instance;
+}
+
+void FCommonValidatorsNodeRules::Initialize()
+{
+	SettingsChangedHandle = GetMutableDefault<UCommonValidatorsDeveloperSettings>()->OnSettingChanged().AddLambda(
+		[this](UObject*, FPropertyChangedEvent&)
+		{
+			MarkDirty();
+		});
+
+	// Node classes from modules loaded after us can only be resolved later.
+	ModulesChangedHandle = FModuleManager::Get().OnModulesChanged().AddRaw(this, &FCommonValidatorsNodeRules::OnModulesChanged);
+
+	// Decisions are keyed by function and class pointers, which don't survive a recompile.
+	PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FCommonValidatorsNodeRules::OnPostGarbageCollect);
+}
+
+void FCommonValidatorsNodeRules::Shutdown()
+{
+	if (UObjectInitialized())
+	{
+		GetMutableDefault<UCommonValidatorsDeveloperSettings>()->OnSettingChanged().Remove(SettingsChangedHandle);
+	}
+	FModuleManager::Get().OnModulesChanged().Remove(ModulesChangedHandle);
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+
+	Rules.Reset();
+	RulesByFunctionName.Reset();
+	RulesByOwnerName.Reset();
+	RulesByMetadataTag.Reset();
+	RulesByNodeClass.Reset();
+	MetadataDecisions.Reset();
+	NodeClassDecisions.Reset();
+	bDirty = true;
+}
+
+void FCommonValidatorsNodeRules::MarkDirty()
+{
+	bDirty = true;
+}
+
+void FCommonValidatorsNodeRules::OnModulesChanged(FName ModuleName, EModuleChangeReason Reason)
+{
+	if (Reason == EModuleChangeReason::ModuleLoaded && bHasUnresolvedEntries)
+	{
+		MarkDirty();
+	}
+}
+
+void FCommonValidatorsNodeRules::OnPostGarbageCollect()
+{
+	MarkDirty();
+}
+
+void FCommonValidatorsNodeRules::Refresh()
+{
+	check(IsInGameThread());
+
+	if (bDirty)
+	{
+		Rebuild();
+	}
+}
+
+uint32 FCommonValidatorsNodeRules::ComputeSettingsHash()
+{
+	const UCommonValidatorsDeveloperSettings* Settings = GetDefault<UCommonValidatorsDeveloperSettings>();
+
+	uint32 Hash = 0;
+	for (const FCommonValidatorsNodeRule& Rule : Settings->NodeRules)
+	{
+		Hash = FCrc::StrCrc32(*Rule.FunctionName.ToString(), Hash);
+		Hash = FCrc::StrCrc32(*Rule.OwnerClass.ToString(), Hash);
+		Hash = FCrc::StrCrc32(*Rule.NodeClass.ToString(), Hash);
+		Hash = FCrc::StrCrc32(*Rule.MetadataTag.ToString(), Hash);
+	}
+	return Hash;
+}
+
+void FCommonValidatorsNodeRules::Rebuild()
+{
+	using namespace UE::Internal::NodeRulesHelpers;
+
+	const UCommonValidatorsDeveloperSettings* Settings = GetDefault<UCommonValidatorsDeveloperSettings>();
+
+	TArray<const UClass*> OldNodeClasses;
+	for (const FCompiledRule& Rule : Rules)
+	{
+		OldNodeClasses.Add(Rule.NodeClass);
+	}
+
+	Rules.Reset();
+	RulesByFunctionName.Reset();
+	RulesByOwnerName.Reset();
+	RulesByMetadataTag.Reset();
+	RulesByNodeClass.Reset();
+	MetadataDecisions.Reset();
+	NodeClassDecisions.Reset();
+	bHasUnresolvedEntries = false;
+
+	for (int32 RuleIndex = 0; RuleIndex < Settings->NodeRules.Num(); ++RuleIndex)
+	{
+		const FCommonValidatorsNodeRule& Setting = Settings->NodeRules[RuleIndex];
+		FCompiledRule& Rule = Rules.AddDefaulted_GetRef();
+
+		// A node class that doesn't resolve can't match anything, and a rule without criteria would match everything.
+		if (!Setting.NodeClass.IsNull())
+		{
+			Rule.NodeClass = ResolveClass(Setting.NodeClass);
+			if (!Rule.NodeClass)
+			{
+				bHasUnresolvedEntries = true;
+				continue;
+			}
+		}
+
+		// Matched by name, the same way the index identifies functions.
+		Rule.FunctionName = Setting.FunctionName;
+		Rule.OwnerName = Setting.OwnerClass.IsNull() ? NAME_None : FName(Setting.OwnerClass.ToSoftObjectPath().GetAssetName());
+		Rule.MetadataTag = Setting.MetadataTag;
+
+		if (!Rule.FunctionName.IsNone())
+		{
+			RulesByFunctionName.FindOrAdd(Rule.FunctionName).Add(RuleIndex);
+		}
+		else if (!Rule.OwnerName.IsNone())
+		{
+			RulesByOwnerName.FindOrAdd(Rule.OwnerName).Add(RuleIndex);
+		}
+		else if (!Rule.MetadataTag.IsNone())
+		{
+			RulesByMetadataTag.FindOrAdd(Rule.MetadataTag).Add(RuleIndex);
+		}
+		else if (Rule.NodeClass)
+		{
+			RulesByNodeClass.FindOrAdd(Rule.NodeClass).Add(RuleIndex);
+		}
+	}
+
+	bDirty = false;
+
+	// Rebuilds after a GC usually resolve to the very same classes
+	const uint32 NewSettingsHash = ComputeSettingsHash();
+	TArray<const UClass*> NewNodeClasses;
+	for (const FCompiledRule& Rule : Rules)
+	{
+		NewNodeClasses.Add(Rule.NodeClass);
+	}
+
+	if (NewSettingsHash != SettingsHash || NewNodeClasses != OldNodeClasses)
+	{
+		SettingsHash = NewSettingsHash;
+		++Generation;
+	}
+}
+
+void FCommonValidatorsNodeRules::Match(const UEdGraphNode* Node, const FCommonValidatorsIndexedNode& Indexed, TArray<int32>& OutRules)
+{
+	check(IsInGameThread());
+
+	Refresh();
+
+	if (Rules.IsEmpty())
+	{
+		return;
+	}
+
+	auto AddMatches = [this, Node, &Indexed, &OutRules](const TArray<int32>* Candidates)
+	{
+		if (!Candidates)
+		{
+			return;
+		}
+
+		for (const int32 RuleIndex : *Candidates)
+		{
+			if (MatchesRule(Rules[RuleIndex], Node, Indexed))
+			{
+				OutRules.Add(RuleIndex);
+			}
+		}
+	};
+
+	if (Indexed.Kind == ECommonValidatorsNodeKind::CallFunction)
+	{
+		AddMatches(RulesByFunctionName.Find(Indexed.MemberName));
+		AddMatches(RulesByOwnerName.Find(Indexed.FunctionOwnerName));
+		if (Indexed.Function && RulesByMetadataTag.Num() > 0)
+		{
+			AddMatches(&FindMetadataRules(Indexed.Function));
+		}
+	}
+
+	if (RulesByNodeClass.Num() > 0)
+	{
+		AddMatches(&FindNodeClassRules(Node->GetClass()));
+	}
+}
+
+bool FCommonValidatorsNodeRules::MatchesRule(const FCompiledRule& Rule, const UEdGraphNode* Node, const FCommonValidatorsIndexedNode& Indexed) const
+{
+	const bool bIsCall = Indexed.Kind == ECommonValidatorsNodeKind::CallFunction;
+	if (!Rule.FunctionName.IsNone() && (!bIsCall || Rule.FunctionName != Indexed.MemberName))
+	{
+		return false;
+	}
+	if (!Rule.OwnerName.IsNone() && (!bIsCall || Rule.OwnerName != Indexed.FunctionOwnerName))
+	{
+		return false;
+	}
+	if (!Rule.MetadataTag.IsNone() && (!Indexed.Function || !Indexed.Function->HasMetaData(Rule.MetadataTag)))
+	{
+		return false;
+	}
+	return !Rule.NodeClass || Node->IsA(Rule.NodeClass);
+}
+
+const TArray<int32>& FCommonValidatorsNodeRules::FindMetadataRules(const UFunction* Function)
+{
+	if (const TArray<int32>* Decision = MetadataDecisions.Find(Function))
+	{
+		return *Decision;
+	}
+
+	TArray<int32> Candidates;
+	for (const TPair<FName, TArray<int32>>& Pair : RulesByMetadataTag)
+	{
+		if (Function->HasMetaData(Pair.Key))
+		{
+			Candidates.Append(Pair.Value);
+		}
+	}
+	return MetadataDecisions.Add(Function, MoveTemp(Candidates));
+}
+
+const TArray<int32>& FCommonValidatorsNodeRules::FindNodeClassRules(const UClass* Class)
+{
+	if (const TArray<int32>* Decision = NodeClassDecisions.Find(Class))
+	{
+		return *Decision;
+	}
+
+	TArray<int32> Candidates;
+	for (const UClass* Current = Class; Current; Current = Current->GetSuperClass())
+	{
+		if (const TArray<int32>* Found = RulesByNodeClass.Find(Current))
+		{
+			Candidates.Append(*Found);
+		}
+	}
+	return NodeClassDecisions.Add(Class, MoveTemp(Candidates));
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UClass;
+class UEdGraphNode;
+class UFunction;
+struct FCommonValidatorsIndexedNode;
+enum class EModuleChangeReason;
+
+/**
+ * UCommonValidatorsDeveloperSettings::NodeRules compiled into hash tables, so a node is checked against every rule
+ * with a few hash probes. Each rule is filed under its most selective criterion (function name, owner class, metadata
+ * tag, then node class) and only the rules found there have their other criteria checked. Metadata and class
+ * hierarchy lookups are done once per function and node class. Game thread only.
+ */
+class COMMONVALIDATORS_API FCommonValidatorsNodeRules
+{
+public:
+	static FCommonValidatorsNodeRules& Get();
+
+	void Initialize();
+	void Shutdown();
+
+	// Adds the index in NodeRules of every rule the node matches.
+	void Match(const UEdGraphNode* Node, const FCommonValidatorsIndexedNode& Indexed, TArray<int32>& OutRules);
+
+	// Forces the settings to be compiled again on next use.
+	void MarkDirty();
+
+	// Compiles the settings again if they changed since the last call.
+	void Refresh();
+
+	// Incremented whenever a refresh changes the outcome of Match, so derived data can be invalidated.
+	uint32 GetGeneration() const { return Generation; }
+
+	// Hash of NodeRules.
+	static uint32 ComputeSettingsHash();
+
+private:
+	struct FCompiledRule
+	{
+		FName FunctionName;
+		FName OwnerName;
+		FName MetadataTag;
+		const UClass* NodeClass = nullptr;
+	};
+
+	void Rebuild();
+	bool MatchesRule(const FCompiledRule& Rule, const UEdGraphNode* Node, const FCommonValidatorsIndexedNode& Indexed) const;
+	const TArray<int32>& FindMetadataRules(const UFunction* Function);
+	const TArray<int32>& FindNodeClassRules(const UClass* Class);
+
+	void OnModulesChanged(FName ModuleName, EModuleChangeReason Reason);
+	void OnPostGarbageCollect();
+
+	// Indexed like NodeRules, rules without any criterion or with an unresolved node class are left empty.
+	TArray<FCompiledRule> Rules;
+
+	TMap<FName, TArray<int32>> RulesByFunctionName;
+	TMap<FName, TArray<int32>> RulesByOwnerName;
+	TMap<FName, TArray<int32>> RulesByMetadataTag;
+	TMap<const UClass*, TArray<int32>> RulesByNodeClass;
+
+	// Rules filed under a metadata tag the function has, and under a node class or one of its parents.
+	TMap<const UFunction*, TArray<int32>> MetadataDecisions;
+	TMap<const UClass*, TArray<int32>> NodeClassDecisions;
+
+	uint32 SettingsHash = 0;
+	uint32 Generation = 0;
+	bool bDirty = true;
+	bool bHasUnresolvedEntries = false;
+
+	FDelegateHandle SettingsChangedHandle;
+	FDelegateHandle ModulesChangedHandle;
+	FDelegateHandle PostGarbageCollectHandle;
+};
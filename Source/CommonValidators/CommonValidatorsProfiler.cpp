@@ -0,0 +1,81 @@
+#include "CommonValidatorsProfiler.h"
+
+#include "CommonValidatorsLog.h"
+#include "HAL/IConsoleManager.h"
+
+namespace UE::Internal::ProfilerHelpers
+{
+	static constexpr int32 DefaultNumAssets = 10;
+
+	static FAutoConsoleCommand PrintSlowestCommand(
+		TEXT("CommonValidators.PrintSlowestAssets"),
+		TEXT("Logs the slowest Blueprints of every validator since the editor started. Optional argument: number of assets per validator (default 10)."),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			FCommonValidatorsProfiler::Get().PrintSlowest(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : DefaultNumAssets);
+		}));
+
+	static FAutoConsoleCommand ResetCommand(
+		TEXT("CommonValidators.ResetProfile"),
+		TEXT("Forgets the timings listed by CommonValidators.PrintSlowestAssets."),
+		FConsoleCommandDelegate::CreateLambda([]()
+		{
+			FCommonValidatorsProfiler::Get().Reset();
+		}));
+}
+
+FCommonValidatorsProfiler& FCommonValidatorsProfiler::Get()
+{
+	static FCommonValidatorsProfiler Instance;
+	return Instance;
+}
+
+void FCommonValidatorsProfiler::Record(FName Category, const FString& AssetPath, int32 NumNodes, int32 NumPins, double Seconds)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	FSample& Sample = Samples.FindOrAdd(Category).FindOrAdd(AssetPath);
+	Sample.NumNodes = NumNodes;
+	Sample.NumPins = NumPins;
+	Sample.NumRuns++;
+	Sample.TotalSeconds += Seconds;
+	Sample.MaxSeconds = FMath::Max(Sample.MaxSeconds, Seconds);
+}
+
+void FCommonValidatorsProfiler::Reset()
+{
+	FScopeLock ScopeLock(&Lock);
+	Samples.Reset();
+}
+
+void FCommonValidatorsProfiler::PrintSlowest(int32 NumAssets) const
+{
+	FScopeLock ScopeLock(&Lock);
+
+	TArray<FName> Categories;
+	Samples.GetKeys(Categories);
+	Categories.Sort(FNameLexicalLess());
+
+	for (const FName Category : Categories)
+	{
+		const TMap<FString, FSample>& CategorySamples = Samples.FindChecked(Category);
+
+		double TotalSeconds = 0.0;
+		TArray<const TPair<FString, FSample>*> Sorted;
+		Sorted.Reserve(CategorySamples.Num());
+		for (const TPair<FString, FSample>& Pair : CategorySamples)
+		{
+			Sorted.Add(&Pair);
+			TotalSeconds += Pair.Value.TotalSeconds;
+		}
+		Sorted.Sort([](const TPair<FString, FSample>& A, const TPair<FString, FSample>& B) { return A.Value.MaxSeconds > B.Value.MaxSeconds; });
+
+		UE_LOG(LogCommonValidators, Display, TEXT("%s: %d assets, %.2f ms total"), *Category.ToString(), CategorySamples.Num(), TotalSeconds * 1000.0);
+		for (int32 Index = 0; Index < FMath::Min(NumAssets, Sorted.Num()); ++Index)
+		{
+			const FSample& Sample = Sorted[Index]->Value;
+			UE_LOG(LogCommonValidators, Display, TEXT("    %8.3f ms max %8.3f ms avg %7d nodes %8d pins  %s"),
+				Sample.MaxSeconds * 1000.0, Sample.TotalSeconds * 1000.0 / Sample.NumRuns, Sample.NumNodes, Sample.NumPins, *Sorted[Index]->Key);
+		}
+	}
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("CommonValidators"), STATGROUP_CommonValidators, STATCAT_Advanced);
+
+/**
+ * Keeps how long every validator (and the graph index) took on every asset it analyzed, so the slowest
+ * Blueprints can be listed with CommonValidators.PrintSlowestAssets or the commandlet's -Slowest option.
+ * Results replayed from the result cache are not recorded.
+ */
+class COMMONVALIDATORS_API FCommonValidatorsProfiler
+{
+public:
+	static FCommonValidatorsProfiler& Get();
+
+	// Thread safe.
+	void Record(FName Category, const FString& AssetPath, int32 NumNodes, int32 NumPins, double Seconds);
+
+	void Reset();
+
+	// Logs the NumAssets slowest assets of every category.
+	void PrintSlowest(int32 NumAssets) const;
+
+private:
+	struct FSample
+	{
+		int32 NumNodes = 0;
+		int32 NumPins = 0;
+		int32 NumRuns = 0;
+		double TotalSeconds = 0.0;
+		double MaxSeconds = 0.0;
+	};
+
+	mutable FCriticalSection Lock;
+	TMap<FName, TMap<FString, FSample>> Samples;
+};
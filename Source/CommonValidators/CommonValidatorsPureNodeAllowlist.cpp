@@ -0,0 +1,204 @@
+#include "CommonValidatorsPureNodeAllowlist.h"
+
+#include "CommonValidatorsDeveloperSettings.h"
+#include "Modules/ModuleManager.h"
+#include "UObject/Class.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace UE::Internal::PureNodeAllowlistHelpers
+{
+	// Native classes are never loaded on demand, they become resolvable once their module is loaded.
+	static const UClass* ResolveClass(const TSoftClassPtr<UObject>& SoftClass)
+	{
+		if (SoftClass.ToSoftObjectPath().GetLongPackageName().StartsWith(TEXT("/Script/")))
+		{
+			return SoftClass.Get();
+		}
+		return SoftClass.LoadSynchronous();
+	}
+}
+
+FCommonValidatorsPureNodeAllowlist& FCommonValidatorsPureNodeAllowlist::Get()
+{
+	static FCommonValidatorsPureNodeAllowlist Instance;
+	return Instance;
+}
+
+void FCommonValidatorsPureNodeAllowlist::Initialize()
+{
+	SettingsChangedHandle = GetMutableDefault<UCommonValidatorsDeveloperSettings>()->OnSettingChanged().AddLambda(
+		[this](UObject*, FPropertyChangedEvent&)
+		{
+			MarkDirty();
+		});
+
+	// Classes from modules loaded after us (e.g. plugin function libraries) can only be resolved later.
+	ModulesChangedHandle = FModuleManager::Get().OnModulesChanged().AddRaw(this, &FCommonValidatorsPureNodeAllowlist::OnModulesChanged);
+
+	// Recompiled Blueprint function libraries get new UFunctions, don't keep decisions for stale pointers.
+	PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FCommonValidatorsPureNodeAllowlist::OnPostGarbageCollect);
+}
+
+void FCommonValidatorsPureNodeAllowlist::Shutdown()
+{
+	if (UObjectInitialized())
+	{
+		GetMutableDefault<UCommonValidatorsDeveloperSettings>()->OnSettingChanged().Remove(SettingsChangedHandle);
+	}
+	FModuleManager::Get().OnModulesChanged().Remove(ModulesChangedHandle);
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+
+	ResolvedClasses.Reset();
+	ResolvedFunctions.Reset();
+	Classes.Reset();
+	Functions.Reset();
+	Decisions.Reset();
+	bDirty = true;
+}
+
+void FCommonValidatorsPureNodeAllowlist::MarkDirty()
+{
+	bDirty = true;
+}
+
+void FCommonValidatorsPureNodeAllowlist::OnModulesChanged(FName ModuleName, EModuleChangeReason Reason)
+{
+	if (Reason == EModuleChangeReason::ModuleLoaded && bHasUnresolvedEntries)
+	{
+		bNeedsResolve = true;
+	}
+}
+
+void FCommonValidatorsPureNodeAllowlist::OnPostGarbageCollect()
+{
+	// Decisions are keyed by pointer, a recompiled function library may reuse the address of a collected function.
+	Decisions.Reset();
+
+	// Resolving is a synchronous load for Blueprint classes, so only do it when a class actually went away.
+	auto IsStale = [](const auto& Resolved) { return !Resolved.IsExplicitlyNull() && !Resolved.IsValid(); };
+	if (ResolvedClasses.ContainsByPredicate(IsStale) || ResolvedFunctions.ContainsByPredicate(IsStale))
+	{
+		bNeedsResolve = true;
+	}
+}
+
+void FCommonValidatorsPureNodeAllowlist::Refresh()
+{
+	check(IsInGameThread());
+
+	if (bDirty || bNeedsResolve)
+	{
+		Rebuild();
+	}
+}
+
+void FCommonValidatorsPureNodeAllowlist::Rebuild()
+{
+	const UCommonValidatorsDeveloperSettings* Settings = GetDefault<UCommonValidatorsDeveloperSettings>();
+
+	if (bDirty)
+	{
+		ResolvedClasses.Reset();
+		ResolvedFunctions.Reset();
+	}
+	ResolvedClasses.SetNum(Settings->HarmlessPureNodeClasses.Num());
+	ResolvedFunctions.SetNum(Settings->HarmlessPureNodeFunctions.Num());
+
+	const TSet<const UClass*> OldClasses = MoveTemp(Classes);
+	const TSet<const UFunction*> OldFunctions = MoveTemp(Functions);
+	const TArray<FName> OldMetadataTags = MoveTemp(MetadataTags);
+	const TArray<FString> OldClassNameSubstrings = MoveTemp(ClassNameSubstrings);
+
+	Classes.Reset();
+	Functions.Reset();
+	Decisions.Reset();
+	bHasUnresolvedEntries = false;
+
+	for (int32 EntryIndex = 0; EntryIndex < ResolvedClasses.Num(); ++EntryIndex)
+	{
+		const TSoftClassPtr<UObject>& SoftClass = Settings->HarmlessPureNodeClasses[EntryIndex];
+		TWeakObjectPtr<const UClass>& Resolved = ResolvedClasses[EntryIndex];
+		if (!Resolved.IsValid())
+		{
+			Resolved = UE::Internal::PureNodeAllowlistHelpers::ResolveClass(SoftClass);
+		}
+
+		if (const UClass* Class = Resolved.Get())
+		{
+			Classes.Add(Class);
+		}
+		else
+		{
+			bHasUnresolvedEntries |= !SoftClass.IsNull();
+		}
+	}
+
+	for (int32 EntryIndex = 0; EntryIndex < ResolvedFunctions.Num(); ++EntryIndex)
+	{
+		const FCommonValidatorsFunctionReference& FunctionReference = Settings->HarmlessPureNodeFunctions[EntryIndex];
+		TWeakObjectPtr<const UFunction>& Resolved = ResolvedFunctions[EntryIndex];
+		if (!Resolved.IsValid())
+		{
+			const UClass* Class = UE::Internal::PureNodeAllowlistHelpers::ResolveClass(FunctionReference.Class);
+			Resolved = Class ? Class->FindFunctionByName(FunctionReference.FunctionName) : nullptr;
+		}
+
+		if (const UFunction* Function = Resolved.Get())
+		{
+			Functions.Add(Function);
+		}
+		else
+		{
+			bHasUnresolvedEntries |= !FunctionReference.Class.IsNull();
+		}
+	}
+
+	MetadataTags = Settings->HarmlessPureNodeMetadataTags;
+	ClassNameSubstrings = Settings->HarmlessPureNodeClassNameSubstrings;
+	bDirty = false;
+	bNeedsResolve = false;
+
+	// Rebuilds after a GC usually resolve to the very same set
+	const bool bChanged = Classes.Num() != OldClasses.Num() || !Classes.Includes(OldClasses)
+		|| Functions.Num() != OldFunctions.Num() || !Functions.Includes(OldFunctions)
+		|| MetadataTags != OldMetadataTags || ClassNameSubstrings != OldClassNameSubstrings;
+	if (bChanged)
+	{
+		++Generation;
+	}
+}
+
+bool FCommonValidatorsPureNodeAllowlist::IsHarmless(const UFunction* Function)
+{
+	check(IsInGameThread());
+
+	if (!Function)
+	{
+		return false;
+	}
+
+	Refresh();
+
+	if (const bool* Decision = Decisions.Find(Function))
+	{
+		return *Decision;
+	}
+
+	const UClass* OwnerClass = Function->GetOuterUClass();
+	bool bIsHarmless = Functions.Contains(Function) || Classes.Contains(OwnerClass);
+	for (int32 TagIndex = 0; !bIsHarmless && TagIndex < MetadataTags.Num(); ++TagIndex)
+	{
+		bIsHarmless = Function->HasMetaData(MetadataTags[TagIndex]);
+	}
+	if (!bIsHarmless && OwnerClass && !ClassNameSubstrings.IsEmpty())
+	{
+		const FString OwnerName = OwnerClass->GetName();
+		for (int32 SubstringIndex = 0; !bIsHarmless && SubstringIndex < ClassNameSubstrings.Num(); ++SubstringIndex)
+		{
+			bIsHarmless = OwnerName.Contains(ClassNameSubstrings[SubstringIndex]);
+		}
+	}
+
+	Decisions.Add(Function, bIsHarmless);
+	return bIsHarmless;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UClass;
+class UFunction;
+enum class EModuleChangeReason;
+
+/**
+ * Lookup table of pure functions that are cheap enough to be evaluated more than once, resolved from
+ * UCommonValidatorsDeveloperSettings. The soft references are resolved once, on first use after startup
+ * or after the settings changed, after which every query is a couple of hash probes. Later refreshes only
+ * resolve the entries that are still unresolved or whose class was garbage collected.
+ * Game thread only.
+ */
+class COMMONVALIDATORS_API FCommonValidatorsPureNodeAllowlist
+{
+public:
+	static FCommonValidatorsPureNodeAllowlist& Get();
+
+	void Initialize();
+	void Shutdown();
+
+	bool IsHarmless(const UFunction* Function);
+
+	// Forces the settings to be resolved again on next use.
+	void MarkDirty();
+
+	// Resolves the settings again if they changed since the last call.
+	void Refresh();
+
+	// Incremented whenever a refresh changes the outcome of IsHarmless, so derived data can be invalidated.
+	uint32 GetGeneration() const { return Generation; }
+
+private:
+	void Rebuild();
+	void OnModulesChanged(FName ModuleName, EModuleChangeReason Reason);
+	void OnPostGarbageCollect();
+
+	// Parallel to the settings' HarmlessPureNodeClasses and HarmlessPureNodeFunctions, null while unresolved.
+	TArray<TWeakObjectPtr<const UClass>> ResolvedClasses;
+	TArray<TWeakObjectPtr<const UFunction>> ResolvedFunctions;
+
+	TSet<const UClass*> Classes;
+	TSet<const UFunction*> Functions;
+	TArray<FName> MetadataTags;
+	TArray<FString> ClassNameSubstrings;
+
+	// Decisions for functions that are not explicitly listed, so metadata is only inspected once per function.
+	TMap<const UFunction*, bool> Decisions;
+
+	uint32 Generation = 0;
+
+	// The settings changed, every entry is resolved again.
+	bool bDirty = true;
+
+	// Some entries are unresolved or were garbage collected, only those are resolved again.
+	bool bNeedsResolve = false;
+	bool bHasUnresolvedEntries = false;
+
+	FDelegateHandle SettingsChangedHandle;
+	FDelegateHandle ModulesChangedHandle;
+	FDelegateHandle PostGarbageCollectHandle;
+};
@@ -0,0 +1,408 @@
+#include "CommonValidatorsReferenceGraph.h"
+
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "CommonValidatorsDeveloperSettings.h"
+#include "Misc/Crc.h"
+#include "Misc/PackageName.h"
+#include "Modules/ModuleManager.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+FCommonValidatorsReferenceGraph& FCommonValidatorsReferenceGraph::Get()
+{
+	static FCommonValidatorsReferenceGraph Instance;
+	return Instance;
+}
+
+void FCommonValidatorsReferenceGraph::Initialize()
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AssetAddedHandle = AssetRegistry.OnAssetAdded().AddRaw(this, &FCommonValidatorsReferenceGraph::OnAssetChanged);
+	AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddRaw(this, &FCommonValidatorsReferenceGraph::OnAssetChanged);
+	AssetUpdatedHandle = AssetRegistry.OnAssetUpdated().AddRaw(this, &FCommonValidatorsReferenceGraph::OnAssetChanged);
+	AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddRaw(this, &FCommonValidatorsReferenceGraph::OnAssetRenamed);
+}
+
+void FCommonValidatorsReferenceGraph::Shutdown()
+{
+	if (IAssetRegistry* AssetRegistry = IAssetRegistry::Get())
+	{
+		AssetRegistry->OnAssetAdded().Remove(AssetAddedHandle);
+		AssetRegistry->OnAssetRemoved().Remove(AssetRemovedHandle);
+		AssetRegistry->OnAssetUpdated().Remove(AssetUpdatedHandle);
+		AssetRegistry->OnAssetRenamed().Remove(AssetRenamedHandle);
+	}
+
+	Reset();
+}
+
+FCommonValidatorsReferenceClosure FCommonValidatorsReferenceGraph::GetClosure(FName PackageName, int32 MaxEdges)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FCommonValidatorsReferenceGraph::GetClosure);
+
+	FScopeLock ScopeLock(&Lock);
+	RefreshSettings();
+
+	FCommonValidatorsReferenceClosure Closure;
+	if (IsIgnored(PackageName))
+	{
+		return Closure;
+	}
+
+	const int32 Root = FindOrAddNode(PackageName);
+	if (Nodes[Root].Component == INDEX_NONE)
+	{
+		BuildComponents(Root);
+	}
+
+	const int32 RootComponent = Nodes[Root].Component;
+	ComputeClosureSize(RootComponent);
+	Closure.NumPackages = Components[RootComponent].NumPackages - 1;
+	Closure.DiskSize = Components[RootComponent].DiskSize - Nodes[Root].DiskSize;
+
+	if (MaxEdges <= 0)
+	{
+		return Closure;
+	}
+
+	Closure.Edges.Reserve(Nodes[Root].Dependencies.Num());
+	for (const int32 Dependency : Nodes[Root].Dependencies)
+	{
+		const int32 DependencyComponent = Nodes[Dependency].Component;
+		ComputeClosureSize(DependencyComponent);
+		Closure.Edges.Emplace(Nodes[Dependency].PackageName, Components[DependencyComponent].DiskSize);
+	}
+	Closure.Edges.Sort([](const TPair<FName, int64>& A, const TPair<FName, int64>& B) { return A.Value > B.Value; });
+	Closure.Edges.SetNum(FMath::Min(Closure.Edges.Num(), MaxEdges));
+
+	return Closure;
+}
+
+void FCommonValidatorsReferenceGraph::Reset()
+{
+	FScopeLock ScopeLock(&Lock);
+	ResetGraph();
+}
+
+void FCommonValidatorsReferenceGraph::ResetGraph()
+{
+	Nodes.Empty();
+	NodeIds.Empty();
+	Components.Empty();
+	FreeComponents.Empty();
+	ComponentVisits.Empty();
+}
+
+int32 FCommonValidatorsReferenceGraph::FindOrAddNode(FName PackageName)
+{
+	if (const int32* Existing = NodeIds.Find(PackageName))
+	{
+		return *Existing;
+	}
+
+	const int32 NodeId = Nodes.Num();
+	NodeIds.Add(PackageName, NodeId);
+	Nodes.AddDefaulted_GetRef().PackageName = PackageName;
+	return NodeId;
+}
+
+void FCommonValidatorsReferenceGraph::ResolveNode(int32 NodeId)
+{
+	if (Nodes[NodeId].bResolved)
+	{
+		return;
+	}
+
+	const FName PackageName = Nodes[NodeId].PackageName;
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	TArray<FName> DependencyNames;
+	AssetRegistry.GetDependencies(PackageName, DependencyNames, UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Hard);
+	DependencyNames.RemoveAll([this, PackageName](FName Dependency) { return Dependency == PackageName || IsIgnored(Dependency); });
+
+	TArray<int32> Dependencies;
+	Dependencies.Reserve(DependencyNames.Num());
+	for (const FName Dependency : DependencyNames)
+	{
+		Dependencies.Add(FindOrAddNode(Dependency));
+	}
+
+	// Looked up again after a change, drop the links of the previous lookup.
+	for (const int32 Dependency : Nodes[NodeId].Dependencies)
+	{
+		Nodes[Dependency].Referencers.RemoveSingleSwap(NodeId, EAllowShrinking::No);
+	}
+	for (const int32 Dependency : Dependencies)
+	{
+		Nodes[Dependency].Referencers.Add(NodeId);
+	}
+
+	// Nodes may have moved while adding the dependencies.
+	FNode& Node = Nodes[NodeId];
+	Node.Dependencies = MoveTemp(Dependencies);
+	Node.bResolved = true;
+	Node.DiskSize = 0;
+	if (const TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(PackageName))
+	{
+		Node.DiskSize = FMath::Max<int64>(PackageData->DiskSize, 0);
+	}
+}
+
+bool FCommonValidatorsReferenceGraph::IsIgnored(FName PackageName) const
+{
+	// Script packages are native code, their memory isn't attributable to content.
+	TStringBuilder<256> PackageString;
+	PackageName.AppendString(PackageString);
+	if (FPackageName::IsScriptPackage(PackageString.ToView()))
+	{
+		return true;
+	}
+
+	for (const FString& IgnoredPath : IgnoredPaths)
+	{
+		if (PackageString.ToView().StartsWith(IgnoredPath, ESearchCase::IgnoreCase))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void FCommonValidatorsReferenceGraph::BuildComponents(int32 Root)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FCommonValidatorsReferenceGraph::BuildComponents);
+
+	struct FFrame
+	{
+		int32 Node = INDEX_NONE;
+		int32 NextDependency = 0;
+	};
+
+	// Walk state, grown along with Nodes as the walk discovers packages.
+	TArray<int32> Indices;
+	TArray<int32> LowLinks;
+	TBitArray<> OnStack;
+	auto Grow = [this, &Indices, &LowLinks, &OnStack]()
+	{
+		while (Indices.Num() < Nodes.Num())
+		{
+			Indices.Add(INDEX_NONE);
+			LowLinks.Add(0);
+			OnStack.Add(false);
+		}
+	};
+
+	TArray<FFrame> CallStack;
+	TArray<int32> ComponentStack;
+	TArray<int32> Members;
+	int32 NextIndex = 0;
+
+	auto Push = [this, &Grow, &Indices, &LowLinks, &OnStack, &CallStack, &ComponentStack, &NextIndex](int32 NodeId)
+	{
+		// Looks up the package's own dependencies, which may add nodes.
+		ResolveNode(NodeId);
+		Grow();
+
+		Indices[NodeId] = NextIndex;
+		LowLinks[NodeId] = NextIndex;
+		++NextIndex;
+		ComponentStack.Add(NodeId);
+		OnStack[NodeId] = true;
+		CallStack.Add({ NodeId, 0 });
+	};
+
+	Push(Root);
+	while (CallStack.Num() > 0)
+	{
+		const int32 Current = CallStack.Last().Node;
+		if (CallStack.Last().NextDependency < Nodes[Current].Dependencies.Num())
+		{
+			const int32 Dependency = Nodes[Current].Dependencies[CallStack.Last().NextDependency++];
+			if (Nodes[Dependency].Component != INDEX_NONE)
+			{
+				// Finished by an earlier walk and nothing it reaches changed since.
+				continue;
+			}
+
+			Grow();
+			if (Indices[Dependency] == INDEX_NONE)
+			{
+				Push(Dependency);
+			}
+			else if (OnStack[Dependency])
+			{
+				LowLinks[Current] = FMath::Min(LowLinks[Current], Indices[Dependency]);
+			}
+			continue;
+		}
+
+		CallStack.Pop(EAllowShrinking::No);
+		if (CallStack.Num() > 0)
+		{
+			const int32 Parent = CallStack.Last().Node;
+			LowLinks[Parent] = FMath::Min(LowLinks[Parent], LowLinks[Current]);
+		}
+
+		if (LowLinks[Current] == Indices[Current])
+		{
+			Members.Reset();
+			int32 Member = INDEX_NONE;
+			do
+			{
+				Member = ComponentStack.Pop(EAllowShrinking::No);
+				OnStack[Member] = false;
+				Members.Add(Member);
+			}
+			while (Member != Current);
+
+			FinishComponent(Members);
+		}
+	}
+}
+
+void FCommonValidatorsReferenceGraph::FinishComponent(TConstArrayView<int32> Members)
+{
+	const int32 ComponentId = FreeComponents.Num() > 0 ? FreeComponents.Pop(EAllowShrinking::No) : Components.AddDefaulted();
+	for (const int32 Member : Members)
+	{
+		Nodes[Member].Component = ComponentId;
+	}
+
+	// Every dependency outside the component was finished before it, by this walk or an earlier one.
+	FComponent& Component = Components[ComponentId];
+	Component.Members.Append(Members.GetData(), Members.Num());
+	for (const int32 Member : Members)
+	{
+		for (const int32 Dependency : Nodes[Member].Dependencies)
+		{
+			const int32 DependencyComponent = Nodes[Dependency].Component;
+			if (DependencyComponent != ComponentId)
+			{
+				Component.Dependencies.AddUnique(DependencyComponent);
+			}
+		}
+	}
+}
+
+void FCommonValidatorsReferenceGraph::ComputeClosureSize(int32 ComponentId)
+{
+	if (Components[ComponentId].DiskSize >= 0)
+	{
+		return;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(FCommonValidatorsReferenceGraph::ComputeClosureSize);
+
+	// Components reached along several paths count once, so the sizes of the dependencies can't just be summed.
+	ComponentVisits.SetNumZeroed(Components.Num());
+	if (++VisitStamp == 0)
+	{
+		FMemory::Memzero(ComponentVisits.GetData(), ComponentVisits.Num() * sizeof(uint32));
+		VisitStamp = 1;
+	}
+
+	int64 DiskSize = 0;
+	int32 NumPackages = 0;
+	TArray<int32, TInlineAllocator<64>> Stack;
+	Stack.Add(ComponentId);
+	ComponentVisits[ComponentId] = VisitStamp;
+	while (Stack.Num() > 0)
+	{
+		const FComponent& Current = Components[Stack.Pop(EAllowShrinking::No)];
+		NumPackages += Current.Members.Num();
+		for (const int32 Member : Current.Members)
+		{
+			DiskSize += Nodes[Member].DiskSize;
+		}
+
+		for (const int32 Dependency : Current.Dependencies)
+		{
+			if (ComponentVisits[Dependency] != VisitStamp)
+			{
+				ComponentVisits[Dependency] = VisitStamp;
+				Stack.Add(Dependency);
+			}
+		}
+	}
+
+	Components[ComponentId].DiskSize = DiskSize;
+	Components[ComponentId].NumPackages = NumPackages;
+}
+
+void FCommonValidatorsReferenceGraph::InvalidatePackage(FName PackageName)
+{
+	const int32* NodeId = NodeIds.Find(PackageName);
+	if (!NodeId)
+	{
+		return;
+	}
+
+	Nodes[*NodeId].bResolved = false;
+	if (Nodes[*NodeId].Component == INDEX_NONE)
+	{
+		// Components are only finished once everything they reach is, so nothing reaching the node has one either.
+		return;
+	}
+
+	const int32 ComponentId = Nodes[*NodeId].Component;
+	TArray<int32> Pending(Components[ComponentId].Members);
+	ReleaseComponent(ComponentId);
+	while (Pending.Num() > 0)
+	{
+		const int32 Current = Pending.Pop(EAllowShrinking::No);
+		for (const int32 Referencer : Nodes[Current].Referencers)
+		{
+			if (Nodes[Referencer].Component != INDEX_NONE)
+			{
+				const int32 ReferencerComponent = Nodes[Referencer].Component;
+				Pending.Append(Components[ReferencerComponent].Members);
+				ReleaseComponent(ReferencerComponent);
+			}
+		}
+	}
+}
+
+void FCommonValidatorsReferenceGraph::ReleaseComponent(int32 ComponentId)
+{
+	FComponent& Component = Components[ComponentId];
+	for (const int32 Member : Component.Members)
+	{
+		Nodes[Member].Component = INDEX_NONE;
+	}
+
+	Component = FComponent();
+	FreeComponents.Add(ComponentId);
+}
+
+void FCommonValidatorsReferenceGraph::RefreshSettings()
+{
+	const UCommonValidatorsDeveloperSettings* Settings = GetDefault<UCommonValidatorsDeveloperSettings>();
+
+	uint32 Hash = 0;
+	for (const FString& IgnoredPath : Settings->HardReferenceIgnoredPaths)
+	{
+		Hash = FCrc::StrCrc32(*IgnoredPath, Hash);
+	}
+
+	if (Hash != SettingsHash)
+	{
+		ResetGraph();
+		IgnoredPaths = Settings->HardReferenceIgnoredPaths;
+		SettingsHash = Hash;
+	}
+}
+
+void FCommonValidatorsReferenceGraph::OnAssetChanged(const FAssetData& AssetData)
+{
+	// The registry fires these in bulk while scanning, mostly for packages no closure was asked about yet.
+	FScopeLock ScopeLock(&Lock);
+	InvalidatePackage(AssetData.PackageName);
+}
+
+void FCommonValidatorsReferenceGraph::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	FScopeLock ScopeLock(&Lock);
+	InvalidatePackage(AssetData.PackageName);
+	InvalidatePackage(FName(FPackageName::ObjectPathToPackageName(OldObjectPath)));
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FAssetData;
+
+// Everything loaded along with a package through hard references.
+struct FCommonValidatorsReferenceClosure
+{
+	// Packages in the closure, the root excluded.
+	int32 NumPackages = 0;
+
+	// Summed disk size of those packages, the Asset Registry's closest estimate of what they cost in memory.
+	int64 DiskSize = 0;
+
+	// Direct hard references, by decreasing size of what each of them pulls in (itself included).
+	TArray<TPair<FName, int64>> Edges;
+};
+
+/**
+ * Hard package references as recorded by the Asset Registry, so closures can be computed without loading anything.
+ * Strongly connected components are collapsed into a DAG, shared by every package that reaches them. Only the size
+ * of a component's closure is kept, computed by walking the components it reaches the first time it is asked for.
+ * When the Asset Registry reports a change to a package, only the components reaching it are dropped.
+ */
+class COMMONVALIDATORS_API FCommonValidatorsReferenceGraph
+{
+public:
+	static FCommonValidatorsReferenceGraph& Get();
+
+	void Initialize();
+	void Shutdown();
+
+	// Thread safe. Edges cost a walk per direct reference, only ask for them when reporting.
+	FCommonValidatorsReferenceClosure GetClosure(FName PackageName, int32 MaxEdges);
+
+	void Reset();
+
+private:
+	struct FNode
+	{
+		FName PackageName;
+		int64 DiskSize = 0;
+		TArray<int32> Dependencies;
+
+		// Resolved nodes depending on this one.
+		TArray<int32> Referencers;
+
+		// INDEX_NONE until a walk reaches the node, and again once a package it reaches changed.
+		int32 Component = INDEX_NONE;
+
+		// Whether the dependencies and size have been looked up yet.
+		bool bResolved = false;
+	};
+
+	struct FComponent
+	{
+		TArray<int32> Members;
+
+		// Components the members reference, once each, the component itself excluded.
+		TArray<int32> Dependencies;
+
+		// Of the closure, the component's own members included. -1 until asked for.
+		int64 DiskSize = -1;
+		int32 NumPackages = -1;
+	};
+
+	int32 FindOrAddNode(FName PackageName);
+	void ResolveNode(int32 NodeId);
+	bool IsIgnored(FName PackageName) const;
+
+	// Tarjan's algorithm, iterative. Components are finished dependencies first, so they can be linked right away.
+	void BuildComponents(int32 Root);
+	void FinishComponent(TConstArrayView<int32> Members);
+
+	// Fills in DiskSize and NumPackages of the component, walking every component it reaches once.
+	void ComputeClosureSize(int32 ComponentId);
+
+	// Drops the components of every node reaching the package, and looks the package itself up again next time.
+	void InvalidatePackage(FName PackageName);
+	void ReleaseComponent(int32 ComponentId);
+	void ResetGraph();
+
+	void RefreshSettings();
+	void OnAssetChanged(const FAssetData& AssetData);
+	void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+
+	mutable FCriticalSection Lock;
+
+	TArray<FNode> Nodes;
+	TMap<FName, int32> NodeIds;
+	TArray<FComponent> Components;
+	TArray<int32> FreeComponents;
+
+	// Per component, the last walk of ComputeClosureSize that reached it.
+	TArray<uint32> ComponentVisits;
+	uint32 VisitStamp = 0;
+
+	TArray<FString> IgnoredPaths;
+	uint32 SettingsHash = 0;
+
+	FDelegateHandle AssetAddedHandle;
+	FDelegateHandle AssetRemovedHandle;
+	FDelegateHandle AssetUpdatedHandle;
+	FDelegateHandle AssetRenamedHandle;
+};
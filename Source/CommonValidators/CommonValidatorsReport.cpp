@@ -0,0 +1,434 @@
+#include "CommonValidatorsReport.h"
+
+#include "CommonValidatorsLog.h"
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace UE::Internal::ReportHelpers
+{
+	static const TCHAR* SeverityToString(EMessageSeverity::Type Severity)
+	{
+		switch (Severity)
+		{
+		case EMessageSeverity::Error:
+			return TEXT("Error");
+		case EMessageSeverity::PerformanceWarning:
+			return TEXT("PerformanceWarning");
+		case EMessageSeverity::Warning:
+			return TEXT("Warning");
+		default:
+			return TEXT("Info");
+		}
+	}
+
+	static EMessageSeverity::Type SeverityFromString(const FString& String)
+	{
+		if (String == TEXT("Error"))
+		{
+			return EMessageSeverity::Error;
+		}
+		if (String == TEXT("PerformanceWarning"))
+		{
+			return EMessageSeverity::PerformanceWarning;
+		}
+		if (String == TEXT("Warning"))
+		{
+			return EMessageSeverity::Warning;
+		}
+		return EMessageSeverity::Info;
+	}
+
+	static const TCHAR* SeverityToSarifLevel(EMessageSeverity::Type Severity)
+	{
+		switch (Severity)
+		{
+		case EMessageSeverity::Error:
+			return TEXT("error");
+		case EMessageSeverity::PerformanceWarning:
+		case EMessageSeverity::Warning:
+			return TEXT("warning");
+		default:
+			return TEXT("note");
+		}
+	}
+
+	static const TCHAR* ResultToString(EDataValidationResult Result)
+	{
+		switch (Result)
+		{
+		case EDataValidationResult::Invalid:
+			return TEXT("Invalid");
+		case EDataValidationResult::Valid:
+			return TEXT("Valid");
+		default:
+			return TEXT("NotValidated");
+		}
+	}
+
+	static EDataValidationResult ResultFromString(const FString& String)
+	{
+		if (String == TEXT("Invalid"))
+		{
+			return EDataValidationResult::Invalid;
+		}
+		if (String == TEXT("Valid"))
+		{
+			return EDataValidationResult::Valid;
+		}
+		return EDataValidationResult::NotValidated;
+	}
+
+	static bool FindingLess(const FCommonValidatorsFinding& A, const FCommonValidatorsFinding& B)
+	{
+		if (A.GraphName != B.GraphName)
+		{
+			return A.GraphName.LexicalLess(B.GraphName);
+		}
+		if (A.NodeGuid != B.NodeGuid)
+		{
+			return A.NodeGuid < B.NodeGuid;
+		}
+		if (A.Severity != B.Severity)
+		{
+			return A.Severity < B.Severity;
+		}
+		return A.Message < B.Message;
+	}
+
+	static bool FindingEquals(const FCommonValidatorsFinding& A, const FCommonValidatorsFinding& B)
+	{
+		return A.GraphName == B.GraphName && A.NodeGuid == B.NodeGuid && A.Severity == B.Severity && A.Message == B.Message;
+	}
+} // namespace UE::Internal::ReportHelpers
+
+
+FCommonValidatorsReportWriter::~FCommonValidatorsReportWriter()
+{
+	Close();
+}
+
+bool FCommonValidatorsReportWriter::Open(const FString& Path)
+{
+	Close();
+	Writer.Reset(IFileManager::Get().CreateFileWriter(*Path));
+	if (!Writer)
+	{
+		UE_LOG(LogCommonValidators, Error, TEXT("Failed to open %s for writing."), *Path);
+		return false;
+	}
+	return true;
+}
+
+void FCommonValidatorsReportWriter::Close()
+{
+	if (Writer)
+	{
+		Writer->Close();
+		Writer.Reset();
+	}
+}
+
+void FCommonValidatorsReportWriter::WriteShardInfo(const FCommonValidatorsShardInfo& ShardInfo)
+{
+	TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+	Object->SetStringField(TEXT("type"), TEXT("shard"));
+	Object->SetNumberField(TEXT("shard"), ShardInfo.Shard);
+	Object->SetNumberField(TEXT("numShards"), ShardInfo.NumShards);
+	Object->SetNumberField(TEXT("validated"), ShardInfo.NumValidated);
+	WriteLine(Object);
+}
+
+void FCommonValidatorsReportWriter::WriteRecord(const FCommonValidatorsResultRecord& Record)
+{
+	using namespace UE::Internal::ReportHelpers;
+
+	TArray<TSharedPtr<FJsonValue>> Findings;
+	Findings.Reserve(Record.Findings.Num());
+	for (const FCommonValidatorsFinding& Finding : Record.Findings)
+	{
+		TSharedRef<FJsonObject> FindingObject = MakeShared<FJsonObject>();
+		FindingObject->SetStringField(TEXT("severity"), SeverityToString(Finding.Severity));
+		FindingObject->SetStringField(TEXT("message"), Finding.Message);
+		FindingObject->SetStringField(TEXT("graph"), Finding.GraphName.ToString());
+		FindingObject->SetStringField(TEXT("node"), Finding.NodeGuid.ToString(EGuidFormats::DigitsWithHyphens));
+		Findings.Add(MakeShared<FJsonValueObject>(FindingObject));
+	}
+
+	TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+	Object->SetStringField(TEXT("type"), TEXT("result"));
+	Object->SetStringField(TEXT("asset"), Record.AssetPath);
+	Object->SetStringField(TEXT("validator"), Record.Validator);
+	Object->SetStringField(TEXT("result"), ResultToString(Record.Result));
+	Object->SetArrayField(TEXT("findings"), Findings);
+	WriteLine(Object);
+}
+
+void FCommonValidatorsReportWriter::Flush()
+{
+	if (Writer)
+	{
+		Writer->Flush();
+	}
+}
+
+void FCommonValidatorsReportWriter::WriteLine(const TSharedRef<FJsonObject>& Object)
+{
+	if (!Writer)
+	{
+		return;
+	}
+
+	FString Line;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> JsonWriter = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Line);
+	FJsonSerializer::Serialize(Object, JsonWriter);
+	Line.AppendChar(TEXT('\n'));
+
+	FTCHARToUTF8 Utf8(*Line);
+	Writer->Serialize(const_cast<ANSICHAR*>(Utf8.Get()), Utf8.Length());
+}
+
+bool FCommonValidatorsReportWriter::ReadJsonLines(const FString& Path, TArray<FCommonValidatorsShardInfo>& OutShards, TArray<FCommonValidatorsResultRecord>& OutRecords)
+{
+	using namespace UE::Internal::ReportHelpers;
+
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *Path))
+	{
+		UE_LOG(LogCommonValidators, Error, TEXT("Failed to read %s."), *Path);
+		return false;
+	}
+
+	for (int32 LineIndex = 0; LineIndex < Lines.Num(); ++LineIndex)
+	{
+		if (Lines[LineIndex].IsEmpty())
+		{
+			continue;
+		}
+
+		TSharedPtr<FJsonObject> Object;
+		if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Lines[LineIndex]), Object) || !Object)
+		{
+			UE_LOG(LogCommonValidators, Warning, TEXT("%s(%d): skipping malformed line."), *Path, LineIndex + 1);
+			continue;
+		}
+
+		const FString Type = Object->GetStringField(TEXT("type"));
+		if (Type == TEXT("shard"))
+		{
+			FCommonValidatorsShardInfo& ShardInfo = OutShards.AddDefaulted_GetRef();
+			ShardInfo.Shard = Object->GetIntegerField(TEXT("shard"));
+			ShardInfo.NumShards = Object->GetIntegerField(TEXT("numShards"));
+			ShardInfo.NumValidated = Object->GetIntegerField(TEXT("validated"));
+		}
+		else if (Type == TEXT("result"))
+		{
+			FCommonValidatorsResultRecord& Record = OutRecords.AddDefaulted_GetRef();
+			Record.AssetPath = Object->GetStringField(TEXT("asset"));
+			Record.Validator = Object->GetStringField(TEXT("validator"));
+			Record.Result = ResultFromString(Object->GetStringField(TEXT("result")));
+
+			const TArray<TSharedPtr<FJsonValue>>* Findings = nullptr;
+			if (Object->TryGetArrayField(TEXT("findings"), Findings))
+			{
+				for (const TSharedPtr<FJsonValue>& Value : *Findings)
+				{
+					const TSharedPtr<FJsonObject>& FindingObject = Value->AsObject();
+					if (!FindingObject)
+					{
+						continue;
+					}
+
+					FCommonValidatorsFinding& Finding = Record.Findings.AddDefaulted_GetRef();
+					Finding.Severity = SeverityFromString(FindingObject->GetStringField(TEXT("severity")));
+					Finding.Message = FindingObject->GetStringField(TEXT("message"));
+					Finding.GraphName = FName(*FindingObject->GetStringField(TEXT("graph")));
+					FGuid::Parse(FindingObject->GetStringField(TEXT("node")), Finding.NodeGuid);
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+void FCommonValidatorsReportWriter::SortAndDeduplicate(TArray<FCommonValidatorsResultRecord>& Records)
+{
+	using namespace UE::Internal::ReportHelpers;
+
+	Records.StableSort([](const FCommonValidatorsResultRecord& A, const FCommonValidatorsResultRecord& B)
+	{
+		const int32 AssetCompare = A.AssetPath.Compare(B.AssetPath);
+		return AssetCompare != 0 ? AssetCompare < 0 : A.Validator < B.Validator;
+	});
+
+	int32 WriteIndex = 0;
+	for (int32 ReadIndex = 0; ReadIndex < Records.Num(); ++ReadIndex)
+	{
+		if (WriteIndex > 0 && Records[WriteIndex - 1].AssetPath == Records[ReadIndex].AssetPath && Records[WriteIndex - 1].Validator == Records[ReadIndex].Validator)
+		{
+			// Same asset validated by more than one shard (e.g. a rerun), keep the worst result and every distinct finding.
+			FCommonValidatorsResultRecord& Kept = Records[WriteIndex - 1];
+			Kept.Result = CombineDataValidationResults(Kept.Result, Records[ReadIndex].Result);
+			Kept.Findings.Append(MoveTemp(Records[ReadIndex].Findings));
+			continue;
+		}
+
+		if (WriteIndex != ReadIndex)
+		{
+			Records[WriteIndex] = MoveTemp(Records[ReadIndex]);
+		}
+		++WriteIndex;
+	}
+	Records.SetNum(WriteIndex);
+
+	for (FCommonValidatorsResultRecord& Record : Records)
+	{
+		Record.Findings.Sort(FindingLess);
+		for (int32 Index = Record.Findings.Num() - 1; Index > 0; --Index)
+		{
+			if (FindingEquals(Record.Findings[Index], Record.Findings[Index - 1]))
+			{
+				Record.Findings.RemoveAt(Index, 1, EAllowShrinking::No);
+			}
+		}
+	}
+}
+
+bool FCommonValidatorsReportWriter::WriteSarif(const FString& Path, const TArray<FCommonValidatorsResultRecord>& Records)
+{
+	using namespace UE::Internal::ReportHelpers;
+
+	TArray<FString> RuleIds;
+	for (const FCommonValidatorsResultRecord& Record : Records)
+	{
+		RuleIds.AddUnique(Record.Validator);
+	}
+	RuleIds.Sort();
+
+	FString Output;
+	TSharedRef<TJsonWriter<>> Json = TJsonWriterFactory<>::Create(&Output);
+	Json->WriteObjectStart();
+	Json->WriteValue(TEXT("$schema"), TEXT("https://json.schemastore.org/sarif-2.1.0.json"));
+	Json->WriteValue(TEXT("version"), TEXT("2.1.0"));
+	Json->WriteArrayStart(TEXT("runs"));
+	Json->WriteObjectStart();
+
+	Json->WriteObjectStart(TEXT("tool"));
+	Json->WriteObjectStart(TEXT("driver"));
+	Json->WriteValue(TEXT("name"), TEXT("CommonValidators"));
+	Json->WriteArrayStart(TEXT("rules"));
+	for (const FString& RuleId : RuleIds)
+	{
+		Json->WriteObjectStart();
+		Json->WriteValue(TEXT("id"), RuleId);
+		Json->WriteObjectEnd();
+	}
+	Json->WriteArrayEnd();
+	Json->WriteObjectEnd();
+	Json->WriteObjectEnd();
+
+	Json->WriteArrayStart(TEXT("results"));
+	for (const FCommonValidatorsResultRecord& Record : Records)
+	{
+		const int32 RuleIndex = RuleIds.IndexOfByKey(Record.Validator);
+		for (const FCommonValidatorsFinding& Finding : Record.Findings)
+		{
+			Json->WriteObjectStart();
+			Json->WriteValue(TEXT("ruleId"), Record.Validator);
+			Json->WriteValue(TEXT("ruleIndex"), RuleIndex);
+			Json->WriteValue(TEXT("level"), SeverityToSarifLevel(Finding.Severity));
+
+			Json->WriteObjectStart(TEXT("message"));
+			Json->WriteValue(TEXT("text"), Finding.Message);
+			Json->WriteObjectEnd();
+
+			Json->WriteArrayStart(TEXT("locations"));
+			Json->WriteObjectStart();
+			Json->WriteObjectStart(TEXT("physicalLocation"));
+			Json->WriteObjectStart(TEXT("artifactLocation"));
+			Json->WriteValue(TEXT("uri"), FPackageName::ObjectPathToPackageName(Record.AssetPath));
+			Json->WriteObjectEnd();
+			Json->WriteObjectEnd();
+			Json->WriteArrayStart(TEXT("logicalLocations"));
+			Json->WriteObjectStart();
+			Json->WriteValue(TEXT("fullyQualifiedName"), FString::Printf(TEXT("%s:%s:%s"), *Record.AssetPath, *Finding.GraphName.ToString(), *Finding.NodeGuid.ToString(EGuidFormats::DigitsWithHyphens)));
+			Json->WriteObjectEnd();
+			Json->WriteArrayEnd();
+			Json->WriteObjectEnd();
+			Json->WriteArrayEnd();
+
+			Json->WriteObjectEnd();
+		}
+	}
+	Json->WriteArrayEnd();
+
+	Json->WriteObjectEnd();
+	Json->WriteArrayEnd();
+	Json->WriteObjectEnd();
+	Json->Close();
+
+	if (!FFileHelper::SaveStringToFile(Output, *Path, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		UE_LOG(LogCommonValidators, Error, TEXT("Failed to write %s."), *Path);
+		return false;
+	}
+	return true;
+}
+
+bool FCommonValidatorsReportWriter::WriteTickCostRanking(const FString& Path, TArray<FCommonValidatorsTickCostRecord> Records)
+{
+	Records.Sort([](const FCommonValidatorsTickCostRecord& A, const FCommonValidatorsTickCostRecord& B)
+	{
+		if (A.TickCost != B.TickCost)
+		{
+			return A.TickCost > B.TickCost;
+		}
+		if (A.ConstructionScriptCost != B.ConstructionScriptCost)
+		{
+			return A.ConstructionScriptCost > B.ConstructionScriptCost;
+		}
+		return A.AssetPath < B.AssetPath;
+	});
+
+	FString Output;
+	if (FPaths::GetExtension(Path).Equals(TEXT("csv"), ESearchCase::IgnoreCase))
+	{
+		Output = TEXT("Asset,BudgetClass,TickCost,TickBudget,ConstructionScriptCost,ConstructionScriptBudget\n");
+		for (const FCommonValidatorsTickCostRecord& Record : Records)
+		{
+			Output += FString::Printf(TEXT("%s,%s,%.1f,%.1f,%.1f,%.1f\n"), *Record.AssetPath, *Record.BudgetClassName.ToString(),
+				Record.TickCost, Record.TickBudget, Record.ConstructionScriptCost, Record.ConstructionScriptBudget);
+		}
+	}
+	else
+	{
+		TSharedRef<TJsonWriter<>> Json = TJsonWriterFactory<>::Create(&Output);
+		Json->WriteArrayStart();
+		for (const FCommonValidatorsTickCostRecord& Record : Records)
+		{
+			Json->WriteObjectStart();
+			Json->WriteValue(TEXT("asset"), Record.AssetPath);
+			Json->WriteValue(TEXT("budgetClass"), Record.BudgetClassName.ToString());
+			Json->WriteValue(TEXT("tickCost"), Record.TickCost);
+			Json->WriteValue(TEXT("tickBudget"), Record.TickBudget);
+			Json->WriteValue(TEXT("constructionScriptCost"), Record.ConstructionScriptCost);
+			Json->WriteValue(TEXT("constructionScriptBudget"), Record.ConstructionScriptBudget);
+			Json->WriteObjectEnd();
+		}
+		Json->WriteArrayEnd();
+		Json->Close();
+	}
+
+	if (!FFileHelper::SaveStringToFile(Output, *Path, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		UE_LOG(LogCommonValidators, Error, TEXT("Failed to write %s."), *Path);
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CommonValidatorsFinding.h"
+#include "Misc/DataValidation.h"
+
+class FJsonObject;
+
+// Result of one validator on one Blueprint. Messages are final, "{Node}" has already been substituted.
+struct FCommonValidatorsResultRecord
+{
+	FString AssetPath;
+	FString Validator;
+	EDataValidationResult Result = EDataValidationResult::NotValidated;
+	TArray<FCommonValidatorsFinding> Findings;
+};
+
+// Estimated Tick and construction script cost of one Blueprint, see UEditorValidator_TickCost.
+struct FCommonValidatorsTickCostRecord
+{
+	FString AssetPath;
+	FName BudgetClassName;
+	float TickCost = 0.0f;
+	float TickBudget = 0.0f;
+	float ConstructionScriptCost = 0.0f;
+	float ConstructionScriptBudget = 0.0f;
+};
+
+// Written once per result file, so a merge can tell which shards it got.
+struct FCommonValidatorsShardInfo
+{
+	int32 Shard = 0;
+	int32 NumShards = 1;
+	int32 NumValidated = 0;
+};
+
+/**
+ * Result files of the validation commandlet. Records are streamed to a JSON-lines file as they are produced,
+ * one object per line, so shards can be concatenated and merged without holding the whole file in memory twice.
+ */
+class COMMONVALIDATORS_API FCommonValidatorsReportWriter
+{
+public:
+	~FCommonValidatorsReportWriter();
+
+	bool Open(const FString& Path);
+	void Close();
+
+	void WriteShardInfo(const FCommonValidatorsShardInfo& ShardInfo);
+	void WriteRecord(const FCommonValidatorsResultRecord& Record);
+
+	// Pushes what was written so far to disk, for files read while they are still being written.
+	void Flush();
+
+	static bool ReadJsonLines(const FString& Path, TArray<FCommonValidatorsShardInfo>& OutShards, TArray<FCommonValidatorsResultRecord>& OutRecords);
+
+	// Sorts records by asset and validator and merges duplicates, so merged reports don't depend on shard order.
+	static void SortAndDeduplicate(TArray<FCommonValidatorsResultRecord>& Records);
+
+	// Writes a SARIF 2.1.0 log, with one rule per validator.
+	static bool WriteSarif(const FString& Path, const TArray<FCommonValidatorsResultRecord>& Records);
+
+	// Ranks Blueprints by decreasing Tick cost. Writes CSV for a .csv path and a JSON array otherwise.
+	static bool WriteTickCostRanking(const FString& Path, TArray<FCommonValidatorsTickCostRecord> Records);
+
+private:
+	void WriteLine(const TSharedRef<FJsonObject>& Object);
+
+	TUniquePtr<FArchive> Writer;
+};
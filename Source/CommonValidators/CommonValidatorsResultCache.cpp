@@ -0,0 +1,227 @@
+#include "CommonValidatorsResultCache.h"
+
+#include "CommonValidatorsLog.h"
+#include "Editor.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Crc.h"
+#include "Misc/Paths.h"
+#include "Serialization/NameAsStringProxyArchive.h"
+
+namespace UE::Internal::ResultCacheHelpers
+{
+	static constexpr uint32 FileMagic = 0x43565243; // "CVRC"
+
+	// Bump whenever the file layout or FCommonValidatorsFinding changes.
+	static constexpr int32 FileVersion = 2;
+
+	// Processes writing the cache at the same time are rare, this only has to outlast one of them merging and writing.
+	static constexpr double FileLockTimeoutSeconds = 30.0;
+
+	// Named after the cache file, so editors of different projects don't wait on each other.
+	static FString GetFileLockName(const FString& FilePath)
+	{
+		return FString::Printf(TEXT("CommonValidatorsResultCache_%08X"), FCrc::StrCrc32(*FPaths::ConvertRelativePathToFull(FilePath).ToLower()));
+	}
+
+	static FAutoConsoleCommand ClearCommand(
+		TEXT("CommonValidators.ClearResultCache"),
+		TEXT("Drops every cached validation result, forcing all Blueprints to be analyzed again."),
+		FConsoleCommandDelegate::CreateLambda([]()
+		{
+			FCommonValidatorsResultCache::Get().Clear();
+		}));
+}
+
+FCommonValidatorsResultCache& FCommonValidatorsResultCache::Get()
+{
+	static FCommonValidatorsResultCache Instance;
+	return Instance;
+}
+
+void FCommonValidatorsResultCache::Initialize()
+{
+	PostAssetValidationHandle = FEditorDelegates::OnPostAssetValidation.AddRaw(this, &FCommonValidatorsResultCache::Flush);
+}
+
+void FCommonValidatorsResultCache::Shutdown()
+{
+	FEditorDelegates::OnPostAssetValidation.Remove(PostAssetValidationHandle);
+	Flush();
+}
+
+FString FCommonValidatorsResultCache::GetCacheFilePath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("CommonValidators") / TEXT("ResultCache.bin");
+}
+
+bool FCommonValidatorsResultCache::Find(const FString& AssetPath, FName ValidatorName, uint32 SettingsHash, uint64 ContentHash, EDataValidationResult& OutResult, TArray<FCommonValidatorsFinding>& OutFindings)
+{
+	FScopeLock ScopeLock(&Lock);
+	LoadIfNeeded();
+
+	const FEntry* Entry = Entries.Find(FKey(AssetPath, ValidatorName));
+	if (!Entry || Entry->SettingsHash != SettingsHash || Entry->ContentHash != ContentHash)
+	{
+		return false;
+	}
+
+	OutResult = Entry->Result;
+	OutFindings = Entry->Findings;
+	return true;
+}
+
+void FCommonValidatorsResultCache::Store(const FString& AssetPath, FName ValidatorName, uint32 SettingsHash, uint64 ContentHash, EDataValidationResult Result, const TArray<FCommonValidatorsFinding>& Findings)
+{
+	FScopeLock ScopeLock(&Lock);
+	LoadIfNeeded();
+
+	// One entry per asset and validator, a new result replaces whatever was computed for older content.
+	FEntry& Entry = Entries.FindOrAdd(FKey(AssetPath, ValidatorName));
+	Entry.SettingsHash = SettingsHash;
+	Entry.ContentHash = ContentHash;
+	Entry.Result = Result;
+	Entry.Findings = Findings;
+	DirtyKeys.Add(FKey(AssetPath, ValidatorName));
+}
+
+void FCommonValidatorsResultCache::Clear()
+{
+	using namespace UE::Internal::ResultCacheHelpers;
+
+	FScopeLock ScopeLock(&Lock);
+	Entries.Reset();
+	DirtyKeys.Reset();
+	bLoaded = true;
+
+	const FString FilePath = GetCacheFilePath();
+	FSystemWideCriticalSection FileLock(GetFileLockName(FilePath), FTimespan::FromSeconds(FileLockTimeoutSeconds));
+	IFileManager::Get().Delete(*FilePath, false, false, true);
+}
+
+void FCommonValidatorsResultCache::LoadIfNeeded()
+{
+	if (bLoaded)
+	{
+		return;
+	}
+	bLoaded = true;
+
+	ReadFile(GetCacheFilePath(), Entries);
+}
+
+bool FCommonValidatorsResultCache::ReadFile(const FString& FilePath, TMap<FKey, FEntry>& OutEntries)
+{
+	using namespace UE::Internal::ResultCacheHelpers;
+
+	TUniquePtr<FArchive> FileReader(IFileManager::Get().CreateFileReader(*FilePath, FILEREAD_Silent));
+	if (!FileReader)
+	{
+		return false;
+	}
+
+	FNameAsStringProxyArchive Ar(*FileReader);
+
+	uint32 Magic = 0;
+	int32 Version = 0;
+	Ar << Magic << Version;
+	if (Magic != FileMagic || Version != FileVersion)
+	{
+		UE_LOG(LogCommonValidators, Display, TEXT("Ignoring outdated validation result cache %s."), *FilePath);
+		return false;
+	}
+
+	int32 NumEntries = 0;
+	Ar << NumEntries;
+	TMap<FKey, FEntry> FileEntries;
+	FileEntries.Reserve(NumEntries);
+	for (int32 Index = 0; Index < NumEntries && !Ar.IsError(); ++Index)
+	{
+		FKey Key;
+		FEntry Entry;
+		Ar << Key.Get<0>() << Key.Get<1>();
+		Ar << Entry.SettingsHash << Entry.ContentHash;
+		Ar << reinterpret_cast<uint8&>(Entry.Result);
+		Ar << Entry.Findings;
+		FileEntries.Add(MoveTemp(Key), MoveTemp(Entry));
+	}
+
+	if (Ar.IsError())
+	{
+		UE_LOG(LogCommonValidators, Warning, TEXT("Validation result cache %s is corrupt, starting from scratch."), *FilePath);
+		return false;
+	}
+
+	OutEntries.Append(MoveTemp(FileEntries));
+	return true;
+}
+
+bool FCommonValidatorsResultCache::WriteFile(const FString& FilePath, TMap<FKey, FEntry>& InEntries)
+{
+	using namespace UE::Internal::ResultCacheHelpers;
+
+	// Write to a temporary file first so an interrupted editor never leaves a truncated cache behind.
+	const FString TempFilePath = FString::Printf(TEXT("%s.%u.tmp"), *FilePath, FPlatformProcess::GetCurrentProcessId());
+	{
+		TUniquePtr<FArchive> FileWriter(IFileManager::Get().CreateFileWriter(*TempFilePath));
+		if (!FileWriter)
+		{
+			return false;
+		}
+
+		FNameAsStringProxyArchive Ar(*FileWriter);
+
+		uint32 Magic = FileMagic;
+		int32 Version = FileVersion;
+		int32 NumEntries = InEntries.Num();
+		Ar << Magic << Version << NumEntries;
+
+		for (TPair<FKey, FEntry>& Pair : InEntries)
+		{
+			Ar << Pair.Key.Get<0>() << Pair.Key.Get<1>();
+			Ar << Pair.Value.SettingsHash << Pair.Value.ContentHash;
+			Ar << reinterpret_cast<uint8&>(Pair.Value.Result);
+			Ar << Pair.Value.Findings;
+		}
+	}
+
+	return IFileManager::Get().Move(*FilePath, *TempFilePath);
+}
+
+void FCommonValidatorsResultCache::Flush()
+{
+	using namespace UE::Internal::ResultCacheHelpers;
+
+	FScopeLock ScopeLock(&Lock);
+	if (DirtyKeys.IsEmpty())
+	{
+		return;
+	}
+
+	// Other processes may have flushed since the file was loaded. Their entries are merged in, ours win where both
+	// stored a result, and nobody else writes between reading and replacing the file.
+	const FString FilePath = GetCacheFilePath();
+	FSystemWideCriticalSection FileLock(GetFileLockName(FilePath), FTimespan::FromSeconds(FileLockTimeoutSeconds));
+	if (!FileLock.IsValid())
+	{
+		UE_LOG(LogCommonValidators, Warning, TEXT("Timed out waiting for another process to write validation result cache %s, will retry on the next flush."), *FilePath);
+		return;
+	}
+
+	TMap<FKey, FEntry> Merged;
+	ReadFile(FilePath, Merged);
+	for (const FKey& Key : DirtyKeys)
+	{
+		Merged.Add(Key, Entries.FindChecked(Key));
+	}
+
+	if (!WriteFile(FilePath, Merged))
+	{
+		UE_LOG(LogCommonValidators, Warning, TEXT("Failed to write validation result cache %s."), *FilePath);
+		return;
+	}
+
+	Entries = MoveTemp(Merged);
+	DirtyKeys.Reset();
+}
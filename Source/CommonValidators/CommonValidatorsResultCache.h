@@ -0,0 +1,57 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CommonValidatorsFinding.h"
+#include "Misc/DataValidation.h"
+
+/**
+ * Persistent cache of validator results, stored under Saved/CommonValidators. Each asset/validator pair keeps
+ * the result of its last run together with the hashes it was computed from: the validator's settings hash and
+ * the content hash of the Blueprint's graphs. A lookup only hits while both still match.
+ * Several processes may share the file, e.g. commandlet shards: a flush merges the entries stored since the
+ * last one into what is on disk, under a system-wide lock.
+ */
+class COMMONVALIDATORS_API FCommonValidatorsResultCache
+{
+public:
+	static FCommonValidatorsResultCache& Get();
+
+	void Initialize();
+	void Shutdown();
+
+	bool Find(const FString& AssetPath, FName ValidatorName, uint32 SettingsHash, uint64 ContentHash, EDataValidationResult& OutResult, TArray<FCommonValidatorsFinding>& OutFindings);
+	void Store(const FString& AssetPath, FName ValidatorName, uint32 SettingsHash, uint64 ContentHash, EDataValidationResult Result, const TArray<FCommonValidatorsFinding>& Findings);
+
+	// Writes the cache to disk if anything changed since the last flush.
+	void Flush();
+
+	// Drops every entry, both in memory and on disk.
+	void Clear();
+
+private:
+	struct FEntry
+	{
+		uint32 SettingsHash = 0;
+		uint64 ContentHash = 0;
+		EDataValidationResult Result = EDataValidationResult::NotValidated;
+		TArray<FCommonValidatorsFinding> Findings;
+	};
+
+	using FKey = TTuple<FString, FName>;
+
+	void LoadIfNeeded();
+	static FString GetCacheFilePath();
+
+	// Adds the entries of the file to OutEntries. False if it is missing, outdated or corrupt, OutEntries is left untouched then.
+	static bool ReadFile(const FString& FilePath, TMap<FKey, FEntry>& OutEntries);
+	static bool WriteFile(const FString& FilePath, TMap<FKey, FEntry>& Entries);
+
+	FCriticalSection Lock;
+	TMap<FKey, FEntry> Entries;
+
+	// Entries stored since the last flush, the only ones this process overwrites on disk.
+	TSet<FKey> DirtyKeys;
+	bool bLoaded = false;
+
+	FDelegateHandle PostAssetValidationHandle;
+};
@@ -9,6 +9,13 @@
 #include "EdGraph/EdGraph.h"
 #include "EdGraph/EdGraphNode.h"
 #include "ScopedTransaction.h"
+#include "EditorValidatorSubsystem.h"
+#include "CommonValidatorsAssetTags.h"
+#include "CommonValidatorsFixer.h"
+#include "CommonValidatorsLog.h"
+#include "EditorValidator_PureNode.h"
+#include "Editor.h"
+#include "Engine/Blueprint.h"
 
 void UCommonValidatorsStatics::OpenBlueprintAndFocusNode(UBlueprint* Blueprint, UEdGraph* Graph, UEdGraphNode* Node)
 {
@@ -52,3 +59,56 @@ void UCommonValidatorsStatics::DeleteNodeFromBlueprint(UBlueprint* Blueprint, UE
     // Mark Blueprint as structurally modified (will trigger recompilation)
     FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
 }
+
+
+void UCommonValidatorsStatics::CachePureNodeInVariable(UBlueprint* Blueprint, UEdGraph* Graph, UEdGraphNode* Node)
+{
+    if (!Blueprint || !Graph || !Node) return;
+
+    const FScopedTransaction Transaction(NSLOCTEXT("CommonValidators", "CachePureNode", "Cache Pure Node in Variable"));
+
+    if (UEditorValidator_PureNode::CacheInVariable(Blueprint, Node))
+    {
+        FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+    }
+    else
+    {
+        UE_LOG(LogCommonValidators, Warning, TEXT("%s can no longer be cached in a variable, validate the Blueprint again."), *Node->GetNodeTitle(ENodeTitleType::MenuTitle).ToString());
+    }
+}
+
+int32 UCommonValidatorsStatics::ValidateAssetsSkippingClean(const TArray<FAssetData>& Assets)
+{
+    UEditorValidatorSubsystem* ValidatorSubsystem = GEditor ? GEditor->GetEditorSubsystem<UEditorValidatorSubsystem>() : nullptr;
+    if (!ValidatorSubsystem) return 0;
+
+    // Only Blueprints carry our tags, everything else is left to the other validators
+    TArray<FAssetData> AssetsToValidate;
+    TArray<FAssetData> Blueprints;
+    for (const FAssetData& AssetData : Assets)
+    {
+        (AssetData.IsInstanceOf(UBlueprint::StaticClass()) ? Blueprints : AssetsToValidate).Add(AssetData);
+    }
+    FCommonValidatorsAssetTags::FilterAssetsNeedingLoad(Blueprints, AssetsToValidate);
+
+    UE_LOG(LogCommonValidators, Display, TEXT("Skipping %d clean Blueprints, validating %d of %d assets."), Assets.Num() - AssetsToValidate.Num(), AssetsToValidate.Num(), Assets.Num());
+
+    FValidateAssetsSettings Settings;
+    Settings.ValidationUsecase = EDataValidationUsecase::Script;
+    Settings.bShowIfNoFailures = false;
+
+    FValidateAssetsResults Results;
+    ValidatorSubsystem->ValidateAssetsWithSettings(AssetsToValidate, Settings, Results);
+    return Results.NumInvalid;
+}
+
+
+int32 UCommonValidatorsStatics::FixAssets(const TArray<FAssetData>& Assets, bool bSave)
+{
+    TArray<FAssetData> AssetsToFix;
+    FCommonValidatorsAssetTags::FilterAssetsNeedingLoad(Assets, AssetsToFix);
+
+    UE_LOG(LogCommonValidators, Display, TEXT("Skipping %d clean assets, fixing %d of %d assets."), Assets.Num() - AssetsToFix.Num(), AssetsToFix.Num(), Assets.Num());
+
+    return FCommonValidatorsFixer::FixAssets(AssetsToFix, bSave);
+}
@@ -19,4 +19,20 @@ public:
 
     UFUNCTION()
     static void DeleteNodeFromBlueprint(UBlueprint* Blueprint, UEdGraph* Graph, UEdGraphNode* Node);
+
+    UFUNCTION()
+    static void CachePureNodeInVariable(UBlueprint* Blueprint, UEdGraph* Graph, UEdGraphNode* Node);
+
+    // Runs data validation on the given assets, skipping Blueprints whose asset registry tags show they are clean
+    // (those are not seen by any other validator either).
+    // Returns the number of assets that failed validation.
+    UFUNCTION(BlueprintCallable, Category = "Common Validators")
+    static int32 ValidateAssetsSkippingClean(const TArray<FAssetData>& Assets);
+
+    // Applies every fix the validators offer on the given assets (removing empty Tick nodes, caching repeated pure
+    // calls in variables), with a single recompile and save per Blueprint. Clean Blueprints are skipped the same
+    // way as above.
+    // Returns the number of fixes applied.
+    UFUNCTION(BlueprintCallable, Category = "Common Validators")
+    static int32 FixAssets(const TArray<FAssetData>& Assets, bool bSave = true);
 };
\ No newline at end of file
@@ -0,0 +1,289 @@
+#include "CommonValidatorsSyntheticBlueprint.h"
+
+#include "EdGraph/EdGraph.h"
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "GameFramework/Actor.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_CustomEvent.h"
+#include "K2Node_Event.h"
+#include "K2Node_MacroInstance.h"
+#include "Kismet/KismetSystemLibrary.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "UObject/Package.h"
+
+namespace UE::Internal::SyntheticBlueprintHelpers
+{
+	// Actor functions that aren't allowlisted by default, so the Pure Node validator has to analyze them.
+	static const FName GetTickIntervalName(TEXT("GetActorTickInterval"));
+	static const FName SetTickIntervalName(TEXT("SetActorTickInterval"));
+	static const FName TickIntervalPinName(TEXT("TickInterval"));
+	static const FName GetOwnerName(TEXT("GetOwner"));
+	static const FName SetOwnerName(TEXT("SetOwner"));
+	static const FName NewOwnerPinName(TEXT("NewOwner"));
+	static const FName LoadAssetBlockingName(TEXT("LoadAsset_Blocking"));
+	static const FName ReceiveTickName(TEXT("ReceiveTick"));
+	static const FName ForLoopName(TEXT("ForLoop"));
+	static const FName LoopBodyPinName(TEXT("LoopBody"));
+	static const FName CompletedPinName(TEXT("Completed"));
+
+	static constexpr int32 FanOut = 64;
+	static constexpr int32 ChainDepth = 64;
+	static constexpr int32 BlockingLoadInterval = 100;
+
+	static const TCHAR* StandardMacrosPath = TEXT("/Engine/EditorBlueprintResources/StandardMacros.StandardMacros");
+
+	static UEdGraphPin* FindExecPin(UEdGraphNode* Node, EEdGraphPinDirection Direction)
+	{
+		for (UEdGraphPin* Pin : Node->Pins)
+		{
+			if (Pin->Direction == Direction && Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec)
+			{
+				return Pin;
+			}
+		}
+		return nullptr;
+	}
+
+	class FGraphBuilder
+	{
+	public:
+		FGraphBuilder(UEdGraph* InGraph)
+			: Graph(InGraph)
+		{
+		}
+
+		int32 Num() const
+		{
+			return Graph->Nodes.Num();
+		}
+
+		UK2Node_CallFunction* AddCall(FName FunctionName, UClass* Class = AActor::StaticClass())
+		{
+			UFunction* Function = Class->FindFunctionByName(FunctionName);
+			check(Function);
+
+			FGraphNodeCreator<UK2Node_CallFunction> Creator(*Graph);
+			UK2Node_CallFunction* Node = Creator.CreateNode(false);
+			Node->SetFromFunction(Function);
+			Creator.Finalize();
+			return Node;
+		}
+
+		// Starts a new exec chain.
+		void AddCustomEvent()
+		{
+			FGraphNodeCreator<UK2Node_CustomEvent> Creator(*Graph);
+			UK2Node_CustomEvent* Node = Creator.CreateNode(false);
+			Node->CustomFunctionName = *FString::Printf(TEXT("SyntheticEvent_%d"), NumEvents++);
+			Creator.Finalize();
+			ExecCursor = FindExecPin(Node, EGPD_Output);
+		}
+
+		void AddTickEvent()
+		{
+			FGraphNodeCreator<UK2Node_Event> Creator(*Graph);
+			UK2Node_Event* Node = Creator.CreateNode(false);
+			Node->EventReference.SetExternalMember(ReceiveTickName, AActor::StaticClass());
+			Node->bOverrideFunction = true;
+			Creator.Finalize();
+			ExecCursor = FindExecPin(Node, EGPD_Output);
+		}
+
+		UK2Node_MacroInstance* AddForLoop()
+		{
+			if (!ForLoopGraph)
+			{
+				const UBlueprint* StandardMacros = LoadObject<UBlueprint>(nullptr, StandardMacrosPath);
+				check(StandardMacros);
+				const TObjectPtr<UEdGraph>* Found = StandardMacros->MacroGraphs.FindByPredicate([](const UEdGraph* MacroGraph) { return MacroGraph->GetFName() == ForLoopName; });
+				check(Found);
+				ForLoopGraph = *Found;
+			}
+
+			FGraphNodeCreator<UK2Node_MacroInstance> Creator(*Graph);
+			UK2Node_MacroInstance* Node = Creator.CreateNode(false);
+			Node->SetMacroGraph(ForLoopGraph);
+			Creator.Finalize();
+			return Node;
+		}
+
+		// Appends an impure node to the current exec chain, continuing from ThenPin (its first exec output by default).
+		void Then(UEdGraphNode* Node, UEdGraphPin* ThenPin = nullptr)
+		{
+			if (ExecCursor)
+			{
+				ExecCursor->MakeLinkTo(FindExecPin(Node, EGPD_Input));
+			}
+			ExecCursor = ThenPin ? ThenPin : FindExecPin(Node, EGPD_Output);
+		}
+
+		static void Link(UEdGraphNode* From, FName FromPin, UEdGraphNode* To, FName ToPin)
+		{
+			From->FindPinChecked(FromPin)->MakeLinkTo(To->FindPinChecked(ToPin));
+		}
+
+	private:
+		UEdGraph* Graph = nullptr;
+		UEdGraph* ForLoopGraph = nullptr;
+		UEdGraphPin* ExecCursor = nullptr;
+		int32 NumEvents = 0;
+	};
+
+	static void BuildWideFanOut(FGraphBuilder& Builder, int32 NumNodes)
+	{
+		Builder.AddCustomEvent();
+		while (Builder.Num() < NumNodes)
+		{
+			UK2Node_CallFunction* Getter = Builder.AddCall(GetTickIntervalName);
+			for (int32 Index = 0; Index < FanOut && Builder.Num() < NumNodes; ++Index)
+			{
+				UK2Node_CallFunction* Setter = Builder.AddCall(SetTickIntervalName);
+				Builder.Then(Setter);
+				FGraphBuilder::Link(Getter, UEdGraphSchema_K2::PN_ReturnValue, Setter, TickIntervalPinName);
+			}
+		}
+	}
+
+	static void BuildDeepPureChain(FGraphBuilder& Builder, int32 NumNodes)
+	{
+		Builder.AddCustomEvent();
+		while (Builder.Num() < NumNodes)
+		{
+			UK2Node_CallFunction* Last = nullptr;
+			for (int32 Depth = 0; Depth < ChainDepth && Builder.Num() < NumNodes; ++Depth)
+			{
+				UK2Node_CallFunction* Getter = Builder.AddCall(GetOwnerName);
+				if (Last)
+				{
+					FGraphBuilder::Link(Last, UEdGraphSchema_K2::PN_ReturnValue, Getter, UEdGraphSchema_K2::PN_Self);
+				}
+				Last = Getter;
+			}
+
+			// Reading the end of the chain twice re-evaluates all of it.
+			for (int32 Index = 0; Index < 2; ++Index)
+			{
+				UK2Node_CallFunction* Setter = Builder.AddCall(SetOwnerName);
+				Builder.Then(Setter);
+				FGraphBuilder::Link(Last, UEdGraphSchema_K2::PN_ReturnValue, Setter, NewOwnerPinName);
+			}
+		}
+	}
+
+	static void BuildManyEvents(FGraphBuilder& Builder, int32 NumNodes)
+	{
+		while (Builder.Num() < NumNodes)
+		{
+			Builder.AddCustomEvent();
+			UK2Node_CallFunction* Getter = Builder.AddCall(GetTickIntervalName);
+			UK2Node_CallFunction* Setter = Builder.AddCall(SetTickIntervalName);
+			Builder.Then(Setter);
+			FGraphBuilder::Link(Getter, UEdGraphSchema_K2::PN_ReturnValue, Setter, TickIntervalPinName);
+		}
+	}
+
+	static void BuildLoops(FGraphBuilder& Builder, int32 NumNodes)
+	{
+		Builder.AddCustomEvent();
+		while (Builder.Num() < NumNodes)
+		{
+			UK2Node_MacroInstance* Loop = Builder.AddForLoop();
+			UK2Node_CallFunction* Getter = Builder.AddCall(GetTickIntervalName);
+			UK2Node_CallFunction* Setter = Builder.AddCall(SetTickIntervalName);
+			Loop->FindPinChecked(LoopBodyPinName)->MakeLinkTo(FindExecPin(Setter, EGPD_Input));
+			FGraphBuilder::Link(Getter, UEdGraphSchema_K2::PN_ReturnValue, Setter, TickIntervalPinName);
+			Builder.Then(Loop, Loop->FindPinChecked(CompletedPinName));
+		}
+	}
+
+	static void BuildDenseTick(FGraphBuilder& Builder, int32 NumNodes)
+	{
+		Builder.AddTickEvent();
+		for (int32 Step = 0; Builder.Num() < NumNodes; ++Step)
+		{
+			if (Step % BlockingLoadInterval == BlockingLoadInterval - 1)
+			{
+				Builder.Then(Builder.AddCall(LoadAssetBlockingName, UKismetSystemLibrary::StaticClass()));
+				continue;
+			}
+
+			UK2Node_CallFunction* Getter = Builder.AddCall(GetTickIntervalName);
+			UK2Node_CallFunction* Setter = Builder.AddCall(SetTickIntervalName);
+			Builder.Then(Setter);
+			FGraphBuilder::Link(Getter, UEdGraphSchema_K2::PN_ReturnValue, Setter, TickIntervalPinName);
+		}
+	}
+} // namespace UE::Internal::SyntheticBlueprintHelpers
+
+
+const TCHAR* LexToString(ECommonValidatorsSyntheticShape Shape)
+{
+	switch (Shape)
+	{
+	case ECommonValidatorsSyntheticShape::WideFanOut:
+		return TEXT("WideFanOut");
+	case ECommonValidatorsSyntheticShape::DeepPureChain:
+		return TEXT("DeepPureChain");
+	case ECommonValidatorsSyntheticShape::ManyEvents:
+		return TEXT("ManyEvents");
+	case ECommonValidatorsSyntheticShape::Loops:
+		return TEXT("Loops");
+	case ECommonValidatorsSyntheticShape::DenseTick:
+		return TEXT("DenseTick");
+	default:
+		return TEXT("Unknown");
+	}
+}
+
+bool LexTryParseString(ECommonValidatorsSyntheticShape& OutShape, const TCHAR* String)
+{
+	for (uint8 Index = 0; Index < static_cast<uint8>(ECommonValidatorsSyntheticShape::Count); ++Index)
+	{
+		const ECommonValidatorsSyntheticShape Shape = static_cast<ECommonValidatorsSyntheticShape>(Index);
+		if (FCString::Stricmp(String, LexToString(Shape)) == 0)
+		{
+			OutShape = Shape;
+			return true;
+		}
+	}
+	return false;
+}
+
+UBlueprint* FCommonValidatorsSyntheticBlueprint::Generate(ECommonValidatorsSyntheticShape Shape, int32 NumNodes)
+{
+	using namespace UE::Internal::SyntheticBlueprintHelpers;
+
+	check(IsInGameThread());
+
+	UPackage* Package = GetTransientPackage();
+	const FName Name = MakeUniqueObjectName(Package, UBlueprint::StaticClass(), *FString::Printf(TEXT("BP_Synthetic_%s_%d"), LexToString(Shape), NumNodes));
+	UBlueprint* Blueprint = FKismetEditorUtilities::CreateBlueprint(AActor::StaticClass(), Package, Name, BPTYPE_Normal, UBlueprint::StaticClass(), UBlueprintGeneratedClass::StaticClass());
+
+	FGraphBuilder Builder(FBlueprintEditorUtils::FindEventGraph(Blueprint));
+	switch (Shape)
+	{
+	case ECommonValidatorsSyntheticShape::WideFanOut:
+		BuildWideFanOut(Builder, NumNodes);
+		break;
+	case ECommonValidatorsSyntheticShape::DeepPureChain:
+		BuildDeepPureChain(Builder, NumNodes);
+		break;
+	case ECommonValidatorsSyntheticShape::ManyEvents:
+		BuildManyEvents(Builder, NumNodes);
+		break;
+	case ECommonValidatorsSyntheticShape::Loops:
+		BuildLoops(Builder, NumNodes);
+		break;
+	case ECommonValidatorsSyntheticShape::DenseTick:
+		BuildDenseTick(Builder, NumNodes);
+		break;
+	default:
+		checkNoEntry();
+		break;
+	}
+
+	return Blueprint;
+}
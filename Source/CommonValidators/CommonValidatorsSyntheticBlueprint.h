@@ -0,0 +1,35 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UBlueprint;
+
+// Graph shapes the validators are sensitive to.
+enum class ECommonValidatorsSyntheticShape : uint8
+{
+	// Few pure getters, each read by many impure nodes.
+	WideFanOut,
+	// Long chains of pure nodes whose result is read twice.
+	DeepPureChain,
+	// Many small custom events.
+	ManyEvents,
+	// ForLoop macros with a pure read in the loop body.
+	Loops,
+	// A single long Tick, with a blocking load every now and then.
+	DenseTick,
+
+	Count
+};
+
+COMMONVALIDATORS_API const TCHAR* LexToString(ECommonValidatorsSyntheticShape Shape);
+COMMONVALIDATORS_API bool LexTryParseString(ECommonValidatorsSyntheticShape& OutShape, const TCHAR* String);
+
+/**
+ * Builds transient Actor Blueprints with roughly the requested number of nodes in their event graph, for
+ * benchmarking the validators. The Blueprints are not compiled, the validators only look at the graphs.
+ */
+class COMMONVALIDATORS_API FCommonValidatorsSyntheticBlueprint
+{
+public:
+	static UBlueprint* Generate(ECommonValidatorsSyntheticShape Shape, int32 NumNodes);
+};
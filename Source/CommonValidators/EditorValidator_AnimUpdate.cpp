@@ -0,0 +1,166 @@
+#include "EditorValidator_AnimUpdate.h"
+
+#include "Misc/DataValidation.h"
+#include "CommonValidatorsDeveloperSettings.h"
+#include "CommonValidatorsGraphIndex.h"
+#include "CommonValidatorsProfiler.h"
+#include "EditorValidator_ExpensiveTick.h"
+#include "Misc/StringBuilder.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+DECLARE_CYCLE_STAT(TEXT("Anim Update Validator"), STAT_CommonValidators_AnimUpdate, STATGROUP_CommonValidators);
+
+namespace UE::Internal::AnimUpdateValidatorHelpers
+{
+	// Bump when the analysis changes, so cached results are recomputed.
+	static constexpr uint32 AnalysisVersion = 1;
+
+	// Rules of the findings, see FCommonValidatorsFinding::Rule.
+	static const FName UnsafeCallRule(TEXT("UnsafeCall"));
+	static const FName GameThreadUpdateRule(TEXT("GameThreadUpdate"));
+	static const FName SlowPathBindingRule(TEXT("SlowPathBinding"));
+
+	static const FName UpdateAnimationName(TEXT("BlueprintUpdateAnimation"));
+	static const FName ThreadSafeUpdateAnimationName(TEXT("BlueprintThreadSafeUpdateAnimation"));
+
+	static bool IsUnsafeCall(const FCommonValidatorsIndexedNode& Node)
+	{
+		return Node.Kind == ECommonValidatorsNodeKind::CallFunction && Node.Function && !Node.bIsThreadSafe;
+	}
+
+	// "GetVelocity, TryGetPawnOwner and 2 more"
+	static FString JoinNames(const TArray<FName>& Names)
+	{
+		constexpr int32 MaxNames = 3;
+		TStringBuilder<256> Builder;
+		for (int32 Index = 0; Index < FMath::Min(Names.Num(), MaxNames); ++Index)
+		{
+			Builder << (Index > 0 ? TEXT(", ") : TEXT("")) << Names[Index];
+		}
+		if (Names.Num() > MaxNames)
+		{
+			Builder.Appendf(TEXT(" and %d more"), Names.Num() - MaxNames);
+		}
+		return Builder.ToString();
+	}
+}
+
+bool UEditorValidator_AnimUpdate::IsEnabledInSettings() const
+{
+	return GetDefault<UCommonValidatorsDeveloperSettings>()->bEnableAnimUpdateValidator;
+}
+
+uint32 UEditorValidator_AnimUpdate::GetSettingsHash() const
+{
+	const UCommonValidatorsDeveloperSettings* Settings = GetDefault<UCommonValidatorsDeveloperSettings>();
+	return HashCombine(UE::Internal::AnimUpdateValidatorHelpers::AnalysisVersion, GetTypeHash(Settings->bErrorOnAnimUpdate));
+}
+
+EDataValidationResult UEditorValidator_AnimUpdate::AnalyzeBlueprint(const FCommonValidatorsBlueprintIndex& Index, TArray<FCommonValidatorsFinding>& OutFindings) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_CommonValidators_AnimUpdate);
+
+	const bool bShouldError = GetDefault<UCommonValidatorsDeveloperSettings>()->bErrorOnAnimUpdate;
+
+	const int32 NumFindings = OutFindings.Num();
+	FindGameThreadWork(Index, bShouldError ? EMessageSeverity::Error : EMessageSeverity::Warning, OutFindings);
+
+	return (bShouldError && OutFindings.Num() > NumFindings) ? EDataValidationResult::Invalid : EDataValidationResult::Valid;
+}
+
+void UEditorValidator_AnimUpdate::FindGameThreadWork(const FCommonValidatorsBlueprintIndex& Index, EMessageSeverity::Type Severity, TArray<FCommonValidatorsFinding>& OutFindings)
+{
+	using namespace UE::Internal::AnimUpdateValidatorHelpers;
+
+	if (!Index.bIsAnimBlueprint)
+	{
+		return;
+	}
+
+	// Nothing below matters while the whole update runs on the game thread anyway.
+	if (!Index.bMultiThreadedAnimationUpdate)
+	{
+		FCommonValidatorsFinding Finding;
+		Finding.Severity = Severity;
+		Finding.Message = TEXT("Use Multi Threaded Animation Update is off in the class settings, so every update of this Anim Blueprint runs on the game thread.");
+		OutFindings.Add(MoveTemp(Finding));
+	}
+
+	FCommonValidatorsTickReach Reach;
+	TArray<int32, TInlineAllocator<4>> Roots;
+	TArray<FName> UnsafeNames;
+	for (const FCommonValidatorsIndexedGraph& Graph : Index.Graphs)
+	{
+		// Thread safe functions run on a worker thread, everything they call has to be thread safe as well.
+		Roots.Reset();
+		for (const int32 Entry : Graph.EntryNodes)
+		{
+			const FCommonValidatorsIndexedNode& Node = Graph.Nodes[Entry];
+			if (Node.Kind == ECommonValidatorsNodeKind::FunctionEntry && (Node.bIsThreadSafe || Node.MemberName == ThreadSafeUpdateAnimationName))
+			{
+				Roots.Add(Entry);
+			}
+		}
+
+		if (Roots.Num() > 0)
+		{
+			UEditorValidator_ExpensiveTick::FindExecReach(Graph, Roots, Reach);
+			for (const int32 NodeIndex : Reach.Order)
+			{
+				if (IsUnsafeCall(Graph.Nodes[NodeIndex]))
+				{
+					OutFindings.Add(MakeFinding(Graph, NodeIndex, Severity,
+						FString::Printf(TEXT("{Node} isn't thread safe but is called from a thread safe function: %s. Call a function marked BlueprintThreadSafe instead, or read the value with Property Access."),
+							*UEditorValidator_ExpensiveTick::DescribeTickPath(Graph, Reach, NodeIndex)),
+						ECommonValidatorsFindingActions::FocusNode, UnsafeCallRule));
+				}
+			}
+		}
+
+		// Logic in the game thread update is what keeps the animation update off the worker threads.
+		Roots.Reset();
+		for (const int32 Entry : Graph.EntryNodes)
+		{
+			const FCommonValidatorsIndexedNode& Node = Graph.Nodes[Entry];
+			if (Node.Kind == ECommonValidatorsNodeKind::Event && Node.MemberName == UpdateAnimationName && !Node.bIsGhostNode)
+			{
+				Roots.Add(Entry);
+			}
+		}
+
+		if (Roots.Num() > 0)
+		{
+			UEditorValidator_ExpensiveTick::FindExecReach(Graph, Roots, Reach);
+			const int32 NumNodes = Reach.Order.Num() - Roots.Num();
+			if (NumNodes > 0)
+			{
+				int32 NumUnsafeCalls = 0;
+				UnsafeNames.Reset();
+				for (const int32 NodeIndex : Reach.Order)
+				{
+					if (IsUnsafeCall(Graph.Nodes[NodeIndex]))
+					{
+						++NumUnsafeCalls;
+						UnsafeNames.AddUnique(Graph.Nodes[NodeIndex].MemberName);
+					}
+				}
+
+				const FString Message = NumUnsafeCalls == 0
+					? FString::Printf(TEXT("{Node} runs %d nodes on the game thread on every update, all of them thread safe. Move them to BlueprintThreadSafeUpdateAnimation so they run on a worker thread."), NumNodes)
+					: FString::Printf(TEXT("{Node} runs %d nodes on the game thread on every update, %d of them calling functions that aren't thread safe (%s). Read those values with Property Access from BlueprintThreadSafeUpdateAnimation and move the rest of the logic there."),
+						NumNodes, NumUnsafeCalls, *JoinNames(UnsafeNames));
+				OutFindings.Add(MakeFinding(Graph, Roots[0], Severity, Message, ECommonValidatorsFindingActions::FocusNode, GameThreadUpdateRule));
+			}
+		}
+
+		// Inputs the fast path can't copy are evaluated by the Blueprint VM, in state machines as well.
+		for (const FCommonValidatorsAnimBinding& Binding : Graph.SlowPathBindings)
+		{
+			const FName ProducerName = Binding.Producer != INDEX_NONE ? Graph.Nodes[Binding.Producer].MemberName : NAME_None;
+			OutFindings.Add(MakeFinding(Graph, Binding.NodeIndex, Severity,
+				FString::Printf(TEXT("{Node} reads %s from %s, which the fast path can't copy: the Blueprint VM evaluates it on every update. Compute it into a member variable in BlueprintThreadSafeUpdateAnimation and link that, or bind the pin with Property Access."),
+					*Binding.PinName.ToString(), ProducerName.IsNone() ? TEXT("Blueprint logic") : *ProducerName.ToString()),
+				ECommonValidatorsFindingActions::FocusNode, SlowPathBindingRule));
+		}
+	}
+}
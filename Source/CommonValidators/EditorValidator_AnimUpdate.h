@@ -0,0 +1,23 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorValidator_BlueprintBase.h"
+#include "EditorValidator_AnimUpdate.generated.h"
+
+UCLASS()
+class COMMONVALIDATORS_API UEditorValidator_AnimUpdate : public UEditorValidator_BlueprintBase
+{
+	GENERATED_BODY()
+
+	virtual bool IsEnabledInSettings() const override;
+	virtual uint32 GetSettingsHash() const override;
+	virtual EDataValidationResult AnalyzeBlueprint(const FCommonValidatorsBlueprintIndex& Index, TArray<FCommonValidatorsFinding>& OutFindings) const override;
+
+public:
+	/**
+	 * Collects what keeps an Anim Blueprint's update on the game thread: multi-threaded update turned off, logic in
+	 * BlueprintUpdateAnimation, calls from thread safe functions to functions that aren't, and anim graph node inputs
+	 * the fast path can't copy. Does nothing for other Blueprints.
+	 */
+	static void FindGameThreadWork(const FCommonValidatorsBlueprintIndex& Index, EMessageSeverity::Type Severity, TArray<FCommonValidatorsFinding>& OutFindings);
+};
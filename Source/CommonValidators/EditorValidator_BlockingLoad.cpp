@@ -10,82 +10,93 @@
 #include "Engine/MemberReference.h"
 #include "CommonValidatorsStatics.h"
 #include "K2Node_CallFunction.h"
+#include "CommonValidatorsCallGraph.h"
 #include "CommonValidatorsDeveloperSettings.h"
+#include "CommonValidatorsGraphIndex.h"
+#include "CommonValidatorsProfiler.h"
+#include "Misc/StringBuilder.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 
 
-bool UEditorValidator_BlockingLoad::CanValidateAsset_Implementation(const FAssetData& InAssetData, UObject* InObject, FDataValidationContext& InContext) const
+DECLARE_CYCLE_STAT(TEXT("Blocking Load Validator"), STAT_CommonValidators_BlockingLoad, STATGROUP_CommonValidators);
+
+namespace UE::Internal::BlockingLoadValidatorHelpers
 {
-	bool bIsValidatorEnabled = GetDefault<UCommonValidatorsDeveloperSettings>()->bEnableBlockingLoadValidator;
-	return bIsValidatorEnabled && InObject && InObject->IsA<UBlueprint>();
+	// Bump when the analysis changes, so cached results are recomputed.
+	static constexpr uint32 AnalysisVersion = 2;
 }
 
-EDataValidationResult UEditorValidator_BlockingLoad::ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
+bool UEditorValidator_BlockingLoad::IsEnabledInSettings() const
 {
-	UBlueprint* Blueprint = Cast<UBlueprint>(InAsset);
-	if (!Blueprint) return EDataValidationResult::NotValidated;
+	return GetDefault<UCommonValidatorsDeveloperSettings>()->bEnableBlockingLoadValidator;
+}
 
-	EDataValidationResult DataValidationResult = EDataValidationResult::Valid;
+uint32 UEditorValidator_BlockingLoad::GetSettingsHash() const
+{
+	const UCommonValidatorsDeveloperSettings* Settings = GetDefault<UCommonValidatorsDeveloperSettings>();
+	const uint32 Hash = HashCombine(UE::Internal::BlockingLoadValidatorHelpers::AnalysisVersion, GetTypeHash(Settings->bErrorBlockingLoad));
+	return HashCombine(Hash, GetTypeHash(Settings->bBlockingLoadFollowCalls));
+}
 
-	TArray<UEdGraph*> AllGraphs;
-	AllGraphs.Append(Blueprint->FunctionGraphs);
-	AllGraphs.Append(Blueprint->UbergraphPages);
-	
-    for (UEdGraph* Graph : AllGraphs)
-	{
-		for (UEdGraphNode* Node : Graph->Nodes)
-		{
-			if (IsBlockingLoad(Node))
-			{
-				bool bShouldError = GetDefault<UCommonValidatorsDeveloperSettings>()->bErrorBlockingLoad;
+EDataValidationResult UEditorValidator_BlockingLoad::AnalyzeBlueprint(const FCommonValidatorsBlueprintIndex& Index, TArray<FCommonValidatorsFinding>& OutFindings) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_CommonValidators_BlockingLoad);
 
-				// Create a tokenized message with an action to open the Blueprint and focus the node
-				TSharedRef<FTokenizedMessage> TokenizedMessage = FTokenizedMessage::Create((bShouldError ? EMessageSeverity::Error : EMessageSeverity::Warning), FText::FromString(TEXT("Blocking (synchronous) loading nodes found.")));
+	const UCommonValidatorsDeveloperSettings* Settings = GetDefault<UCommonValidatorsDeveloperSettings>();
+	bool bShouldError = Settings->bErrorBlockingLoad;
 
-				TokenizedMessage->AddToken(FActionToken::Create(
-					FText::FromString(TEXT("Open Blueprint and Focus Node")),
-					FText::FromString(TEXT("Open Blueprint and Focus Node")),
-					FOnActionTokenExecuted::CreateLambda([Blueprint, Graph, Node]()
-						{
-							UCommonValidatorsStatics::OpenBlueprintAndFocusNode(Blueprint, Graph, Node);
-						}),
-					false
-				));
+	TArray<FCommonValidatorsNodeRef> BlockingLoads;
+	FindBlockingLoads(Index, BlockingLoads, Settings->bBlockingLoadFollowCalls);
 
-				Context.AddMessage(TokenizedMessage);
+	for (const FCommonValidatorsNodeRef& Ref : BlockingLoads)
+	{
+		const FCommonValidatorsIndexedGraph& Graph = Index.Graphs[Ref.GraphIndex];
 
-				DataValidationResult = bShouldError ? EDataValidationResult::Invalid : EDataValidationResult::Valid;
+		FString Message = TEXT("Blocking (synchronous) loading nodes found.");
+		if (const TArray<FName>* Chain = Graph.FindBlockingChain(Ref.NodeIndex))
+		{
+			TStringBuilder<256> ChainString;
+			for (const FName Name : *Chain)
+			{
+				ChainString << (ChainString.Len() > 0 ? TEXT(" -> ") : TEXT("")) << Name;
 			}
+			Message = FString::Printf(TEXT("{Node} loads synchronously further down: %s."), *ChainString);
 		}
+
+		// Create a finding with an action to open the Blueprint and focus the node
+		OutFindings.Add(MakeFinding(Graph, Ref.NodeIndex,
+			(bShouldError ? EMessageSeverity::Error : EMessageSeverity::Warning),
+			Message,
+			ECommonValidatorsFindingActions::FocusNode));
 	}
 
-	return DataValidationResult;
+	return (bShouldError && BlockingLoads.Num() > 0) ? EDataValidationResult::Invalid : EDataValidationResult::Valid;
 }
 
-bool UEditorValidator_BlockingLoad::IsBlockingLoad(UEdGraphNode* Node)
+void UEditorValidator_BlockingLoad::FindBlockingLoads(const FCommonValidatorsBlueprintIndex& Index, TArray<FCommonValidatorsNodeRef>& OutNodes, bool bFollowCalls)
 {
-	UK2Node_CallFunction* CallFunctionNode = Cast<UK2Node_CallFunction>(Node);
+	TRACE_CPUPROFILER_EVENT_SCOPE(UEditorValidator_BlockingLoad::FindBlockingLoads);
 
-	if (!CallFunctionNode)
+	for (int32 GraphIndex = 0; GraphIndex < Index.Graphs.Num(); ++GraphIndex)
 	{
-		// Not a function call node
-		return false;
-	}
-
-	static const FName LoadAssetBlockingFunctionName(TEXT("LoadAsset_Blocking"));
-	static const FName LoadClassAssetBlockingFunctionName(TEXT("LoadClassAsset_Blocking"));
-	FName FunctionName = CallFunctionNode->GetFunctionName();
-
-	if (FunctionName == LoadAssetBlockingFunctionName)
-	{
-		return true;
+		const FCommonValidatorsIndexedGraph& Graph = Index.Graphs[GraphIndex];
+		for (int32 NodeIndex = 0; NodeIndex < Graph.Nodes.Num(); ++NodeIndex)
+		{
+			if (IsBlockingLoad(Graph.Nodes[NodeIndex]) || (bFollowCalls && Graph.FindBlockingChain(NodeIndex)))
+			{
+				OutNodes.Add({ GraphIndex, NodeIndex });
+			}
+		}
 	}
+}
 
-	if (FunctionName == LoadClassAssetBlockingFunctionName)
+bool UEditorValidator_BlockingLoad::IsBlockingLoad(const FCommonValidatorsIndexedNode& Node)
+{
+	if (Node.Kind != ECommonValidatorsNodeKind::CallFunction)
 	{
-		return true;
+		// Not a function call node
+		return false;
 	}
 
-
-	// Not a blocking (synchronous) loading function
-	return false;
+	return FCommonValidatorsCallGraph::IsBlockingLoadFunction(Node.MemberName);
 }
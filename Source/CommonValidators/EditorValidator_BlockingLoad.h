@@ -1,16 +1,23 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "EditorValidatorBase.h"
+#include "EditorValidator_BlueprintBase.h"
 #include "EditorValidator_BlockingLoad.generated.h"
 
 UCLASS()
-class COMMONVALIDATORS_API UEditorValidator_BlockingLoad : public UEditorValidatorBase
+class COMMONVALIDATORS_API UEditorValidator_BlockingLoad : public UEditorValidator_BlueprintBase
 {
 	GENERATED_BODY()
 	
-	virtual bool CanValidateAsset_Implementation(const FAssetData& InAssetData, UObject* InObject, FDataValidationContext& InContext) const override;
-	virtual EDataValidationResult ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context) override;
+	virtual bool IsEnabledInSettings() const override;
+	virtual uint32 GetSettingsHash() const override;
+	virtual EDataValidationResult AnalyzeBlueprint(const FCommonValidatorsBlueprintIndex& Index, TArray<FCommonValidatorsFinding>& OutFindings) const override;
 
-	bool IsBlockingLoad(class UEdGraphNode* Node);
+public:
+	// Collects every blocking (synchronous) load call in the Blueprint and, with bFollowCalls, every call or macro
+	// doing one further down.
+	static void FindBlockingLoads(const FCommonValidatorsBlueprintIndex& Index, TArray<struct FCommonValidatorsNodeRef>& OutNodes, bool bFollowCalls);
+
+private:
+	static bool IsBlockingLoad(const struct FCommonValidatorsIndexedNode& Node);
 };
@@ -0,0 +1,361 @@
+#include "EditorValidator_BlueprintBase.h"
+
+#include "Misc/DataValidation.h"
+#include "Engine/Blueprint.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "CommonValidatorsStatics.h"
+#include "CommonValidatorsAsyncValidation.h"
+#include "CommonValidatorsDeveloperSettings.h"
+#include "CommonValidatorsGraphIndex.h"
+#include "CommonValidatorsMessageReport.h"
+#include "CommonValidatorsProfiler.h"
+#include "CommonValidatorsResultCache.h"
+#include "HAL/PlatformTime.h"
+#include "Logging/MessageLog.h"
+#include "Misc/App.h"
+#include "Misc/UObjectToken.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "UObject/UObjectHash.h"
+
+DECLARE_CYCLE_STAT(TEXT("Validate Blueprint"), STAT_CommonValidators_ValidateBlueprint, STATGROUP_CommonValidators);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Result Cache Hits"), STAT_CommonValidators_ResultCacheHits, STATGROUP_CommonValidators);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Result Cache Misses"), STAT_CommonValidators_ResultCacheMisses, STATGROUP_CommonValidators);
+
+bool UEditorValidator_BlueprintBase::CanValidateAsset_Implementation(const FAssetData& InAssetData, UObject* InObject, FDataValidationContext& InContext) const
+{
+	return IsEnabledInSettings() && InObject && InObject->IsA<UBlueprint>();
+}
+
+EDataValidationResult UEditorValidator_BlueprintBase::ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UEditorValidator_BlueprintBase::ValidateLoadedAsset);
+	SCOPE_CYCLE_COUNTER(STAT_CommonValidators_ValidateBlueprint);
+
+	UBlueprint* Blueprint = Cast<UBlueprint>(InAsset);
+	if (!Blueprint) return EDataValidationResult::NotValidated;
+
+	const TSharedRef<const FCommonValidatorsBlueprintIndex> Index = FCommonValidatorsGraphIndexCache::Get().FindOrBuild(Blueprint);
+
+	// The index is all the analysis needs, the save goes on while it runs and findings reach the Message Log later.
+	if (ShouldValidateAsync(Context))
+	{
+		FCommonValidatorsAsyncValidation::Get().Launch(Blueprint, Index, this);
+		return EDataValidationResult::Valid;
+	}
+
+	TArray<FCommonValidatorsFinding> Findings;
+	const EDataValidationResult Result = AnalyzeWithCache(Blueprint->GetPathName(), *Index, GetDefault<UCommonValidatorsDeveloperSettings>()->bEnableResultCache, Findings);
+
+	ReportFindings(Blueprint, *Index, Findings, Context);
+	return Result;
+}
+
+EDataValidationResult UEditorValidator_BlueprintBase::AnalyzeWithCache(const FString& AssetPath, const FCommonValidatorsBlueprintIndex& Index, bool bUseCache, TArray<FCommonValidatorsFinding>& OutFindings) const
+{
+	const FName ValidatorName = GetClass()->GetFName();
+	TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(*ValidatorName.ToString());
+
+	const uint32 SettingsHash = GetSettingsHash();
+	bUseCache &= CanCacheResults();
+
+	EDataValidationResult Result = EDataValidationResult::NotValidated;
+	if (bUseCache && FCommonValidatorsResultCache::Get().Find(AssetPath, ValidatorName, SettingsHash, Index.ContentHash, Result, OutFindings))
+	{
+		INC_DWORD_STAT(STAT_CommonValidators_ResultCacheHits);
+		return Result;
+	}
+	INC_DWORD_STAT(STAT_CommonValidators_ResultCacheMisses);
+
+	const double StartTime = FPlatformTime::Seconds();
+	Result = AnalyzeBlueprint(Index, OutFindings);
+	FCommonValidatorsProfiler::Get().Record(ValidatorName, AssetPath, Index.NumNodes, Index.NumPins, FPlatformTime::Seconds() - StartTime);
+	if (bUseCache)
+	{
+		FCommonValidatorsResultCache::Get().Store(AssetPath, ValidatorName, SettingsHash, Index.ContentHash, Result, OutFindings);
+	}
+	return Result;
+}
+
+TArray<const UEditorValidator_BlueprintBase*> UEditorValidator_BlueprintBase::GetEnabledValidators()
+{
+	TArray<UClass*> Classes;
+	GetDerivedClasses(UEditorValidator_BlueprintBase::StaticClass(), Classes);
+
+	TArray<const UEditorValidator_BlueprintBase*> Validators;
+	for (const UClass* Class : Classes)
+	{
+		if (Class->HasAnyClassFlags(CLASS_Abstract | CLASS_Deprecated | CLASS_NewerVersionExists))
+		{
+			continue;
+		}
+
+		const UEditorValidator_BlueprintBase* Validator = Class->GetDefaultObject<UEditorValidator_BlueprintBase>();
+		if (Validator->IsEnabled() && Validator->IsEnabledInSettings())
+		{
+			Validators.Add(Validator);
+		}
+	}
+
+	Validators.Sort([](const UEditorValidator_BlueprintBase& A, const UEditorValidator_BlueprintBase& B)
+	{
+		return A.GetClass()->GetFName().LexicalLess(B.GetClass()->GetFName());
+	});
+	return Validators;
+}
+
+UEdGraphNode* UEditorValidator_BlueprintBase::FindNode(const FCommonValidatorsBlueprintIndex& Index, const FCommonValidatorsFinding& Finding)
+{
+	for (const FCommonValidatorsIndexedGraph& Graph : Index.Graphs)
+	{
+		if (Graph.GraphName != Finding.GraphName)
+		{
+			continue;
+		}
+
+		for (const FCommonValidatorsIndexedNode& Node : Graph.Nodes)
+		{
+			if (Node.NodeGuid == Finding.NodeGuid)
+			{
+				return Node.Node;
+			}
+		}
+	}
+	return nullptr;
+}
+
+FText UEditorValidator_BlueprintBase::FormatMessage(const FCommonValidatorsFinding& Finding, const UEdGraphNode* Node)
+{
+	// Not FText::Format: messages of node rules are written by users, and may contain braces of their own.
+	const FString Title = Node ? Node->GetNodeTitle(ENodeTitleType::MenuTitle).ToString() : Finding.GraphName.ToString();
+	return FText::FromString(Finding.Message.Replace(TEXT("{Node}"), *Title, ESearchCase::CaseSensitive));
+}
+
+FCommonValidatorsFinding UEditorValidator_BlueprintBase::MakeFinding(const FCommonValidatorsIndexedGraph& Graph, int32 NodeIndex, EMessageSeverity::Type Severity, const FString& Message, ECommonValidatorsFindingActions Actions,
+	FName Rule)
+{
+	FCommonValidatorsFinding Finding;
+	Finding.Severity = Severity;
+	Finding.Message = Message;
+	Finding.GraphName = Graph.GraphName;
+	Finding.NodeGuid = Graph.Nodes[NodeIndex].NodeGuid;
+	Finding.Actions = Actions;
+	Finding.Rule = Rule;
+	return Finding;
+}
+
+bool UEditorValidator_BlueprintBase::ShouldValidateAsync(const FDataValidationContext& Context)
+{
+	// CI, commandlets and explicit validation want the result before going on.
+	return GetDefault<UCommonValidatorsDeveloperSettings>()->bAsyncSaveValidation
+		&& Context.GetValidationUsecase() == EDataValidationUsecase::Save
+		&& GIsEditor && !IsRunningCommandlet() && !FApp::IsUnattended() && !GIsAutomationTesting;
+}
+
+void UEditorValidator_BlueprintBase::ReportFindings(UBlueprint* Blueprint, const FCommonValidatorsBlueprintIndex& Index, const TArray<FCommonValidatorsFinding>& Findings, FDataValidationContext& Context) const
+{
+	TArray<TSharedRef<FTokenizedMessage>> Messages;
+	CreateMessages(Blueprint, Index, Findings, Messages);
+	for (const TSharedRef<FTokenizedMessage>& Message : Messages)
+	{
+		Context.AddMessage(Message);
+	}
+}
+
+void UEditorValidator_BlueprintBase::ReportFindingsToMessageLog(UBlueprint* Blueprint, const FCommonValidatorsBlueprintIndex& Index, const TArray<FCommonValidatorsFinding>& Findings) const
+{
+	TArray<TSharedRef<FTokenizedMessage>> Messages;
+	CreateMessages(Blueprint, Index, Findings, Messages);
+	if (Messages.IsEmpty())
+	{
+		return;
+	}
+
+	FMessageLog MessageLog(TEXT("AssetCheck"));
+	for (const TSharedRef<FTokenizedMessage>& Message : Messages)
+	{
+		// Nothing groups these under the asset the way a validation run does, so each message names it.
+		TSharedRef<FTokenizedMessage> AssetMessage = FTokenizedMessage::Create(Message->GetSeverity());
+		AssetMessage->AddToken(FUObjectToken::Create(Blueprint));
+		for (const TSharedRef<IMessageToken>& Token : Message->GetMessageTokens())
+		{
+			AssetMessage->AddToken(Token);
+		}
+		MessageLog.AddMessage(AssetMessage);
+	}
+	MessageLog.Notify(FText::Format(NSLOCTEXT("CommonValidators", "AsyncFindings", "{0} has validation findings"), FText::FromString(Blueprint->GetName())), EMessageSeverity::Warning);
+}
+
+void UEditorValidator_BlueprintBase::CreateMessages(UBlueprint* Blueprint, const FCommonValidatorsBlueprintIndex& Index, const TArray<FCommonValidatorsFinding>& Findings, TArray<TSharedRef<FTokenizedMessage>>& OutMessages) const
+{
+	if (Findings.IsEmpty())
+	{
+		return;
+	}
+
+	// Findings may come from the result cache, so nodes are resolved by GUID rather than by index
+	TMap<FGuid, FCommonValidatorsNodeRef> NodesByGuid;
+	for (int32 GraphIndex = 0; GraphIndex < Index.Graphs.Num(); ++GraphIndex)
+	{
+		const TArray<FCommonValidatorsIndexedNode>& Nodes = Index.Graphs[GraphIndex].Nodes;
+		for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex)
+		{
+			NodesByGuid.Add(Nodes[NodeIndex].NodeGuid, { GraphIndex, NodeIndex });
+		}
+	}
+
+	auto ResolveNode = [&Index, &NodesByGuid](const FCommonValidatorsFinding& Finding, UEdGraph*& OutGraph) -> UEdGraphNode*
+	{
+		OutGraph = nullptr;
+		if (const FCommonValidatorsNodeRef* Ref = NodesByGuid.Find(Finding.NodeGuid))
+		{
+			if (Index.Graphs[Ref->GraphIndex].GraphName == Finding.GraphName)
+			{
+				OutGraph = Index.Graphs[Ref->GraphIndex].Graph;
+				return Index.GetNode(*Ref).Node;
+			}
+		}
+		return nullptr;
+	};
+
+	// Node overlays are set for every finding, the Message Log cap only limits what is listed there.
+	{
+		FCommonValidatorsNodeChangeBatch ChangedNodes;
+		for (const FCommonValidatorsFinding& Finding : Findings)
+		{
+			UEdGraph* Graph = nullptr;
+			if (UEdGraphNode* Node = ResolveNode(Finding, Graph))
+			{
+				if (OnFindingReported(Blueprint, Graph, Node, Finding))
+				{
+					ChangedNodes.Add(Node);
+				}
+			}
+		}
+	}
+
+	// Every finding goes to the export file as is, the Message Log only lists the first groups. Only what it lists
+	// is formatted, node titles can be slow to build and this runs when saving.
+	FCommonValidatorsResultRecord Record;
+	Record.AssetPath = Blueprint->GetPathName();
+	Record.Validator = GetClass()->GetName();
+	Record.Result = Findings.ContainsByPredicate([](const FCommonValidatorsFinding& Finding) { return Finding.Severity == EMessageSeverity::Error; })
+		? EDataValidationResult::Invalid
+		: EDataValidationResult::Valid;
+	Record.Findings = Findings;
+	const FString ExportPath = FCommonValidatorsMessageReport::Get().Export(MoveTemp(Record));
+	const FString ValidatorName = GetClass()->GetName();
+
+	// One entry per rule, so a rule hitting the same call on hundreds of nodes doesn't flood the log.
+	TArray<TArray<int32>> Groups;
+	FCommonValidatorsMessageReport::GroupFindings(Findings, Groups);
+
+	const int32 MaxMessages = GetDefault<UCommonValidatorsDeveloperSettings>()->MaxMessagesPerAsset;
+	const int32 NumDetailed = MaxMessages > 0 ? FMath::Min(Groups.Num(), MaxMessages) : Groups.Num();
+
+	for (int32 GroupIndex = 0; GroupIndex < NumDetailed; ++GroupIndex)
+	{
+		const TArray<int32>& Group = Groups[GroupIndex];
+		const FCommonValidatorsFinding& Finding = Findings[Group[0]];
+
+		// The entry reads as the first finding, whose actions it offers. The other nodes follow as links to focus them.
+		UEdGraph* Graph = nullptr;
+		UEdGraphNode* Node = ResolveNode(Finding, Graph);
+
+		TSharedRef<FTokenizedMessage> TokenizedMessage = FTokenizedMessage::Create(Finding.Severity, FormatMessage(Finding, Node));
+
+		if (Node && EnumHasAnyFlags(Finding.Actions, ECommonValidatorsFindingActions::FocusNode))
+		{
+			TokenizedMessage->AddToken(FActionToken::Create(
+				FText::FromString(TEXT("Open Blueprint and Focus Node")),
+				FText::FromString(TEXT("Open Blueprint and Focus Node")),
+				FOnActionTokenExecuted::CreateLambda([Blueprint, Graph, Node]()
+					{
+						UCommonValidatorsStatics::OpenBlueprintAndFocusNode(Blueprint, Graph, Node);
+					}),
+				false
+			));
+		}
+
+		if (Node && EnumHasAnyFlags(Finding.Actions, ECommonValidatorsFindingActions::RemoveNode))
+		{
+			TokenizedMessage->AddToken(FActionToken::Create(
+				FText::FromString(TEXT("Remove Node")),
+				FText::FromString(TEXT("Remove Node")),
+				FOnActionTokenExecuted::CreateLambda([Blueprint, Graph, Node]()
+					{
+						UCommonValidatorsStatics::DeleteNodeFromBlueprint(Blueprint, Graph, Node);
+					}),
+				false
+			));
+		}
+
+		if (Node && EnumHasAnyFlags(Finding.Actions, ECommonValidatorsFindingActions::CacheInVariable))
+		{
+			TokenizedMessage->AddToken(FActionToken::Create(
+				FText::FromString(TEXT("Cache in Variable")),
+				FText::FromString(TEXT("Evaluate the node once and store the result in a variable read by every user")),
+				FOnActionTokenExecuted::CreateLambda([Blueprint, Graph, Node]()
+					{
+						UCommonValidatorsStatics::CachePureNodeInVariable(Blueprint, Graph, Node);
+					}),
+				false
+			));
+		}
+
+		if (Group.Num() > 1)
+		{
+			TokenizedMessage->AddToken(FTextToken::Create(FText::Format(
+				NSLOCTEXT("CommonValidators", "GroupedFinding", "Also on {0} other {0}|plural(one=node,other=nodes):"), Group.Num() - 1)));
+		}
+		const int32 NumLinked = FMath::Min(Group.Num(), MaxNodesPerEntry + 1);
+		for (int32 Member = 1; Member < NumLinked; ++Member)
+		{
+			// Each node's own message as tooltip, the details it names differ from one node to the next.
+			const FCommonValidatorsFinding& Other = Findings[Group[Member]];
+			UEdGraph* OtherGraph = nullptr;
+			UEdGraphNode* OtherNode = ResolveNode(Other, OtherGraph);
+			if (!OtherNode)
+			{
+				TokenizedMessage->AddToken(FTextToken::Create(FormatMessage(Other, nullptr)));
+				continue;
+			}
+
+			TokenizedMessage->AddToken(FActionToken::Create(
+				OtherNode->GetNodeTitle(ENodeTitleType::MenuTitle),
+				FormatMessage(Other, OtherNode),
+				FOnActionTokenExecuted::CreateLambda([Blueprint, OtherGraph, OtherNode]()
+					{
+						UCommonValidatorsStatics::OpenBlueprintAndFocusNode(Blueprint, OtherGraph, OtherNode);
+					}),
+				false
+			));
+		}
+		if (NumLinked < Group.Num())
+		{
+			TokenizedMessage->AddToken(FTextToken::Create(FText::Format(
+				NSLOCTEXT("CommonValidators", "MoreGroupedNodes", "and {0} more, see {1}"), Group.Num() - NumLinked, FText::FromString(ExportPath))));
+		}
+
+		OutMessages.Add(TokenizedMessage);
+	}
+
+	if (NumDetailed == Groups.Num())
+	{
+		return;
+	}
+
+	// Everything else is summed up, pointing at the full list in the export file.
+	int32 NumRemaining = 0;
+	EMessageSeverity::Type RemainingSeverity = EMessageSeverity::Info;
+	for (int32 GroupIndex = NumDetailed; GroupIndex < Groups.Num(); ++GroupIndex)
+	{
+		NumRemaining += Groups[GroupIndex].Num();
+		// Lower values are more severe.
+		RemainingSeverity = FMath::Min(RemainingSeverity, Findings[Groups[GroupIndex][0]].Severity.GetValue());
+	}
+
+	OutMessages.Add(FTokenizedMessage::Create(RemainingSeverity, FText::Format(
+		NSLOCTEXT("CommonValidators", "MoreFindings", "+{0} more {0}|plural(one=finding,other=findings) from {1}, see {2} for all of them"),
+		NumRemaining, FText::FromString(ValidatorName), FText::FromString(ExportPath))));
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorValidatorBase.h"
+#include "CommonValidatorsFinding.h"
+#include "EditorValidator_BlueprintBase.generated.h"
+
+struct FCommonValidatorsBlueprintIndex;
+struct FCommonValidatorsIndexedGraph;
+class UBlueprint;
+class UEdGraph;
+class UEdGraphNode;
+
+/**
+ * Shared plumbing of the Blueprint validators: subclasses only analyze the Blueprint's graph index and
+ * return findings. Fetching the index, the persistent result cache and turning findings into messages
+ * with actions happens here.
+ */
+UCLASS(Abstract)
+class COMMONVALIDATORS_API UEditorValidator_BlueprintBase : public UEditorValidatorBase
+{
+	GENERATED_BODY()
+
+public:
+	// Whether the validator is enabled in UCommonValidatorsDeveloperSettings.
+	virtual bool IsEnabledInSettings() const PURE_VIRTUAL(UEditorValidator_BlueprintBase::IsEnabledInSettings, return false;);
+
+	/**
+	 * Analyzes an index, going through the persistent result cache when bUseCache is set. Only touches the index
+	 * and settings, so it can run on any thread; the commandlet calls it from worker threads.
+	 */
+	EDataValidationResult AnalyzeWithCache(const FString& AssetPath, const FCommonValidatorsBlueprintIndex& Index, bool bUseCache, TArray<FCommonValidatorsFinding>& OutFindings) const;
+
+	// Whether findings in a graph only depend on that graph, so live validation can analyze the edited graphs alone.
+	virtual bool IsGraphLocal() const { return false; }
+
+	// Validators enabled both on their own and in the settings, sorted by class name so results come out in a stable order.
+	static TArray<const UEditorValidator_BlueprintBase*> GetEnabledValidators();
+
+	// Reports findings of an analysis that ran in the background to the Message Log, prefixed with the asset. Game thread only.
+	void ReportFindingsToMessageLog(UBlueprint* Blueprint, const FCommonValidatorsBlueprintIndex& Index, const TArray<FCommonValidatorsFinding>& Findings) const;
+
+	// Finds the node a finding refers to, if it still exists in the indexed Blueprint.
+	static UEdGraphNode* FindNode(const FCommonValidatorsBlueprintIndex& Index, const FCommonValidatorsFinding& Finding);
+
+	// Builds the final message of a finding, substituting the node title. The message is taken literally otherwise,
+	// other braces in it aren't format arguments. Game thread only.
+	static FText FormatMessage(const FCommonValidatorsFinding& Finding, const UEdGraphNode* Node);
+
+protected:
+	virtual bool CanValidateAsset_Implementation(const FAssetData& InAssetData, UObject* InObject, FDataValidationContext& InContext) const override;
+	virtual EDataValidationResult ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context) override;
+
+	// Hash of every setting the analysis depends on. Bump the version folded into it when the analysis changes.
+	virtual uint32 GetSettingsHash() const PURE_VIRTUAL(UEditorValidator_BlueprintBase::GetSettingsHash, return 0;);
+
+	// Whether results only depend on the index and settings. Validators looking further, e.g. at the Asset Registry, bypass the result cache.
+	virtual bool CanCacheResults() const { return true; }
+
+	virtual EDataValidationResult AnalyzeBlueprint(const FCommonValidatorsBlueprintIndex& Index, TArray<FCommonValidatorsFinding>& OutFindings) const
+		PURE_VIRTUAL(UEditorValidator_BlueprintBase::AnalyzeBlueprint, return EDataValidationResult::NotValidated;);
+
+	// Called for every finding whose node could be resolved, including those left out of the Message Log. Returns whether
+	// the node was changed, changed nodes are refreshed once per graph afterwards.
+	virtual bool OnFindingReported(UBlueprint* Blueprint, UEdGraph* Graph, UEdGraphNode* Node, const FCommonValidatorsFinding& Finding) const { return false; }
+
+	static FCommonValidatorsFinding MakeFinding(const FCommonValidatorsIndexedGraph& Graph, int32 NodeIndex, EMessageSeverity::Type Severity, const FString& Message, ECommonValidatorsFindingActions Actions,
+		FName Rule = NAME_None);
+
+private:
+	void ReportFindings(UBlueprint* Blueprint, const FCommonValidatorsBlueprintIndex& Index, const TArray<FCommonValidatorsFinding>& Findings, FDataValidationContext& Context) const;
+	void CreateMessages(UBlueprint* Blueprint, const FCommonValidatorsBlueprintIndex& Index, const TArray<FCommonValidatorsFinding>& Findings, TArray<TSharedRef<FTokenizedMessage>>& OutMessages) const;
+
+	// Whether validation of this save can run in the background, see UCommonValidatorsDeveloperSettings::bAsyncSaveValidation.
+	static bool ShouldValidateAsync(const FDataValidationContext& Context);
+
+	// Other nodes of a group linked from its Message Log entry, the rest are only counted.
+	static constexpr int32 MaxNodesPerEntry = 10;
+};
@@ -0,0 +1,216 @@
+#include "EditorValidator_DuplicatePure.h"
+
+#include "Misc/DataValidation.h"
+#include "CommonValidatorsDeveloperSettings.h"
+#include "CommonValidatorsGraphIndex.h"
+#include "CommonValidatorsProfiler.h"
+#include "Hash/xxhash.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+DECLARE_CYCLE_STAT(TEXT("Duplicate Pure Validator"), STAT_CommonValidators_DuplicatePure, STATGROUP_CommonValidators);
+
+namespace UE::Internal::DuplicatePureValidatorHelpers
+{
+	// Bump when the analysis changes, so cached results are recomputed.
+	static constexpr uint32 AnalysisVersion = 1;
+
+	// Knots carry no computation, the index already resolves pure inputs through them.
+	static bool IsHashed(const FCommonValidatorsIndexedNode& Node)
+	{
+		return Node.bIsPure && Node.Kind != ECommonValidatorsNodeKind::Knot;
+	}
+
+	// Nodes about as cheap as reading the value back from a variable.
+	static bool IsTrivial(const FCommonValidatorsIndexedNode& Node)
+	{
+		return Node.bIsHarmlessPure || Node.Kind == ECommonValidatorsNodeKind::VariableGet
+			|| Node.Kind == ECommonValidatorsNodeKind::BreakStruct || Node.Kind == ECommonValidatorsNodeKind::MakeStruct;
+	}
+
+	struct FTreeClass
+	{
+		TArray<int32> Members;
+		int32 NumNodes = 0;
+		bool bIsTrivial = true;
+	};
+
+	static void FindDuplicates(const FCommonValidatorsIndexedGraph& Graph, int32 GraphIndex, TArray<FCommonValidatorsDuplicatePure>& OutDuplicates)
+	{
+		const int32 NumNodes = Graph.Nodes.Num();
+
+		enum class EState : uint8 { Unvisited, Visiting, Done };
+		TArray<EState> States;
+		States.Init(EState::Unvisited, NumNodes);
+
+		TArray<int32> ClassIds;
+		ClassIds.Init(INDEX_NONE, NumNodes);
+
+		TArray<FTreeClass> Classes;
+		TMap<uint64, int32> ClassesByHash;
+
+		// Post order without recursion, pure chains can be thousands of nodes deep.
+		TArray<int32> Stack;
+		for (int32 Start = 0; Start < NumNodes; ++Start)
+		{
+			if (!IsHashed(Graph.Nodes[Start]) || States[Start] != EState::Unvisited)
+			{
+				continue;
+			}
+
+			Stack.Add(Start);
+			while (Stack.Num() > 0)
+			{
+				const int32 Current = Stack.Last();
+				if (States[Current] == EState::Unvisited)
+				{
+					States[Current] = EState::Visiting;
+					for (const FCommonValidatorsPureInput& Input : Graph.GetPureInputs(Current))
+					{
+						if (Input.Producer != INDEX_NONE && IsHashed(Graph.Nodes[Input.Producer]) && States[Input.Producer] == EState::Unvisited)
+						{
+							Stack.Add(Input.Producer);
+						}
+					}
+					continue;
+				}
+
+				Stack.Pop(EAllowShrinking::No);
+				if (States[Current] == EState::Done)
+				{
+					continue;
+				}
+				States[Current] = EState::Done;
+
+				FXxHash64Builder Builder;
+				Builder.Update(&Graph.Nodes[Current].PureSignature, sizeof(uint64));
+
+				int32 TreeNodes = 1;
+				bool bTreeIsTrivial = IsTrivial(Graph.Nodes[Current]);
+				for (const FCommonValidatorsPureInput& Input : Graph.GetPureInputs(Current))
+				{
+					Builder.Update(&Input.PinHash, sizeof(Input.PinHash));
+
+					// Outputs of exec nodes are values computed once, identical only when read from the same node.
+					const int32 ProducerClass = Input.Producer != INDEX_NONE ? ClassIds[Input.Producer] : INDEX_NONE;
+					const int64 Token = ProducerClass != INDEX_NONE ? ProducerClass : -2 - static_cast<int64>(Input.Producer);
+					Builder.Update(&Token, sizeof(Token));
+
+					if (ProducerClass != INDEX_NONE)
+					{
+						TreeNodes += Classes[ProducerClass].NumNodes;
+						bTreeIsTrivial &= Classes[ProducerClass].bIsTrivial;
+					}
+				}
+
+				const uint64 Hash = Builder.Finalize().Hash;
+				int32& ClassId = ClassesByHash.FindOrAdd(Hash, INDEX_NONE);
+				if (ClassId == INDEX_NONE)
+				{
+					ClassId = Classes.Num();
+					FTreeClass& NewClass = Classes.AddDefaulted_GetRef();
+					NewClass.NumNodes = TreeNodes;
+					NewClass.bIsTrivial = bTreeIsTrivial;
+				}
+				Classes[ClassId].Members.Add(Current);
+				ClassIds[Current] = ClassId;
+			}
+		}
+
+		auto IsDuplicated = [&ClassIds, &Classes](int32 NodeIndex)
+		{
+			return ClassIds[NodeIndex] != INDEX_NONE && Classes[ClassIds[NodeIndex]].Members.Num() > 1;
+		};
+
+		// A copy is only worth reporting on its own if something outside a larger duplicated tree reads it.
+		TArray<int32, TInlineAllocator<8>> Consumers;
+		auto IsReadOutsideDuplicates = [&Graph, &IsDuplicated, &Consumers](int32 NodeIndex)
+		{
+			Consumers.Reset();
+			Consumers.Append(Graph.GetDataConsumers(NodeIndex));
+			for (int32 Head = 0; Head < Consumers.Num() && Head < 1024; ++Head)
+			{
+				const int32 Consumer = Consumers[Head];
+				if (Graph.Nodes[Consumer].Kind == ECommonValidatorsNodeKind::Knot)
+				{
+					Consumers.Append(Graph.GetDataConsumers(Consumer));
+				}
+				else if (!IsDuplicated(Consumer))
+				{
+					return true;
+				}
+			}
+			return false;
+		};
+
+		for (const FTreeClass& Class : Classes)
+		{
+			if (Class.Members.Num() < 2 || !Class.Members.ContainsByPredicate(IsReadOutsideDuplicates))
+			{
+				continue;
+			}
+
+			FCommonValidatorsDuplicatePure& Duplicate = OutDuplicates.AddDefaulted_GetRef();
+			Duplicate.GraphIndex = GraphIndex;
+			Duplicate.Copies = Class.Members;
+			Duplicate.Copies.Sort();
+			Duplicate.NumNodes = Class.NumNodes;
+			Duplicate.bIsTrivial = Class.bIsTrivial;
+		}
+	}
+}
+
+bool UEditorValidator_DuplicatePure::IsEnabledInSettings() const
+{
+	return GetDefault<UCommonValidatorsDeveloperSettings>()->bEnableDuplicatePureValidator;
+}
+
+uint32 UEditorValidator_DuplicatePure::GetSettingsHash() const
+{
+	const UCommonValidatorsDeveloperSettings* Settings = GetDefault<UCommonValidatorsDeveloperSettings>();
+	const uint32 Hash = HashCombine(UE::Internal::DuplicatePureValidatorHelpers::AnalysisVersion, GetTypeHash(Settings->bErrorOnDuplicatePure));
+	return HashCombine(Hash, GetTypeHash(Settings->DuplicatePureMinNodes));
+}
+
+EDataValidationResult UEditorValidator_DuplicatePure::AnalyzeBlueprint(const FCommonValidatorsBlueprintIndex& Index, TArray<FCommonValidatorsFinding>& OutFindings) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_CommonValidators_DuplicatePure);
+
+	const UCommonValidatorsDeveloperSettings* Settings = GetDefault<UCommonValidatorsDeveloperSettings>();
+	const bool bShouldError = Settings->bErrorOnDuplicatePure;
+
+	TArray<FCommonValidatorsDuplicatePure> Duplicates;
+	FindDuplicatePureComputations(Index, Duplicates);
+
+	bool bHasFindings = false;
+	for (const FCommonValidatorsDuplicatePure& Duplicate : Duplicates)
+	{
+		if (Duplicate.bIsTrivial || Duplicate.NumNodes < Settings->DuplicatePureMinNodes)
+		{
+			continue;
+		}
+
+		// One finding per copy, so each of them can be focused.
+		const FCommonValidatorsIndexedGraph& Graph = Index.Graphs[Duplicate.GraphIndex];
+		for (int32 Copy = 0; Copy < Duplicate.Copies.Num(); ++Copy)
+		{
+			OutFindings.Add(MakeFinding(Graph, Duplicate.Copies[Copy],
+				(bShouldError ? EMessageSeverity::Error : EMessageSeverity::Warning),
+				FString::Printf(TEXT("{Node} and the pure nodes feeding it (%d nodes) are wired up %d times in %s with identical inputs (copy %d of %d). Compute it once and reuse the result."),
+					Duplicate.NumNodes, Duplicate.Copies.Num(), *Graph.GraphName.ToString(), Copy + 1, Duplicate.Copies.Num()),
+				ECommonValidatorsFindingActions::FocusNode));
+		}
+		bHasFindings = true;
+	}
+
+	return (bShouldError && bHasFindings) ? EDataValidationResult::Invalid : EDataValidationResult::Valid;
+}
+
+void UEditorValidator_DuplicatePure::FindDuplicatePureComputations(const FCommonValidatorsBlueprintIndex& Index, TArray<FCommonValidatorsDuplicatePure>& OutDuplicates)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UEditorValidator_DuplicatePure::FindDuplicatePureComputations);
+
+	for (int32 GraphIndex = 0; GraphIndex < Index.Graphs.Num(); ++GraphIndex)
+	{
+		UE::Internal::DuplicatePureValidatorHelpers::FindDuplicates(Index.Graphs[GraphIndex], GraphIndex, OutDuplicates);
+	}
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorValidator_BlueprintBase.h"
+#include "EditorValidator_DuplicatePure.generated.h"
+
+// Pure computations of a graph that are structurally identical: same node types, targets, literals and wiring.
+struct FCommonValidatorsDuplicatePure
+{
+	int32 GraphIndex = INDEX_NONE;
+
+	// Node computing the result of each copy, by node index.
+	TArray<int32> Copies;
+
+	// Pure nodes in one copy, the result node included.
+	int32 NumNodes = 0;
+
+	// Whether every node of a copy is a variable read, a struct make/break or an allowlisted function.
+	bool bIsTrivial = false;
+};
+
+UCLASS()
+class COMMONVALIDATORS_API UEditorValidator_DuplicatePure : public UEditorValidator_BlueprintBase
+{
+	GENERATED_BODY()
+
+	virtual bool IsEnabledInSettings() const override;
+	virtual uint32 GetSettingsHash() const override;
+	virtual bool IsGraphLocal() const override { return true; }
+	virtual EDataValidationResult AnalyzeBlueprint(const FCommonValidatorsBlueprintIndex& Index, TArray<FCommonValidatorsFinding>& OutFindings) const override;
+
+public:
+	/**
+	 * Hash-conses the pure data-flow trees of every graph: each pure node gets the id of its node signature combined with
+	 * the ids of its inputs, computed once per node in post order, so identical trees end up with the same id in linear
+	 * time. Only the largest duplicated trees are returned, not the identical subtrees they are made of.
+	 */
+	static void FindDuplicatePureComputations(const FCommonValidatorsBlueprintIndex& Index, TArray<FCommonValidatorsDuplicatePure>& OutDuplicates);
+};
@@ -11,72 +11,88 @@
 #include "CommonValidatorsStatics.h"
 #include "Engine/MemberReference.h"
 #include "CommonValidatorsDeveloperSettings.h"
+#include "CommonValidatorsGraphIndex.h"
+#include "CommonValidatorsProfiler.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 
-bool UEditorValidator_EmptyTick::CanValidateAsset_Implementation(const FAssetData& InAssetData, UObject* InObject, FDataValidationContext& InContext) const
+DECLARE_CYCLE_STAT(TEXT("Empty Tick Validator"), STAT_CommonValidators_EmptyTick, STATGROUP_CommonValidators);
+
+namespace UE::Internal::EmptyTickValidatorHelpers
+{
+	// Bump when the analysis changes, so cached results are recomputed.
+	static constexpr uint32 AnalysisVersion = 1;
+}
+
+bool UEditorValidator_EmptyTick::IsEnabledInSettings() const
 {
 #if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 6)
 	// Empty ticks are automatically disabled in UE 5.6 onwards, no need to do anything for those versions
 	return false;
 #else
-	bool bIsValidatorEnabled = GetDefault<UCommonValidatorsDeveloperSettings>()->bEnableEmptyTickNodeValidator;
-	return bIsValidatorEnabled && InObject && InObject->IsA<UBlueprint>();
+	return GetDefault<UCommonValidatorsDeveloperSettings>()->bEnableEmptyTickNodeValidator;
 #endif
 }
 
-EDataValidationResult UEditorValidator_EmptyTick::ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
+uint32 UEditorValidator_EmptyTick::GetSettingsHash() const
 {
-	static const FName EventTickName(TEXT("ReceiveTick"));
+	return HashCombine(UE::Internal::EmptyTickValidatorHelpers::AnalysisVersion, GetTypeHash(GetDefault<UCommonValidatorsDeveloperSettings>()->bErrorOnEmptyTickNodes));
+}
+
+EDataValidationResult UEditorValidator_EmptyTick::AnalyzeBlueprint(const FCommonValidatorsBlueprintIndex& Index, TArray<FCommonValidatorsFinding>& OutFindings) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_CommonValidators_EmptyTick);
+
+	TArray<FCommonValidatorsNodeRef> EmptyTicks;
+	FindEmptyTicks(Index, EmptyTicks);
+
+	for (const FCommonValidatorsNodeRef& Ref : EmptyTicks)
+	{
+		bool bShouldError = GetDefault<UCommonValidatorsDeveloperSettings>()->bErrorOnEmptyTickNodes;
+		// add finding, with two actions: one to open the blueprint and focus the node, and one to remove the empty tick node
+		OutFindings.Add(MakeFinding(Index.Graphs[Ref.GraphIndex], Ref.NodeIndex,
+			(bShouldError ? EMessageSeverity::Error : EMessageSeverity::Warning),
+			TEXT("Empty Tick nodes still produce overhead, please use or remove it. "),
+			ECommonValidatorsFindingActions::FocusNode | ECommonValidatorsFindingActions::RemoveNode));
+
+		return bShouldError ? EDataValidationResult::Invalid : EDataValidationResult::Valid;
+	}
+
+	return EDataValidationResult::Valid;
+}
 
-	UBlueprint* Blueprint = Cast<UBlueprint>(InAsset);
-	if (!Blueprint) return EDataValidationResult::NotValidated;
+void UEditorValidator_EmptyTick::FindEmptyTicks(const FCommonValidatorsBlueprintIndex& Index, TArray<FCommonValidatorsNodeRef>& OutNodes)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UEditorValidator_EmptyTick::FindEmptyTicks);
 
-	for (UEdGraph* Graph : Blueprint->UbergraphPages)
+	for (int32 GraphIndex = 0; GraphIndex < Index.Graphs.Num(); ++GraphIndex)
 	{
-		for (UEdGraphNode* Node : Graph->Nodes)
+		const FCommonValidatorsIndexedGraph& IndexedGraph = Index.Graphs[GraphIndex];
+		if (IndexedGraph.Kind != ECommonValidatorsGraphKind::Ubergraph)
+		{
+			continue;
+		}
+
+		for (int32 NodeIndex = 0; NodeIndex < IndexedGraph.Nodes.Num(); ++NodeIndex)
 		{
-			UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node);
-			if (EventNode && EventNode->EventReference.GetMemberName() == EventTickName)
+			const FCommonValidatorsIndexedNode& IndexedNode = IndexedGraph.Nodes[NodeIndex];
+			if (IsTickEvent(IndexedNode) && IsEmptyTick(IndexedNode))
 			{
-				if (IsEmptyTick(EventNode))
-				{
-					bool bShouldError = GetDefault<UCommonValidatorsDeveloperSettings>()->bErrorOnEmptyTickNodes;
-					// add message, with two actions: one to open the blueprint and focus the node, and one to remove the empty tick node
-					TSharedRef<FTokenizedMessage> TokenizedMessage = FTokenizedMessage::Create((bShouldError ? EMessageSeverity::Error : EMessageSeverity::Warning), FText::FromString(TEXT("Empty Tick nodes still produce overhead, please use or remove it. ")));
-					TokenizedMessage->AddToken(FActionToken::Create(
-						FText::FromString(TEXT("Open Blueprint and Focus Node")),
-						FText::FromString(TEXT("Open Blueprint and Focus Node")),
-						FOnActionTokenExecuted::CreateLambda([Blueprint, Graph, EventNode]()
-							{
-								UCommonValidatorsStatics::OpenBlueprintAndFocusNode(Blueprint, Graph, EventNode);
-							}),
-						false
-					));
-
-					TokenizedMessage->AddToken(FActionToken::Create(
-						FText::FromString(TEXT("Remove Empty Tick Node")),
-						FText::FromString(TEXT("Remove Empty Tick Node")),
-						FOnActionTokenExecuted::CreateLambda([Blueprint, Graph, EventNode]()
-							{
-								UCommonValidatorsStatics::DeleteNodeFromBlueprint(Blueprint, Graph, EventNode);
-							}),
-						false
-					));
-
-					Context.AddMessage(TokenizedMessage);
-					
-					return bShouldError ? EDataValidationResult::Invalid : EDataValidationResult::Valid;
-				}
+				OutNodes.Add({ GraphIndex, NodeIndex });
 			}
 		}
 	}
+}
 
-	return EDataValidationResult::Valid;
+bool UEditorValidator_EmptyTick::IsTickEvent(const FCommonValidatorsIndexedNode& Node)
+{
+	static const FName EventTickName(TEXT("ReceiveTick"));
+	return Node.Kind == ECommonValidatorsNodeKind::Event && Node.MemberName == EventTickName;
 }
 
-bool UEditorValidator_EmptyTick::IsEmptyTick(UK2Node_Event* EventNode)
+bool UEditorValidator_EmptyTick::IsEmptyTick(const FCommonValidatorsIndexedNode& EventNode)
 {
-	if (EventNode->IsAutomaticallyPlacedGhostNode()) return false; // Ghost nodes aren't real nodes
+	if (EventNode.bIsGhostNode) return false; // Ghost nodes aren't real nodes
 
-	UEdGraphPin* ExecThenPin = EventNode->FindPin(UEdGraphSchema_K2::PN_Then);
-	return ExecThenPin && ExecThenPin->LinkedTo.IsEmpty();
+	// Events only have the PN_Then exec output
+	return EventNode.bHasExecOutput && !EventNode.bExecOutputLinked;
 }
@@ -1,16 +1,25 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "EditorValidatorBase.h"
+#include "EditorValidator_BlueprintBase.h"
 #include "EditorValidator_EmptyTick.generated.h"
 
 UCLASS()
-class COMMONVALIDATORS_API UEditorValidator_EmptyTick : public UEditorValidatorBase
+class COMMONVALIDATORS_API UEditorValidator_EmptyTick : public UEditorValidator_BlueprintBase
 {
 	GENERATED_BODY()
 	
-	virtual bool CanValidateAsset_Implementation(const FAssetData& InAssetData, UObject* InObject, FDataValidationContext& InContext) const override;
-	virtual EDataValidationResult ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context) override;
+	virtual bool IsEnabledInSettings() const override;
+	virtual uint32 GetSettingsHash() const override;
+	virtual bool IsGraphLocal() const override { return true; }
+	virtual EDataValidationResult AnalyzeBlueprint(const FCommonValidatorsBlueprintIndex& Index, TArray<FCommonValidatorsFinding>& OutFindings) const override;
 
-	bool IsEmptyTick(class UK2Node_Event* EventNode);
+public:
+	// Collects every ReceiveTick event of the Blueprint whose exec output is not connected.
+	static void FindEmptyTicks(const FCommonValidatorsBlueprintIndex& Index, TArray<struct FCommonValidatorsNodeRef>& OutNodes);
+
+	static bool IsTickEvent(const struct FCommonValidatorsIndexedNode& Node);
+
+private:
+	static bool IsEmptyTick(const struct FCommonValidatorsIndexedNode& EventNode);
 };
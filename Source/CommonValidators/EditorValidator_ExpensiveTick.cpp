@@ -0,0 +1,252 @@
+#include "EditorValidator_ExpensiveTick.h"
+
+#include "Misc/DataValidation.h"
+#include "CommonValidatorsCallGraph.h"
+#include "CommonValidatorsDeveloperSettings.h"
+#include "CommonValidatorsGraphIndex.h"
+#include "CommonValidatorsProfiler.h"
+#include "Misc/Crc.h"
+#include "Misc/StringBuilder.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+DECLARE_CYCLE_STAT(TEXT("Expensive Tick Validator"), STAT_CommonValidators_ExpensiveTick, STATGROUP_CommonValidators);
+
+namespace UE::Internal::ExpensiveTickValidatorHelpers
+{
+	// Bump when the analysis changes, so cached results are recomputed.
+	static constexpr uint32 AnalysisVersion = 1;
+
+	// Rules of the findings, see FCommonValidatorsFinding::Rule.
+	static const FName ExpensiveNodeRule(TEXT("ExpensiveNode"));
+	static const FName ExpensiveCallRule(TEXT("ExpensiveCall"));
+
+	// Named steps shown before a path from Tick is cut short.
+	static constexpr int32 MaxPathSteps = 8;
+
+	// Owner class name and function name, the same way the index and call summaries identify functions.
+	using FFunctionKey = TPair<FName, FName>;
+
+	// Matches by name, so none of the listed classes has to be loaded and the lookup works on any thread.
+	static TSet<FFunctionKey> GetExpensiveFunctions(const UCommonValidatorsDeveloperSettings& Settings)
+	{
+		TSet<FFunctionKey> Functions;
+		Functions.Reserve(Settings.ExpensiveTickFunctions.Num());
+		for (const FCommonValidatorsFunctionReference& Function : Settings.ExpensiveTickFunctions)
+		{
+			Functions.Add({ FName(Function.Class.ToSoftObjectPath().GetAssetName()), Function.FunctionName });
+		}
+		return Functions;
+	}
+}
+
+bool UEditorValidator_ExpensiveTick::IsEnabledInSettings() const
+{
+	return GetDefault<UCommonValidatorsDeveloperSettings>()->bEnableExpensiveTickValidator;
+}
+
+uint32 UEditorValidator_ExpensiveTick::GetSettingsHash() const
+{
+	const UCommonValidatorsDeveloperSettings* Settings = GetDefault<UCommonValidatorsDeveloperSettings>();
+
+	uint32 Hash = HashCombine(UE::Internal::ExpensiveTickValidatorHelpers::AnalysisVersion, GetTypeHash(Settings->bErrorOnExpensiveTick));
+	for (const FCommonValidatorsFunctionReference& Function : Settings->ExpensiveTickFunctions)
+	{
+		Hash = FCrc::StrCrc32(*Function.Class.ToString(), Hash);
+		Hash = FCrc::StrCrc32(*Function.FunctionName.ToString(), Hash);
+	}
+	return Hash;
+}
+
+EDataValidationResult UEditorValidator_ExpensiveTick::AnalyzeBlueprint(const FCommonValidatorsBlueprintIndex& Index, TArray<FCommonValidatorsFinding>& OutFindings) const
+{
+	using namespace UE::Internal::ExpensiveTickValidatorHelpers;
+
+	SCOPE_CYCLE_COUNTER(STAT_CommonValidators_ExpensiveTick);
+
+	const UCommonValidatorsDeveloperSettings* Settings = GetDefault<UCommonValidatorsDeveloperSettings>();
+	const bool bShouldError = Settings->bErrorOnExpensiveTick;
+	const EMessageSeverity::Type Severity = bShouldError ? EMessageSeverity::Error : EMessageSeverity::Warning;
+
+	const TSet<FFunctionKey> ExpensiveFunctions = GetExpensiveFunctions(*Settings);
+	if (ExpensiveFunctions.IsEmpty())
+	{
+		return EDataValidationResult::Valid;
+	}
+
+	const int32 NumFindings = OutFindings.Num();
+	FCommonValidatorsTickReach Reach;
+	for (const FCommonValidatorsIndexedGraph& Graph : Index.Graphs)
+	{
+		if (!FindTickReach(Graph, Reach))
+		{
+			continue;
+		}
+
+		for (const int32 NodeIndex : Reach.Order)
+		{
+			const FCommonValidatorsIndexedNode& Node = Graph.Nodes[NodeIndex];
+			// Calls, and nodes expanding into one such as Format Text.
+			if (Node.Function && ExpensiveFunctions.Contains({ Node.FunctionOwnerName, Node.MemberName }))
+			{
+				OutFindings.Add(MakeFinding(Graph, NodeIndex, Severity,
+					FString::Printf(TEXT("{Node} is expensive and runs every frame: %s."), *DescribeTickPath(Graph, Reach, NodeIndex)),
+					ECommonValidatorsFindingActions::FocusNode, ExpensiveNodeRule));
+			}
+
+			const TSharedRef<const FCommonValidatorsCallSummary>* Summary = Graph.CallSummaries.Find(NodeIndex);
+			if (!Summary)
+			{
+				continue;
+			}
+
+			FString PathToNode;
+			for (const FCommonValidatorsReachedCall& Call : (*Summary)->Calls)
+			{
+				if (!ExpensiveFunctions.Contains({ Call.OwnerName, Call.FunctionName }))
+				{
+					continue;
+				}
+
+				if (PathToNode.IsEmpty())
+				{
+					PathToNode = DescribeTickPath(Graph, Reach, NodeIndex);
+				}
+
+				// The chain starts with the graph the node calls, which the path already ends with.
+				TStringBuilder<256> Path;
+				Path << PathToNode;
+				for (int32 Step = 1; Step < Call.Chain.Num(); ++Step)
+				{
+					Path << TEXT(" -> ") << Call.Chain[Step];
+				}
+				Path << TEXT(" -> ") << Call.FunctionName;
+
+				OutFindings.Add(MakeFinding(Graph, NodeIndex, Severity,
+					FString::Printf(TEXT("{Node} calls %s every frame: %s."), *Call.FunctionName.ToString(), *Path),
+					ECommonValidatorsFindingActions::FocusNode, ExpensiveCallRule));
+			}
+		}
+	}
+
+	return (bShouldError && OutFindings.Num() > NumFindings) ? EDataValidationResult::Invalid : EDataValidationResult::Valid;
+}
+
+bool UEditorValidator_ExpensiveTick::IsTickEntry(const FCommonValidatorsIndexedNode& Node)
+{
+	static const FName ReceiveTickName(TEXT("ReceiveTick"));
+	static const FName WidgetTickName(TEXT("Tick"));
+	static const FName UpdateAnimationName(TEXT("BlueprintUpdateAnimation"));
+	static const FName ThreadSafeUpdateAnimationName(TEXT("BlueprintThreadSafeUpdateAnimation"));
+
+	// The thread safe animation update is a function override rather than an event.
+	if (Node.Kind != ECommonValidatorsNodeKind::Event && Node.Kind != ECommonValidatorsNodeKind::FunctionEntry)
+	{
+		return false;
+	}
+
+	return Node.MemberName == ReceiveTickName || Node.MemberName == WidgetTickName
+		|| Node.MemberName == UpdateAnimationName || Node.MemberName == ThreadSafeUpdateAnimationName;
+}
+
+bool UEditorValidator_ExpensiveTick::FindTickReach(const FCommonValidatorsIndexedGraph& Graph, FCommonValidatorsTickReach& OutReach)
+{
+	TArray<int32, TInlineAllocator<4>> TickEntries;
+	for (const int32 Entry : Graph.EntryNodes)
+	{
+		const FCommonValidatorsIndexedNode& Node = Graph.Nodes[Entry];
+		if (IsTickEntry(Node) && !Node.bIsGhostNode)
+		{
+			TickEntries.Add(Entry);
+		}
+	}
+
+	if (TickEntries.IsEmpty())
+	{
+		return false;
+	}
+
+	FindExecReach(Graph, TickEntries, OutReach);
+	return true;
+}
+
+void UEditorValidator_ExpensiveTick::FindExecReach(const FCommonValidatorsIndexedGraph& Graph, TConstArrayView<int32> Roots, FCommonValidatorsTickReach& OutReach)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UEditorValidator_ExpensiveTick::FindExecReach);
+
+	const int32 NumNodes = Graph.Nodes.Num();
+	OutReach.Parents.Init(INDEX_NONE, NumNodes);
+	OutReach.Roots.Init(INDEX_NONE, NumNodes);
+	OutReach.Order.Reset();
+
+	for (const int32 Root : Roots)
+	{
+		if (OutReach.Roots[Root] == INDEX_NONE)
+		{
+			OutReach.Roots[Root] = Root;
+			OutReach.Order.Add(Root);
+		}
+	}
+
+	// Data links are stored from producer to consumer, invert them to find what feeds a node.
+	TArray<int32> ProducerOffsets;
+	TArray<int32> Producers;
+	Graph.BuildDataProducers(ProducerOffsets, Producers);
+
+	auto Visit = [&OutReach](int32 NodeIndex, int32 FromIndex)
+	{
+		if (OutReach.Roots[NodeIndex] == INDEX_NONE)
+		{
+			OutReach.Parents[NodeIndex] = FromIndex;
+			OutReach.Roots[NodeIndex] = OutReach.Roots[FromIndex];
+			OutReach.Order.Add(NodeIndex);
+		}
+	};
+
+	// Breadth-first, so the path reported for each node is one of the shortest.
+	for (int32 Head = 0; Head < OutReach.Order.Num(); ++Head)
+	{
+		const int32 Current = OutReach.Order[Head];
+		for (const int32 Next : Graph.GetExecSuccessors(Current))
+		{
+			Visit(Next, Current);
+		}
+
+		// Impure producers only run when their own exec input fires, their outputs are cached values.
+		for (int32 Offset = ProducerOffsets[Current]; Offset < ProducerOffsets[Current + 1]; ++Offset)
+		{
+			if (Graph.Nodes[Producers[Offset]].bIsPure)
+			{
+				Visit(Producers[Offset], Current);
+			}
+		}
+	}
+}
+
+FString UEditorValidator_ExpensiveTick::DescribeTickPath(const FCommonValidatorsIndexedGraph& Graph, const FCommonValidatorsTickReach& Reach, int32 NodeIndex)
+{
+	using namespace UE::Internal::ExpensiveTickValidatorHelpers;
+
+	TArray<FName, TInlineAllocator<MaxPathSteps>> Steps;
+	int32 Current = NodeIndex;
+	for (; Current != INDEX_NONE && Steps.Num() < MaxPathSteps; Current = Reach.Parents[Current])
+	{
+		// Knots and other anonymous nodes don't tell the reader anything.
+		if (!Graph.Nodes[Current].MemberName.IsNone())
+		{
+			Steps.Add(Graph.Nodes[Current].MemberName);
+		}
+	}
+
+	// Long paths are cut in the middle, the Tick event and the last few steps are what matters.
+	TStringBuilder<256> Path;
+	if (Current != INDEX_NONE)
+	{
+		Path << Graph.Nodes[Reach.Roots[NodeIndex]].MemberName << TEXT(" -> ...");
+	}
+
+	for (int32 Step = Steps.Num() - 1; Step >= 0; --Step)
+	{
+		Path << (Path.Len() > 0 ? TEXT(" -> ") : TEXT("")) << Steps[Step];
+	}
+	return Path.ToString();
+}
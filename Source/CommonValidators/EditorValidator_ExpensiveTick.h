@@ -0,0 +1,46 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorValidator_BlueprintBase.h"
+#include "EditorValidator_ExpensiveTick.generated.h"
+
+// Nodes of a single graph that run every frame because one of its Tick events (or other roots) executes them.
+struct FCommonValidatorsTickReach
+{
+	// Node each node was first reached from, INDEX_NONE for roots and nodes that aren't reached.
+	TArray<int32> Parents;
+
+	// Root each node was first reached from, INDEX_NONE for nodes that aren't reached.
+	TArray<int32> Roots;
+
+	// Reached nodes in breadth-first order, roots first.
+	TArray<int32> Order;
+
+	bool IsReached(int32 NodeIndex) const { return Roots[NodeIndex] != INDEX_NONE; }
+};
+
+UCLASS()
+class COMMONVALIDATORS_API UEditorValidator_ExpensiveTick : public UEditorValidator_BlueprintBase
+{
+	GENERATED_BODY()
+
+	virtual bool IsEnabledInSettings() const override;
+	virtual uint32 GetSettingsHash() const override;
+	virtual EDataValidationResult AnalyzeBlueprint(const FCommonValidatorsBlueprintIndex& Index, TArray<FCommonValidatorsFinding>& OutFindings) const override;
+
+public:
+	// Actor and component ReceiveTick, widget Tick and the Anim Blueprint update events.
+	static bool IsTickEntry(const struct FCommonValidatorsIndexedNode& Node);
+
+	/**
+	 * Walks exec links from every Tick event of the graph, and from each node reached that way back to the pure
+	 * nodes feeding its inputs, since those are evaluated again whenever it runs. Returns false if the graph has no Tick.
+	 */
+	static bool FindTickReach(const struct FCommonValidatorsIndexedGraph& Graph, FCommonValidatorsTickReach& OutReach);
+
+	// Same walk as FindTickReach, starting from the given nodes instead of the Tick events.
+	static void FindExecReach(const struct FCommonValidatorsIndexedGraph& Graph, TConstArrayView<int32> Roots, FCommonValidatorsTickReach& OutReach);
+
+	// "ReceiveTick -> UpdateTargets -> ...", made of the named nodes between the Tick event and NodeIndex (included).
+	static FString DescribeTickPath(const struct FCommonValidatorsIndexedGraph& Graph, const FCommonValidatorsTickReach& Reach, int32 NodeIndex);
+};
@@ -0,0 +1,115 @@
+#include "EditorValidator_HardReferences.h"
+
+#include "Misc/DataValidation.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "CommonValidatorsDeveloperSettings.h"
+#include "CommonValidatorsProfiler.h"
+#include "CommonValidatorsReferenceGraph.h"
+#include "Misc/Crc.h"
+#include "Misc/StringBuilder.h"
+#include "Modules/ModuleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Hard References Validator"), STAT_CommonValidators_HardReferences, STATGROUP_CommonValidators);
+
+namespace UE::Internal::HardReferencesValidatorHelpers
+{
+	// References named in a finding.
+	static constexpr int32 MaxEdges = 5;
+
+	static double ToMegabytes(int64 Bytes)
+	{
+		return static_cast<double>(Bytes) / (1024.0 * 1024.0);
+	}
+
+	static int64 GetBudget(const UCommonValidatorsDeveloperSettings& Settings)
+	{
+		return static_cast<int64>(static_cast<double>(Settings.HardReferenceBudgetMB) * 1024.0 * 1024.0);
+	}
+}
+
+bool UEditorValidator_HardReferences::IsEnabledInSettings() const
+{
+	return GetDefault<UCommonValidatorsDeveloperSettings>()->bEnableHardReferenceValidator;
+}
+
+uint32 UEditorValidator_HardReferences::GetSettingsHash() const
+{
+	const UCommonValidatorsDeveloperSettings* Settings = GetDefault<UCommonValidatorsDeveloperSettings>();
+
+	uint32 Hash = HashCombine(GetTypeHash(Settings->bErrorOnHardReferenceBudget), GetTypeHash(Settings->HardReferenceBudgetMB));
+	for (const FString& IgnoredPath : Settings->HardReferenceIgnoredPaths)
+	{
+		Hash = FCrc::StrCrc32(*IgnoredPath, Hash);
+	}
+	return Hash;
+}
+
+EDataValidationResult UEditorValidator_HardReferences::AnalyzeBlueprint(const FCommonValidatorsBlueprintIndex& Index, TArray<FCommonValidatorsFinding>& OutFindings) const
+{
+	using namespace UE::Internal::HardReferencesValidatorHelpers;
+
+	SCOPE_CYCLE_COUNTER(STAT_CommonValidators_HardReferences);
+
+	const UCommonValidatorsDeveloperSettings* Settings = GetDefault<UCommonValidatorsDeveloperSettings>();
+	const int64 Budget = GetBudget(*Settings);
+
+	if (FCommonValidatorsReferenceGraph::Get().GetClosure(Index.PackageName, 0).DiskSize <= Budget)
+	{
+		return EDataValidationResult::Valid;
+	}
+
+	const FCommonValidatorsReferenceClosure Closure = FCommonValidatorsReferenceGraph::Get().GetClosure(Index.PackageName, MaxEdges);
+
+	TStringBuilder<512> Edges;
+	for (const TPair<FName, int64>& Edge : Closure.Edges)
+	{
+		if (Edges.Len() > 0)
+		{
+			Edges << TEXT(", ");
+		}
+		Edges.Appendf(TEXT("%s (%.1f MB)"), *Edge.Key.ToString(), ToMegabytes(Edge.Value));
+	}
+
+	// Not about any node in particular, so the finding has no graph and is reported against the asset.
+	FCommonValidatorsFinding Finding;
+	Finding.Severity = Settings->bErrorOnHardReferenceBudget ? EMessageSeverity::Error : EMessageSeverity::Warning;
+	Finding.Message = FString::Printf(TEXT("Hard references load %d packages, %.1f MB on disk, over the %.1f MB budget. Largest: %s. Consider soft references or moving the references to a data asset."),
+		Closure.NumPackages, ToMegabytes(Closure.DiskSize), Settings->HardReferenceBudgetMB, Edges.ToString());
+	OutFindings.Add(MoveTemp(Finding));
+
+	return Settings->bErrorOnHardReferenceBudget ? EDataValidationResult::Invalid : EDataValidationResult::Valid;
+}
+
+int64 UEditorValidator_HardReferences::GetClosureSize(FName PackageName)
+{
+	return FCommonValidatorsReferenceGraph::Get().GetClosure(PackageName, 0).DiskSize;
+}
+
+bool UEditorValidator_HardReferences::IsOverBudget(int64 ClosureSize)
+{
+	using namespace UE::Internal::HardReferencesValidatorHelpers;
+
+	return ClosureSize > GetBudget(*GetDefault<UCommonValidatorsDeveloperSettings>());
+}
+
+uint32 UEditorValidator_HardReferences::ComputeReferencesHash(FName PackageName)
+{
+	uint32 Hash = 0;
+	for (const FString& IgnoredPath : GetDefault<UCommonValidatorsDeveloperSettings>()->HardReferenceIgnoredPaths)
+	{
+		Hash = FCrc::StrCrc32(*IgnoredPath, Hash);
+	}
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	TArray<FName> Dependencies;
+	AssetRegistry.GetDependencies(PackageName, Dependencies, UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Hard);
+
+	// Name indices differ between sessions, the hash has to survive them.
+	Dependencies.Sort(FNameLexicalLess());
+	for (const FName Dependency : Dependencies)
+	{
+		Hash = FCrc::StrCrc32(*Dependency.ToString(), Hash);
+	}
+	return Hash;
+}
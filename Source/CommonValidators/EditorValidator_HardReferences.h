@@ -0,0 +1,29 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorValidator_BlueprintBase.h"
+#include "EditorValidator_HardReferences.generated.h"
+
+UCLASS()
+class COMMONVALIDATORS_API UEditorValidator_HardReferences : public UEditorValidator_BlueprintBase
+{
+	GENERATED_BODY()
+
+	virtual bool IsEnabledInSettings() const override;
+	virtual uint32 GetSettingsHash() const override;
+
+	// The closure depends on other assets, which the Blueprint's content hash doesn't cover.
+	virtual bool CanCacheResults() const override { return false; }
+
+	virtual EDataValidationResult AnalyzeBlueprint(const FCommonValidatorsBlueprintIndex& Index, TArray<FCommonValidatorsFinding>& OutFindings) const override;
+
+public:
+	// Disk size of the package's hard reference closure, the package excluded. Only reads the Asset Registry.
+	static int64 GetClosureSize(FName PackageName);
+
+	static bool IsOverBudget(int64 ClosureSize);
+
+	// Hash of the package's direct hard references and the ignored paths, what a closure size taken earlier depends on
+	// besides the size of the packages further down.
+	static uint32 ComputeReferencesHash(FName PackageName);
+};
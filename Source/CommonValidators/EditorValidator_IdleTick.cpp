@@ -0,0 +1,125 @@
+#include "EditorValidator_IdleTick.h"
+
+#include "Misc/DataValidation.h"
+#include "CommonValidatorsDeveloperSettings.h"
+#include "CommonValidatorsGraphIndex.h"
+#include "CommonValidatorsProfiler.h"
+#include "EditorValidator_ExpensiveTick.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+DECLARE_CYCLE_STAT(TEXT("Idle Tick Validator"), STAT_CommonValidators_IdleTick, STATGROUP_CommonValidators);
+
+namespace UE::Internal::IdleTickValidatorHelpers
+{
+	// Bump when the analysis changes, so cached results are recomputed.
+	static constexpr uint32 AnalysisVersion = 1;
+}
+
+bool UEditorValidator_IdleTick::IsEnabledInSettings() const
+{
+	return GetDefault<UCommonValidatorsDeveloperSettings>()->bEnableIdleTickValidator;
+}
+
+uint32 UEditorValidator_IdleTick::GetSettingsHash() const
+{
+	const UCommonValidatorsDeveloperSettings* Settings = GetDefault<UCommonValidatorsDeveloperSettings>();
+	const uint32 Hash = HashCombine(UE::Internal::IdleTickValidatorHelpers::AnalysisVersion, GetTypeHash(Settings->bErrorOnIdleTick));
+	return HashCombine(Hash, GetTypeHash(Settings->bSuggestTickInterval));
+}
+
+EDataValidationResult UEditorValidator_IdleTick::AnalyzeBlueprint(const FCommonValidatorsBlueprintIndex& Index, TArray<FCommonValidatorsFinding>& OutFindings) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_CommonValidators_IdleTick);
+
+	const UCommonValidatorsDeveloperSettings* Settings = GetDefault<UCommonValidatorsDeveloperSettings>();
+	const bool bShouldError = Settings->bErrorOnIdleTick;
+
+	TArray<int32> IdleTicks;
+	FindIdleTicks(Index, IdleTicks);
+
+	for (const int32 ConfigIndex : IdleTicks)
+	{
+		const FCommonValidatorsTickConfig& Config = Index.TickConfigs[ConfigIndex];
+
+		// The class defaults and templates have no node to focus.
+		FCommonValidatorsFinding Finding;
+		Finding.Severity = bShouldError ? EMessageSeverity::Error : EMessageSeverity::Warning;
+		if (Config.bIsComponent)
+		{
+			Finding.Message = FString::Printf(TEXT("Component %s (%s) ticks every frame, but neither its native class nor any Blueprint Tick event does anything with it. Disable Start with Tick Enabled or Can Ever Tick on the component."),
+				*Config.ComponentName.ToString(), *Config.ClassName.ToString());
+		}
+		else
+		{
+			Finding.Message = TEXT("The class defaults tick every frame, but neither the native class nor any Blueprint Tick event does anything with it. Disable Start with Tick Enabled or Can Ever Tick in the class defaults.");
+		}
+		OutFindings.Add(MoveTemp(Finding));
+	}
+
+	if (Settings->bSuggestTickInterval)
+	{
+		TArray<FCommonValidatorsNodeRef> Candidates;
+		FindTickIntervalCandidates(Index, Candidates);
+
+		FCommonValidatorsTickReach Reach;
+		for (const FCommonValidatorsNodeRef& Ref : Candidates)
+		{
+			const FCommonValidatorsIndexedGraph& Graph = Index.Graphs[Ref.GraphIndex];
+			UEditorValidator_ExpensiveTick::FindExecReach(Graph, MakeArrayView(&Ref.NodeIndex, 1), Reach);
+
+			OutFindings.Add(MakeFinding(Graph, Ref.NodeIndex, EMessageSeverity::Info,
+				FString::Printf(TEXT("{Node} runs %d nodes every frame without reading Delta Seconds, so it likely doesn't depend on the frame rate. Consider a Tick Interval in the class defaults, or a timer."), Reach.Order.Num() - 1),
+				ECommonValidatorsFindingActions::FocusNode));
+		}
+	}
+
+	return (bShouldError && IdleTicks.Num() > 0) ? EDataValidationResult::Invalid : EDataValidationResult::Valid;
+}
+
+void UEditorValidator_IdleTick::FindIdleTicks(const FCommonValidatorsBlueprintIndex& Index, TArray<int32>& OutConfigIndices)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UEditorValidator_IdleTick::FindIdleTicks);
+
+	for (int32 ConfigIndex = 0; ConfigIndex < Index.TickConfigs.Num(); ++ConfigIndex)
+	{
+		// Ticks that start disabled are left alone, they are enabled from code when needed.
+		// Native classes that can tick by themselves may do anything in C++, there's no telling from here.
+		const FCommonValidatorsTickConfig& Config = Index.TickConfigs[ConfigIndex];
+		if (Config.bCanEverTick && Config.bStartWithTickEnabled && !Config.bNativeCanEverTick && !Config.bHasBlueprintTick)
+		{
+			OutConfigIndices.Add(ConfigIndex);
+		}
+	}
+}
+
+void UEditorValidator_IdleTick::FindTickIntervalCandidates(const FCommonValidatorsBlueprintIndex& Index, TArray<FCommonValidatorsNodeRef>& OutNodes)
+{
+	static const FName ReceiveTickName(TEXT("ReceiveTick"));
+
+	// Only Blueprints ticking every frame from the start, through their own Tick event.
+	if (Index.TickConfigs.IsEmpty())
+	{
+		return;
+	}
+
+	const FCommonValidatorsTickConfig& Config = Index.TickConfigs[0];
+	if (Config.bIsComponent || !Config.bCanEverTick || !Config.bStartWithTickEnabled || Config.TickInterval > 0.0f)
+	{
+		return;
+	}
+
+	for (int32 GraphIndex = 0; GraphIndex < Index.Graphs.Num(); ++GraphIndex)
+	{
+		const FCommonValidatorsIndexedGraph& Graph = Index.Graphs[GraphIndex];
+		for (const int32 Entry : Graph.EntryNodes)
+		{
+			// Delta Seconds is the event's only data output.
+			const FCommonValidatorsIndexedNode& Node = Graph.Nodes[Entry];
+			if (Node.Kind == ECommonValidatorsNodeKind::Event && Node.MemberName == ReceiveTickName && !Node.bIsGhostNode
+				&& Node.bExecOutputLinked && Graph.GetDataConsumers(Entry).IsEmpty())
+			{
+				OutNodes.Add({ GraphIndex, Entry });
+			}
+		}
+	}
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorValidator_BlueprintBase.h"
+#include "EditorValidator_IdleTick.generated.h"
+
+UCLASS()
+class COMMONVALIDATORS_API UEditorValidator_IdleTick : public UEditorValidator_BlueprintBase
+{
+	GENERATED_BODY()
+
+	virtual bool IsEnabledInSettings() const override;
+	virtual uint32 GetSettingsHash() const override;
+	virtual EDataValidationResult AnalyzeBlueprint(const FCommonValidatorsBlueprintIndex& Index, TArray<FCommonValidatorsFinding>& OutFindings) const override;
+
+public:
+	/**
+	 * Collects the tick configurations (see FCommonValidatorsBlueprintIndex::TickConfigs) that tick from the start although
+	 * neither their native class nor any Blueprint Tick event does anything with it.
+	 */
+	static void FindIdleTicks(const FCommonValidatorsBlueprintIndex& Index, TArray<int32>& OutConfigIndices);
+
+	// Collects the ReceiveTick events of the Blueprint that run every frame, have logic, but don't read Delta Seconds.
+	static void FindTickIntervalCandidates(const FCommonValidatorsBlueprintIndex& Index, TArray<struct FCommonValidatorsNodeRef>& OutNodes);
+};
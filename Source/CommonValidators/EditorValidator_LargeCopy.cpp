@@ -0,0 +1,148 @@
+#include "EditorValidator_LargeCopy.h"
+
+#include "Misc/DataValidation.h"
+#include "CommonValidatorsDeveloperSettings.h"
+#include "CommonValidatorsGraphIndex.h"
+#include "CommonValidatorsProfiler.h"
+#include "EditorValidator_ExpensiveTick.h"
+#include "Misc/StringBuilder.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+DECLARE_CYCLE_STAT(TEXT("Large Copy Validator"), STAT_CommonValidators_LargeCopy, STATGROUP_CommonValidators);
+
+namespace UE::Internal::LargeCopyValidatorHelpers
+{
+	// Bump when the analysis changes, so cached results are recomputed.
+	static constexpr uint32 AnalysisVersion = 1;
+
+	// Rules of the findings, see FCommonValidatorsFinding::Rule.
+	static const FName LoopElementRule(TEXT("LoopElement"));
+	static const FName LoopBodyRule(TEXT("LoopBody"));
+	static const FName TickRule(TEXT("Tick"));
+}
+
+bool UEditorValidator_LargeCopy::IsEnabledInSettings() const
+{
+	return GetDefault<UCommonValidatorsDeveloperSettings>()->bEnableLargeCopyValidator;
+}
+
+uint32 UEditorValidator_LargeCopy::GetSettingsHash() const
+{
+	const UCommonValidatorsDeveloperSettings* Settings = GetDefault<UCommonValidatorsDeveloperSettings>();
+	const uint32 Hash = HashCombine(UE::Internal::LargeCopyValidatorHelpers::AnalysisVersion, GetTypeHash(Settings->bErrorOnLargeCopy));
+	return HashCombine(Hash, GetTypeHash(Settings->LargeCopyThresholdBytes));
+}
+
+EDataValidationResult UEditorValidator_LargeCopy::AnalyzeBlueprint(const FCommonValidatorsBlueprintIndex& Index, TArray<FCommonValidatorsFinding>& OutFindings) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_CommonValidators_LargeCopy);
+
+	const UCommonValidatorsDeveloperSettings* Settings = GetDefault<UCommonValidatorsDeveloperSettings>();
+	const bool bShouldError = Settings->bErrorOnLargeCopy;
+	const EMessageSeverity::Type Severity = bShouldError ? EMessageSeverity::Error : EMessageSeverity::Warning;
+	const int32 Threshold = Settings->LargeCopyThresholdBytes;
+
+	const int32 NumFindings = OutFindings.Num();
+	TBitArray<> Reported;
+	FCommonValidatorsTickReach Reach;
+	for (const FCommonValidatorsIndexedGraph& Graph : Index.Graphs)
+	{
+		// Most graphs copy nothing worth reporting, skip the walks for them.
+		const bool bHasLargeCopies = Graph.Nodes.ContainsByPredicate([Threshold](const FCommonValidatorsIndexedNode& Node) { return Node.CopyBytes >= Threshold; });
+		if (!bHasLargeCopies)
+		{
+			continue;
+		}
+
+		Reported.Init(false, Graph.Nodes.Num());
+
+		// Loops first, a copy made on every iteration is the worse of the two.
+		for (const FCommonValidatorsIndexedLoop& Loop : Graph.Loops)
+		{
+			const FCommonValidatorsIndexedNode& LoopNode = Graph.Nodes[Loop.NodeIndex];
+			if (LoopNode.CopyBytes >= Threshold && !Reported[Loop.NodeIndex])
+			{
+				Reported[Loop.NodeIndex] = true;
+				OutFindings.Add(MakeFinding(Graph, Loop.NodeIndex, Severity,
+					FString::Printf(TEXT("{Node} copies its element (~%d bytes) on every iteration. %s"), LoopNode.CopyBytes, *DescribeFix(LoopNode)),
+					ECommonValidatorsFindingActions::FocusNode, UE::Internal::LargeCopyValidatorHelpers::LoopElementRule));
+			}
+
+			// The body and the pure nodes it reads run once per iteration.
+			UEditorValidator_ExpensiveTick::FindExecReach(Graph, Loop.BodyTargets, Reach);
+			for (const int32 NodeIndex : Reach.Order)
+			{
+				const FCommonValidatorsIndexedNode& Node = Graph.Nodes[NodeIndex];
+				if (NodeIndex == Loop.NodeIndex || Node.CopyBytes < Threshold || Reported[NodeIndex])
+				{
+					continue;
+				}
+
+				Reported[NodeIndex] = true;
+				OutFindings.Add(MakeFinding(Graph, NodeIndex, Severity,
+					FString::Printf(TEXT("{Node} copies ~%d bytes by value on every iteration of %s. %s"), Node.CopyBytes, *LoopNode.MemberName.ToString(), *DescribeFix(Node)),
+					ECommonValidatorsFindingActions::FocusNode, UE::Internal::LargeCopyValidatorHelpers::LoopBodyRule));
+			}
+		}
+
+		if (!UEditorValidator_ExpensiveTick::FindTickReach(Graph, Reach))
+		{
+			continue;
+		}
+
+		// What each Tick event copies per frame in total, for context.
+		TMap<int32, int64> BytesPerRoot;
+		for (const int32 NodeIndex : Reach.Order)
+		{
+			BytesPerRoot.FindOrAdd(Reach.Roots[NodeIndex]) += Graph.Nodes[NodeIndex].CopyBytes;
+		}
+
+		for (const int32 NodeIndex : Reach.Order)
+		{
+			const FCommonValidatorsIndexedNode& Node = Graph.Nodes[NodeIndex];
+			if (Node.CopyBytes < Threshold || Reported[NodeIndex])
+			{
+				continue;
+			}
+
+			const int32 Root = Reach.Roots[NodeIndex];
+			Reported[NodeIndex] = true;
+			OutFindings.Add(MakeFinding(Graph, NodeIndex, Severity,
+				FString::Printf(TEXT("{Node} copies ~%d bytes by value every frame: %s. %s copies ~%lld bytes per frame in total. %s"),
+					Node.CopyBytes, *UEditorValidator_ExpensiveTick::DescribeTickPath(Graph, Reach, NodeIndex),
+					*Graph.Nodes[Root].MemberName.ToString(), BytesPerRoot.FindRef(Root), *DescribeFix(Node)),
+				ECommonValidatorsFindingActions::FocusNode, UE::Internal::LargeCopyValidatorHelpers::TickRule));
+		}
+	}
+
+	return (bShouldError && OutFindings.Num() > NumFindings) ? EDataValidationResult::Invalid : EDataValidationResult::Valid;
+}
+
+FString UEditorValidator_LargeCopy::DescribeFix(const FCommonValidatorsIndexedNode& Node)
+{
+	TStringBuilder<256> Fix;
+	auto Add = [&Fix](const TCHAR* Sentence)
+	{
+		Fix << (Fix.Len() > 0 ? TEXT(" ") : TEXT("")) << Sentence;
+	};
+
+	if (EnumHasAnyFlags(Node.CopyKinds, ECommonValidatorsCopyKind::ArrayGetCopy))
+	{
+		Add(TEXT("Change it to Get (a ref)."));
+	}
+	if (EnumHasAnyFlags(Node.CopyKinds, ECommonValidatorsCopyKind::LoopElement))
+	{
+		Add(TEXT("Loop over the indices with a ForLoop and Get (a ref) instead."));
+	}
+	if (EnumHasAnyFlags(Node.CopyKinds, ECommonValidatorsCopyKind::BlueprintByValueInput))
+	{
+		Add(TEXT("Tick Pass-by-Reference on the function's struct and container inputs."));
+	}
+	if (EnumHasAnyFlags(Node.CopyKinds, ECommonValidatorsCopyKind::NativeByValueInput | ECommonValidatorsCopyKind::Output))
+	{
+		Add(Node.bIsPure
+			? TEXT("Its values are copied again each time it is evaluated, cache the result in a variable or read only the members needed.")
+			: TEXT("Return or pass only the members needed, or keep the data where it is and access it by reference."));
+	}
+	return Fix.ToString();
+}
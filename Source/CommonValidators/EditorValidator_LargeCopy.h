@@ -0,0 +1,20 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorValidator_BlueprintBase.h"
+#include "EditorValidator_LargeCopy.generated.h"
+
+UCLASS()
+class COMMONVALIDATORS_API UEditorValidator_LargeCopy : public UEditorValidator_BlueprintBase
+{
+	GENERATED_BODY()
+
+	virtual bool IsEnabledInSettings() const override;
+	virtual uint32 GetSettingsHash() const override;
+	virtual bool IsGraphLocal() const override { return true; }
+	virtual EDataValidationResult AnalyzeBlueprint(const FCommonValidatorsBlueprintIndex& Index, TArray<FCommonValidatorsFinding>& OutFindings) const override;
+
+public:
+	// How to avoid the copies a node makes.
+	static FString DescribeFix(const struct FCommonValidatorsIndexedNode& Node);
+};
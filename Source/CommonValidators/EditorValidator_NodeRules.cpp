@@ -0,0 +1,157 @@
+#include "EditorValidator_NodeRules.h"
+
+#include "Misc/DataValidation.h"
+#include "CommonValidatorsDeveloperSettings.h"
+#include "CommonValidatorsGraphIndex.h"
+#include "CommonValidatorsNodeRules.h"
+#include "CommonValidatorsProfiler.h"
+#include "EdGraphSchema_K2.h"
+#include "EditorValidator_ExpensiveTick.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+DECLARE_CYCLE_STAT(TEXT("Node Rule Validator"), STAT_CommonValidators_NodeRules, STATGROUP_CommonValidators);
+
+namespace UE::Internal::NodeRuleValidatorHelpers
+{
+	// Bump when the analysis changes, so cached results are recomputed.
+	static constexpr uint32 AnalysisVersion = 1;
+
+	// Rule of the findings, numbered after the matched entry of NodeRules. See FCommonValidatorsFinding::Rule.
+	static const FName NodeRuleName(TEXT("NodeRule"));
+
+	static EMessageSeverity::Type GetMessageSeverity(ECommonValidatorsRuleSeverity Severity)
+	{
+		switch (Severity)
+		{
+		case ECommonValidatorsRuleSeverity::Info:
+			return EMessageSeverity::Info;
+		case ECommonValidatorsRuleSeverity::Error:
+			return EMessageSeverity::Error;
+		default:
+			return EMessageSeverity::Warning;
+		}
+	}
+
+	// Reach of the construction script, false if the graph has none.
+	static bool FindConstructionScriptReach(const FCommonValidatorsIndexedGraph& Graph, FCommonValidatorsTickReach& OutReach)
+	{
+		TArray<int32, TInlineAllocator<1>> Entries;
+		for (const int32 Entry : Graph.EntryNodes)
+		{
+			const FCommonValidatorsIndexedNode& Node = Graph.Nodes[Entry];
+			if (Node.Kind == ECommonValidatorsNodeKind::FunctionEntry && Node.MemberName == UEdGraphSchema_K2::FN_UserConstructionScript)
+			{
+				Entries.Add(Entry);
+			}
+		}
+
+		if (Entries.IsEmpty())
+		{
+			return false;
+		}
+
+		UEditorValidator_ExpensiveTick::FindExecReach(Graph, Entries, OutReach);
+		return true;
+	}
+}
+
+bool UEditorValidator_NodeRules::IsEnabledInSettings() const
+{
+	const UCommonValidatorsDeveloperSettings* Settings = GetDefault<UCommonValidatorsDeveloperSettings>();
+	return Settings->bEnableNodeRuleValidator && Settings->NodeRules.Num() > 0;
+}
+
+uint32 UEditorValidator_NodeRules::GetSettingsHash() const
+{
+	const UCommonValidatorsDeveloperSettings* Settings = GetDefault<UCommonValidatorsDeveloperSettings>();
+
+	uint32 Hash = HashCombine(UE::Internal::NodeRuleValidatorHelpers::AnalysisVersion, FCommonValidatorsNodeRules::ComputeSettingsHash());
+	for (const FCommonValidatorsNodeRule& Rule : Settings->NodeRules)
+	{
+		Hash = HashCombine(Hash, GetTypeHash(Rule.Severity));
+		Hash = HashCombine(Hash, GetTypeHash(Rule.Scope));
+		Hash = HashCombine(Hash, GetTypeHash(Rule.Message));
+	}
+	return Hash;
+}
+
+EDataValidationResult UEditorValidator_NodeRules::AnalyzeBlueprint(const FCommonValidatorsBlueprintIndex& Index, TArray<FCommonValidatorsFinding>& OutFindings) const
+{
+	using namespace UE::Internal::NodeRuleValidatorHelpers;
+
+	SCOPE_CYCLE_COUNTER(STAT_CommonValidators_NodeRules);
+
+	const UCommonValidatorsDeveloperSettings* Settings = GetDefault<UCommonValidatorsDeveloperSettings>();
+
+	bool bHasErrors = false;
+	FCommonValidatorsTickReach TickReach;
+	FCommonValidatorsTickReach ConstructionScriptReach;
+	for (const FCommonValidatorsIndexedGraph& Graph : Index.Graphs)
+	{
+		// Rules were matched while indexing, only the matching nodes are left to look at.
+		if (Graph.RuleMatches.IsEmpty())
+		{
+			continue;
+		}
+
+		// Walked at most once per graph, and only for graphs with a scoped match.
+		TOptional<bool> bHasTick;
+		TOptional<bool> bHasConstructionScript;
+
+		for (const TPair<int32, int32>& Match : Graph.RuleMatches)
+		{
+			// The index may predate a change of the rules, the result cache key doesn't.
+			if (!Settings->NodeRules.IsValidIndex(Match.Value))
+			{
+				continue;
+			}
+
+			const FCommonValidatorsNodeRule& Rule = Settings->NodeRules[Match.Value];
+			const int32 NodeIndex = Match.Key;
+
+			FString Where;
+			if (Rule.Scope == ECommonValidatorsRuleScope::Tick)
+			{
+				if (!bHasTick.IsSet())
+				{
+					bHasTick = UEditorValidator_ExpensiveTick::FindTickReach(Graph, TickReach);
+				}
+				if (!bHasTick.GetValue() || !TickReach.IsReached(NodeIndex))
+				{
+					continue;
+				}
+				Where = FString::Printf(TEXT(" It runs every frame: %s."), *UEditorValidator_ExpensiveTick::DescribeTickPath(Graph, TickReach, NodeIndex));
+			}
+			else if (Rule.Scope == ECommonValidatorsRuleScope::ConstructionScript)
+			{
+				if (!bHasConstructionScript.IsSet())
+				{
+					bHasConstructionScript = FindConstructionScriptReach(Graph, ConstructionScriptReach);
+				}
+				if (!bHasConstructionScript.GetValue() || !ConstructionScriptReach.IsReached(NodeIndex))
+				{
+					continue;
+				}
+				Where = FString::Printf(TEXT(" It runs in the construction script: %s."), *UEditorValidator_ExpensiveTick::DescribeTickPath(Graph, ConstructionScriptReach, NodeIndex));
+			}
+
+			const FString Message = Rule.Message.IsEmpty() ? TEXT("{Node} is not allowed by the project's node rules.") : Rule.Message;
+			const EMessageSeverity::Type Severity = GetMessageSeverity(Rule.Severity);
+			bHasErrors |= Severity == EMessageSeverity::Error;
+
+			OutFindings.Add(MakeFinding(Graph, NodeIndex, Severity, Message + Where, ECommonValidatorsFindingActions::FocusNode, FName(NodeRuleName, Match.Value + 1)));
+		}
+	}
+
+	return bHasErrors ? EDataValidationResult::Invalid : EDataValidationResult::Valid;
+}
+
+int32 UEditorValidator_NodeRules::CountRuleMatches(const FCommonValidatorsBlueprintIndex& Index)
+{
+	int32 NumMatches = 0;
+	for (const FCommonValidatorsIndexedGraph& Graph : Index.Graphs)
+	{
+		NumMatches += Graph.RuleMatches.Num();
+	}
+	return NumMatches;
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorValidator_BlueprintBase.h"
+#include "EditorValidator_NodeRules.generated.h"
+
+UCLASS()
+class COMMONVALIDATORS_API UEditorValidator_NodeRules : public UEditorValidator_BlueprintBase
+{
+	GENERATED_BODY()
+
+	virtual bool IsEnabledInSettings() const override;
+	virtual uint32 GetSettingsHash() const override;
+	virtual bool IsGraphLocal() const override { return true; }
+	virtual EDataValidationResult AnalyzeBlueprint(const FCommonValidatorsBlueprintIndex& Index, TArray<FCommonValidatorsFinding>& OutFindings) const override;
+
+public:
+	// Number of rule matches in the Blueprint, whatever their scope.
+	static int32 CountRuleMatches(const FCommonValidatorsBlueprintIndex& Index);
+};
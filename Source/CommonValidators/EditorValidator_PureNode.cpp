@@ -8,292 +8,1255 @@
 #include "K2Node_CallFunction.h"
 #include "K2Node_BreakStruct.h"
 #include "K2Node_Variable.h"
+#include "K2Node_VariableGet.h"
+#include "K2Node_VariableSet.h"
+#include "Kismet2/BlueprintEditorUtils.h"
 #include "CommonValidatorsStatics.h"
 #include "CommonValidatorsDeveloperSettings.h"
+#include "CommonValidatorsGraphIndex.h"
+#include "CommonValidatorsProfiler.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "CommonValidatorsAssetTags.h"
 #include "K2Node.h"
+#include "Algo/Unique.h"
+
+DECLARE_CYCLE_STAT(TEXT("Pure Node Validator"), STAT_CommonValidators_PureNode, STATGROUP_CommonValidators);
 
 namespace UE::Internal::PureNodeValidatorHelpers
 {
-	bool IsHarmlessPureNode(UK2Node_CallFunction* CallNode)
-	{
-		if (!CallNode) return false;
+	// Bump when the analysis changes, so cached results are recomputed.
+	static constexpr uint32 AnalysisVersion = 3;
+
+	// Rules of the findings, see FCommonValidatorsFinding::Rule.
+	static const FName LoopInputRule(TEXT("LoopInput"));
+	static const FName LoopBodyRule(TEXT("LoopBody"));
+	static const FName MultiExecRule(TEXT("MultiExec"));
+
+	// WhileLoop's per-iteration input. It has to be read again for the loop to ever end, so it's never worth caching.
+	static const FName ConditionPinName(TEXT("Condition"));
 
-		UFunction* Func = CallNode->GetTargetFunction();
-		if (!Func)
+	// Exec nodes known to leave alone whatever a pure node could read. Sets of local variables the node reads are
+	// rejected separately, the others can't be seen by the node.
+	static bool MayChangeState(const FCommonValidatorsIndexedNode& Node)
+	{
+		if (Node.bIsFlowControl)
 		{
 			return false;
 		}
 
-		if (Func->HasMetaData(TEXT("NativeBreakFunc")) || Func->HasMetaData(TEXT("NativeMakeFunc")))
+		switch (Node.Kind)
 		{
+		case ECommonValidatorsNodeKind::Event:
+		case ECommonValidatorsNodeKind::FunctionEntry:
+		case ECommonValidatorsNodeKind::FunctionResult:
+		case ECommonValidatorsNodeKind::Knot:
+			return false;
+		case ECommonValidatorsNodeKind::VariableSet:
+			return !Node.bIsLocalVariable;
+		default:
 			return true;
 		}
+	}
+
+	/**
+	 * Data-flow analysis of a single indexed graph, shared by every pure node in it.
+	 * The impure exec sinks of each node are memoized as interned sets, so checking all pure nodes of a graph
+	 * walks the data-flow DAG only once. Loops are resolved once per loop up front.
+	 */
+	class FGraphAnalysis
+	{
+	public:
+		explicit FGraphAnalysis(const FCommonValidatorsIndexedGraph& InGraph)
+			: Graph(InGraph)
+		{
+			const int32 NumNodes = Graph.Nodes.Num();
+			SinkState.SetNumZeroed(NumNodes);
+			NodeSinkSets.Init(INDEX_NONE, NumNodes);
+			SinkIds.Init(INDEX_NONE, NumNodes);
+			for (int32 NodeIndex = 0; NodeIndex < NumNodes; ++NodeIndex)
+			{
+				if (Graph.Nodes[NodeIndex].bExecInputLinked && Graph.ExecReachable[NodeIndex])
+				{
+					SinkIds[NodeIndex] = SinkNodes.Add(NodeIndex);
+				}
+			}
+			NumSinkWords = FMath::DivideAndRoundUp(SinkNodes.Num(), 32);
+
+			// Set 0 is the empty set, shared by every node no reachable sink reads.
+			SinkSets.AddDefaulted();
+
+			if (Graph.Loops.Num() > 0)
+			{
+				AnalyzeLoops();
+			}
+		}
+
+		// Fills in everything but OutNode.Ref. Returns false if the node is evaluated once per execution of its reader.
+		bool FindRepeatedEvaluation(int32 PureNodeIndex, FCommonValidatorsRepeatedPureNode& OutNode)
+		{
+			// The pure node itself has no exec input, so its sinks are exactly the union of its consumers' sinks.
+			const FSinkSetView NodeSinks = GetImpureSinks(PureNodeIndex);
+			OutNode.NumReaders = NodeSinks.Num();
+
+			if (Graph.Loops.Num() == 0)
+			{
+				return OutNode.NumReaders > 1;
+			}
+
+			const int32 InputLoop = PerIterationInputLoops[PureNodeIndex];
+			if (InputLoop != INDEX_NONE && !LoopVarying[InputLoop][PureNodeIndex])
+			{
+				OutNode.LoopIndex = InputLoop;
+				OutNode.LoopDepth = LoopDepths[Graph.Loops[InputLoop].NodeIndex] + 1;
+				OutNode.bFeedsLoopInput = true;
+				OutNode.bCacheMayChangeResult = LoopsChangingState[InputLoop];
+				return true;
+			}
+
+			for (const int32 Sink : NodeSinks)
+			{
+				// The innermost enclosing loop the node doesn't depend on, it could be evaluated once before that loop.
+				for (const int32 LoopIndex : EnclosingLoops[Sink])
+				{
+					if (LoopVarying[LoopIndex][PureNodeIndex])
+					{
+						continue;
+					}
+
+					const int32 Depth = LoopDepths[Graph.Loops[LoopIndex].NodeIndex] + 1;
+					if (Depth > OutNode.LoopDepth)
+					{
+						OutNode.LoopIndex = LoopIndex;
+						OutNode.LoopDepth = Depth;
+					}
+					break;
+				}
+			}
+
+			if (OutNode.LoopIndex != INDEX_NONE)
+			{
+				OutNode.bCacheMayChangeResult = LoopsChangingState[OutNode.LoopIndex];
+				return true;
+			}
+			return OutNode.NumReaders > 1;
+		}
 
-		UClass* OwnerClass = Func->GetOuterUClass();
-		if (!OwnerClass)
+		/**
+		 * Finds the closest exec node dominating every reader of a repeated node, and the loop repeating it, where its
+		 * result could be stored once. Rejected when something the node reads isn't available there yet, when a
+		 * variable it reads is set from there on, since the stored result would go stale, or when some readers could
+		 * run without going through the store. Flagged as a suggestion when other nodes running between the store and
+		 * the readers may change the result.
+		 */
+		void FindCachePoint(int32 PureNodeIndex, FCommonValidatorsRepeatedPureNode& InOutNode)
 		{
+			TRACE_CPUPROFILER_EVENT_SCOPE(FGraphAnalysis::FindCachePoint);
+
+			// Storing a WhileLoop condition once before the loop would change what the graph does.
+			if (InOutNode.bFeedsLoopInput && Graph.Loops[InOutNode.LoopIndex].PerIterationPinName == ConditionPinName)
+			{
+				return;
+			}
+
+			if (!Dominators.IsSet())
+			{
+				Dominators.Emplace();
+				Dominators->Build(Graph);
+			}
+			BuildProducers();
+
+			int32 CachePoint = INDEX_NONE;
+			TArray<int32, TInlineAllocator<8>> Readers;
+			auto AddReader = [this, &CachePoint, &Readers](int32 Reader)
+			{
+				CachePoint = Readers.IsEmpty() ? Reader : Dominators->FindCommonDominator(CachePoint, Reader);
+				Readers.Add(Reader);
+			};
+			for (const int32 Sink : GetImpureSinks(PureNodeIndex))
+			{
+				AddReader(Sink);
+			}
+			if (InOutNode.LoopIndex != INDEX_NONE)
+			{
+				AddReader(Graph.Loops[InOutNode.LoopIndex].NodeIndex);
+			}
+			if (CachePoint == INDEX_NONE)
+			{
+				return;
+			}
+
+			// Entries, timelines and gates have no PN_Execute input to insert before, their outputs are available right after them.
+			const bool bAfter = !Graph.Nodes[CachePoint].bHasExecInput;
+
+			// Readers only go through the store if it sits on the single way into or out of the cache point: not
+			// before an exec input other pins bypass, nor after one of several linked exec outputs. The extra inputs
+			// of flow control nodes are control signals, like Break on a loop or Reset on a DoOnce, and don't count.
+			const FCommonValidatorsIndexedNode& CachePointNode = Graph.Nodes[CachePoint];
+			if (bAfter ? CachePointNode.bSeveralExecOutputsLinked : (CachePointNode.bHasOtherExecInputs && !CachePointNode.bIsFlowControl))
+			{
+				return;
+			}
+
+			TSet<FName> ReadVariables;
+			Visited.Init(false, Graph.Nodes.Num());
+			Visited[PureNodeIndex] = true;
+			Stack.Reset();
+			Stack.Add(PureNodeIndex);
+			while (Stack.Num() > 0)
+			{
+				const int32 Current = Stack.Pop(EAllowShrinking::No);
+				for (int32 Offset = ProducerOffsets[Current]; Offset < ProducerOffsets[Current + 1]; ++Offset)
+				{
+					const int32 Producer = Producers[Offset];
+					if (Visited[Producer])
+					{
+						continue;
+					}
+					Visited[Producer] = true;
+
+					const FCommonValidatorsIndexedNode& Node = Graph.Nodes[Producer];
+					if (!Node.bIsPure)
+					{
+						// Outputs of exec nodes only exist once they ran.
+						if (!Dominators->Dominates(Producer, CachePoint) || (Producer == CachePoint && !bAfter))
+						{
+							return;
+						}
+						continue;
+					}
+
+					if (Node.Kind == ECommonValidatorsNodeKind::VariableGet)
+					{
+						ReadVariables.Add(Node.MemberName);
+					}
+					Stack.Add(Producer);
+				}
+			}
+
+			if (ReadVariables.Num() > 0)
+			{
+				Visited.Init(false, Graph.Nodes.Num());
+				Visited[CachePoint] = true;
+				Stack.Reset();
+				Stack.Add(CachePoint);
+				while (Stack.Num() > 0)
+				{
+					const int32 Current = Stack.Pop(EAllowShrinking::No);
+					const FCommonValidatorsIndexedNode& Node = Graph.Nodes[Current];
+					if (Node.Kind == ECommonValidatorsNodeKind::VariableSet && ReadVariables.Contains(Node.MemberName))
+					{
+						return;
+					}
+
+					for (const int32 Successor : Graph.GetExecSuccessors(Current))
+					{
+						if (!Visited[Successor])
+						{
+							Visited[Successor] = true;
+							Stack.Add(Successor);
+						}
+					}
+				}
+			}
+
+			InOutNode.CachePoint = CachePoint;
+			InOutNode.bCacheAfterPoint = bAfter;
+			InOutNode.bCacheMayChangeResult |= MayChangeBetween(CachePoint, bAfter, Readers);
+		}
+
+	private:
+		/**
+		 * Finds the loops enclosing each node and the values that change from one iteration to the next,
+		 * and marks the pure nodes evaluated through a loop's per-iteration input. Variables the body sets or
+		 * passes by reference are tracked, other state the body may change is only flagged per loop.
+		 */
+		void AnalyzeLoops()
+		{
+			TRACE_CPUPROFILER_EVENT_SCOPE(FGraphAnalysis::AnalyzeLoops);
+
+			const int32 NumNodes = Graph.Nodes.Num();
+			EnclosingLoops.SetNum(NumNodes);
+			LoopDepths.Init(0, NumNodes);
+			PerIterationInputLoops.Init(INDEX_NONE, NumNodes);
+			LoopVarying.SetNum(Graph.Loops.Num());
+			LoopsChangingState.Init(false, Graph.Loops.Num());
+			BuildProducers();
+
+			TSet<FName> SetVariables;
+			for (int32 LoopIndex = 0; LoopIndex < Graph.Loops.Num(); ++LoopIndex)
+			{
+				const FCommonValidatorsIndexedLoop& Loop = Graph.Loops[LoopIndex];
+
+				// The loop's own outputs, impure body nodes and variables set by the body change every iteration.
+				// Pure nodes reading them have to be evaluated again anyway.
+				TBitArray<>& Varying = LoopVarying[LoopIndex];
+				Varying.Init(false, NumNodes);
+				Varying[Loop.NodeIndex] = true;
+				Stack.Reset();
+				Stack.Add(Loop.NodeIndex);
+
+				SetVariables.Reset();
+				for (const int32 BodyNode : Loop.BodyNodes)
+				{
+					EnclosingLoops[BodyNode].Add(LoopIndex);
+					Varying[BodyNode] = true;
+					Stack.Add(BodyNode);
+
+					const FCommonValidatorsIndexedNode& Node = Graph.Nodes[BodyNode];
+					if (Node.Kind == ECommonValidatorsNodeKind::VariableSet)
+					{
+						SetVariables.Add(Node.MemberName);
+					}
+					else if (MayChangeState(Node))
+					{
+						LoopsChangingState[LoopIndex] = true;
+					}
+				}
+
+				// By-ref inputs of body nodes, e.g. the array of an Array Remove, write to the variables they read,
+				// directly or through pure nodes returning a reference.
+				for (const TPair<int32, int32>& Write : Graph.ByRefWrites)
+				{
+					if (Varying[Write.Key])
+					{
+						CollectReadVariables(Write.Value, SetVariables);
+					}
+				}
+
+				if (SetVariables.Num() > 0)
+				{
+					for (int32 NodeIndex = 0; NodeIndex < NumNodes; ++NodeIndex)
+					{
+						const FCommonValidatorsIndexedNode& Node = Graph.Nodes[NodeIndex];
+						if (Node.Kind == ECommonValidatorsNodeKind::VariableGet && !Varying[NodeIndex] && SetVariables.Contains(Node.MemberName))
+						{
+							Varying[NodeIndex] = true;
+							Stack.Add(NodeIndex);
+						}
+					}
+				}
+
+				while (Stack.Num() > 0)
+				{
+					const int32 Current = Stack.Pop(EAllowShrinking::No);
+					for (const int32 Consumer : Graph.GetDataConsumers(Current))
+					{
+						if (Graph.Nodes[Consumer].bIsPure && !Varying[Consumer])
+						{
+							Varying[Consumer] = true;
+							Stack.Add(Consumer);
+						}
+					}
+				}
+			}
+
+			// A loop nested in another one is part of its body, so the deeper loop node is the inner loop.
+			for (int32 NodeIndex = 0; NodeIndex < NumNodes; ++NodeIndex)
+			{
+				LoopDepths[NodeIndex] = EnclosingLoops[NodeIndex].Num();
+			}
+			for (TArray<int32, TInlineAllocator<2>>& NodeLoops : EnclosingLoops)
+			{
+				NodeLoops.Sort([this](int32 A, int32 B) { return LoopDepths[Graph.Loops[A].NodeIndex] > LoopDepths[Graph.Loops[B].NodeIndex]; });
+			}
+
+			// Pure nodes feeding a per-iteration input, directly or through other pure nodes, run once per iteration too.
+			for (int32 LoopIndex = 0; LoopIndex < Graph.Loops.Num(); ++LoopIndex)
+			{
+				Stack.Reset();
+				auto Visit = [this, LoopIndex](int32 NodeIndex)
+				{
+					if (Graph.Nodes[NodeIndex].bIsPure && PerIterationInputLoops[NodeIndex] == INDEX_NONE)
+					{
+						PerIterationInputLoops[NodeIndex] = LoopIndex;
+						Stack.Add(NodeIndex);
+					}
+				};
+
+				for (const int32 Producer : Graph.Loops[LoopIndex].PerIterationProducers)
+				{
+					Visit(Producer);
+				}
+				while (Stack.Num() > 0)
+				{
+					const int32 Current = Stack.Pop(EAllowShrinking::No);
+					for (int32 Offset = ProducerOffsets[Current]; Offset < ProducerOffsets[Current + 1]; ++Offset)
+					{
+						Visit(Producers[Offset]);
+					}
+				}
+			}
+		}
+
+		/**
+		 * Whether a node running after the store and before one of the readers may change what the pure node returns.
+		 * Each reader evaluated it again after those nodes ran, a stored result wouldn't see their changes. Readers
+		 * followed by other readers count too, and so do the bodies of loops reading it again on the next iteration.
+		 */
+		bool MayChangeBetween(int32 CachePoint, bool bAfter, TConstArrayView<int32> Readers)
+		{
+			if (ExecPredecessorOffsets.IsEmpty())
+			{
+				Graph.BuildExecPredecessors(ExecPredecessorOffsets, ExecPredecessors);
+			}
+
+			const int32 NumNodes = Graph.Nodes.Num();
+			TBitArray<> IsReader(false, NumNodes);
+			TBitArray<> BeforeReader(false, NumNodes);
+			Stack.Reset();
+			auto MarkBeforeReader = [this, &BeforeReader](int32 NodeIndex)
+			{
+				for (int32 Offset = ExecPredecessorOffsets[NodeIndex]; Offset < ExecPredecessorOffsets[NodeIndex + 1]; ++Offset)
+				{
+					const int32 Predecessor = ExecPredecessors[Offset];
+					if (!BeforeReader[Predecessor])
+					{
+						BeforeReader[Predecessor] = true;
+						Stack.Add(Predecessor);
+					}
+				}
+			};
+			for (const int32 Reader : Readers)
+			{
+				IsReader[Reader] = true;
+				MarkBeforeReader(Reader);
+			}
+			while (Stack.Num() > 0)
+			{
+				MarkBeforeReader(Stack.Pop(EAllowShrinking::No));
+			}
+
+			Visited.Init(false, NumNodes);
+			auto Visit = [this](int32 NodeIndex)
+			{
+				if (!Visited[NodeIndex])
+				{
+					Visited[NodeIndex] = true;
+					Stack.Add(NodeIndex);
+				}
+			};
+			if (bAfter)
+			{
+				for (const int32 Successor : Graph.GetExecSuccessors(CachePoint))
+				{
+					Visit(Successor);
+				}
+			}
+			else
+			{
+				Visit(CachePoint);
+			}
+			while (Stack.Num() > 0)
+			{
+				for (const int32 Successor : Graph.GetExecSuccessors(Stack.Pop(EAllowShrinking::No)))
+				{
+					Visit(Successor);
+				}
+			}
+
+			for (const FCommonValidatorsIndexedLoop& Loop : Graph.Loops)
+			{
+				if (Visited[Loop.NodeIndex] && (IsReader[Loop.NodeIndex] || Loop.BodyNodes.ContainsByPredicate([&IsReader](int32 BodyNode) { return IsReader[BodyNode]; })))
+				{
+					for (const int32 BodyNode : Loop.BodyNodes)
+					{
+						BeforeReader[BodyNode] = true;
+					}
+				}
+			}
+
+			for (TConstSetBitIterator<> It(Visited); It; ++It)
+			{
+				if (BeforeReader[It.GetIndex()] && MayChangeState(Graph.Nodes[It.GetIndex()]))
+				{
+					return true;
+				}
+			}
 			return false;
 		}
-		
-		const FString OwnerName = OwnerClass->GetName();
-
-		if (OwnerName.Contains(TEXT("KismetMathLibrary")) ||
-			OwnerName.Contains(TEXT("KismetSystemLibrary")) ||
-			OwnerName.Contains(TEXT("KismetTextLibrary")) ||
-			OwnerName.Contains(TEXT("KismetStringTableLibrary")) ||
-			OwnerName.Contains(TEXT("KismetRenderingLibrary")) ||
-			OwnerName.Contains(TEXT("KismetMaterialLibrary")) ||
-			OwnerName.Contains(TEXT("KismetInternationalizationLibrary")) ||
-			OwnerName.Contains(TEXT("KismetInputLibrary")) ||
-			OwnerName.Contains(TEXT("KismetGuidLibrary")) ||
-			OwnerName.Contains(TEXT("KismetArrayLibrary")) ||
-			OwnerName.Contains(TEXT("GameplayStatics")) ||
-			OwnerName.Contains(TEXT("DataTableFunctionLibrary")) ||
-			OwnerName.Contains(TEXT("BlueprintSetLibrary")) ||
-			OwnerName.Contains(TEXT("BlueprintPlatformLibrary")) ||
-			OwnerName.Contains(TEXT("BlueprintPathsLibrary")) ||
-			OwnerName.Contains(TEXT("BlueprintMapLibrary")) ||
-			OwnerName.Contains(TEXT("BlueprintInstancedStructLibrary")) ||
-			OwnerName.Contains(TEXT("KismetNodeHelperLibrary")))
+
+		// Adds the variables NodeIndex reads, directly or through the pure nodes it depends on.
+		void CollectReadVariables(int32 NodeIndex, TSet<FName>& OutVariables) const
 		{
-			return true;
+			TArray<int32, TInlineAllocator<16>> Pending;
+			TArray<int32, TInlineAllocator<16>> Seen;
+			Pending.Add(NodeIndex);
+			Seen.Add(NodeIndex);
+			while (Pending.Num() > 0)
+			{
+				const int32 Current = Pending.Pop(EAllowShrinking::No);
+				const FCommonValidatorsIndexedNode& Node = Graph.Nodes[Current];
+				if (!Node.bIsPure)
+				{
+					continue;
+				}
+				if (Node.Kind == ECommonValidatorsNodeKind::VariableGet)
+				{
+					OutVariables.Add(Node.MemberName);
+				}
+				for (int32 Offset = ProducerOffsets[Current]; Offset < ProducerOffsets[Current + 1]; ++Offset)
+				{
+					if (!Seen.Contains(Producers[Offset]))
+					{
+						Seen.Add(Producers[Offset]);
+						Pending.Add(Producers[Offset]);
+					}
+				}
+			}
 		}
 
-		//TODO: Allow users to expand the list above? --KaosSpectrum
-		//Maybe find a better way (though i can't think of one...)
-		
+		void BuildProducers()
+		{
+			if (ProducerOffsets.IsEmpty())
+			{
+				Graph.BuildDataProducers(ProducerOffsets, Producers);
+			}
+		}
+
+		enum class ESinkState : uint8
+		{
+			Unvisited,
+			Expanding,
+			Done
+		};
+
+		/**
+		 * Set of reachable impure sinks, interned so every node reaching the same sinks shares it: a chain of pure
+		 * nodes points at its reader's set, only nodes merging distinct sets add one. Sets are stored as sorted sink
+		 * ids, or as one bit per sink of the graph once that takes fewer words.
+		 */
+		struct FSinkSet
+		{
+			int32 Num = 0;
+
+			// Into SinkSetData.
+			int32 Offset = 0;
+
+			bool bDense = false;
+		};
 
-		return false;
+		// Node indices of a sink set, in node order. Only valid until the next GetImpureSinks call.
+		class FSinkSetView
+		{
+		public:
+			FSinkSetView(const FGraphAnalysis& InAnalysis, const FSinkSet& InSet)
+				: Analysis(InAnalysis)
+				, Set(InSet)
+			{
+			}
+
+			int32 Num() const
+			{
+				return Set.Num;
+			}
+
+			class FIterator
+			{
+			public:
+				FIterator(const FSinkSetView& InView, int32 InPosition)
+					: View(InView)
+					, Position(InPosition)
+				{
+					SkipClearBits();
+				}
+
+				int32 operator*() const
+				{
+					const FGraphAnalysis& Analysis = View.Analysis;
+					return Analysis.SinkNodes[View.Set.bDense ? Position : Analysis.SinkSetData[View.Set.Offset + Position]];
+				}
+
+				FIterator& operator++()
+				{
+					++Position;
+					SkipClearBits();
+					return *this;
+				}
+
+				bool operator!=(const FIterator& Other) const
+				{
+					return Position != Other.Position;
+				}
+
+			private:
+				// Dense sets iterate over sink ids, stopping at the ones set.
+				void SkipClearBits()
+				{
+					if (!View.Set.bDense)
+					{
+						return;
+					}
+
+					const TArray<uint32>& Data = View.Analysis.SinkSetData;
+					const int32 End = View.Analysis.SinkNodes.Num();
+					while (Position < End)
+					{
+						const uint32 Word = Data[View.Set.Offset + Position / 32] >> (Position % 32);
+						if (Word != 0)
+						{
+							Position += FMath::CountTrailingZeros(Word);
+							return;
+						}
+						Position = (Position / 32 + 1) * 32;
+					}
+					Position = End;
+				}
+
+				const FSinkSetView& View;
+				int32 Position;
+			};
+
+			FIterator begin() const
+			{
+				return FIterator(*this, 0);
+			}
+
+			FIterator end() const
+			{
+				return FIterator(*this, Set.bDense ? Analysis.SinkNodes.Num() : Set.Num);
+			}
+
+		private:
+			const FGraphAnalysis& Analysis;
+			const FSinkSet Set;
+		};
+
+		/**
+		 * Returns the set of reachable impure sinks that consume NodeIndex's data, i.e. the first nodes
+		 * with a connected exec input found along each data path. Results are memoized per node and the
+		 * traversal is iterative, so deep pure chains cost one visit per node and edge overall.
+		 */
+		FSinkSetView GetImpureSinks(int32 RootIndex)
+		{
+			if (SinkState[RootIndex] == ESinkState::Done)
+			{
+				return FSinkSetView(*this, SinkSets[NodeSinkSets[RootIndex]]);
+			}
+
+			TRACE_CPUPROFILER_EVENT_SCOPE(FGraphAnalysis::GetImpureSinks);
+
+			Stack.Reset();
+			Stack.Add(RootIndex);
+			while (Stack.Num() > 0)
+			{
+				const int32 Current = Stack.Last();
+				ESinkState& State = SinkState[Current];
+
+				if (State == ESinkState::Done)
+				{
+					Stack.Pop(EAllowShrinking::No);
+				}
+				else if (State == ESinkState::Unvisited)
+				{
+					if (Graph.Nodes[Current].bExecInputLinked)
+					{
+						NodeSinkSets[Current] = 0;
+						if (SinkIds[Current] != INDEX_NONE)
+						{
+							const uint32 SinkId = SinkIds[Current];
+							NodeSinkSets[Current] = InternSinkSet(MakeArrayView(&SinkId, 1), 1, false);
+						}
+						State = ESinkState::Done;
+						Stack.Pop(EAllowShrinking::No);
+						continue;
+					}
+
+					// Children are finalized before we come back to this entry; cycles (which K2 does not
+					// allow on data pins anyway) are broken by skipping nodes that are still expanding.
+					State = ESinkState::Expanding;
+					for (int32 Consumer : Graph.GetDataConsumers(Current))
+					{
+						if (SinkState[Consumer] == ESinkState::Unvisited)
+						{
+							Stack.Add(Consumer);
+						}
+					}
+				}
+				else
+				{
+					MergeSets.Reset();
+					for (int32 Consumer : Graph.GetDataConsumers(Current))
+					{
+						const int32 ConsumerSet = NodeSinkSets[Consumer];
+						if (ConsumerSet > 0)
+						{
+							MergeSets.AddUnique(ConsumerSet);
+						}
+					}
+
+					NodeSinkSets[Current] = MergeSets.Num() == 0 ? 0 : MergeSets.Num() == 1 ? MergeSets[0] : MergeSinkSets();
+					State = ESinkState::Done;
+					Stack.Pop(EAllowShrinking::No);
+				}
+			}
+
+			return FSinkSetView(*this, SinkSets[NodeSinkSets[RootIndex]]);
+		}
+
+		// Union of the sets in MergeSets, interned.
+		int32 MergeSinkSets()
+		{
+			bool bAnyDense = false;
+			int32 MaxNum = 0;
+			for (const int32 SetIndex : MergeSets)
+			{
+				bAnyDense |= SinkSets[SetIndex].bDense;
+				MaxNum += SinkSets[SetIndex].Num;
+			}
+
+			if (!bAnyDense && MaxNum <= NumSinkWords)
+			{
+				MergeData.Reset();
+				for (const int32 SetIndex : MergeSets)
+				{
+					const FSinkSet& Set = SinkSets[SetIndex];
+					MergeData.Append(SinkSetData.GetData() + Set.Offset, Set.Num);
+				}
+				MergeData.Sort();
+				MergeData.SetNum(Algo::Unique(MergeData), EAllowShrinking::No);
+				return InternSinkSet(MergeData, MergeData.Num(), false);
+			}
+
+			MergeData.Init(0, NumSinkWords);
+			for (const int32 SetIndex : MergeSets)
+			{
+				const FSinkSet& Set = SinkSets[SetIndex];
+				for (int32 Index = 0; Index < (Set.bDense ? NumSinkWords : Set.Num); ++Index)
+				{
+					const uint32 Value = SinkSetData[Set.Offset + Index];
+					if (Set.bDense)
+					{
+						MergeData[Index] |= Value;
+					}
+					else
+					{
+						MergeData[Value / 32] |= 1u << (Value % 32);
+					}
+				}
+			}
+
+			int32 Num = 0;
+			for (const uint32 Word : MergeData)
+			{
+				Num += FMath::CountBits(Word);
+			}
+			if (Num > NumSinkWords)
+			{
+				return InternSinkSet(MergeData, Num, true);
+			}
+
+			// Overlapping sets may end up small enough for sorted ids.
+			TArray<uint32, TInlineAllocator<64>> Ids;
+			for (int32 WordIndex = 0; WordIndex < NumSinkWords; ++WordIndex)
+			{
+				for (uint32 Word = MergeData[WordIndex]; Word != 0; Word &= Word - 1)
+				{
+					Ids.Add(WordIndex * 32 + FMath::CountTrailingZeros(Word));
+				}
+			}
+			return InternSinkSet(Ids, Num, false);
+		}
+
+		// Index of the set with the given data in SinkSets, added if there is none yet.
+		int32 InternSinkSet(TConstArrayView<uint32> Data, int32 Num, bool bDense)
+		{
+			const uint32 Hash = HashCombine(FCrc::MemCrc32(Data.GetData(), Data.Num() * sizeof(uint32)), GetTypeHash(Num));
+			for (TMultiMap<uint32, int32>::TConstKeyIterator It(SinkSetsByHash, Hash); It; ++It)
+			{
+				const FSinkSet& Set = SinkSets[It.Value()];
+				if (Set.Num == Num && Set.bDense == bDense && FMemory::Memcmp(SinkSetData.GetData() + Set.Offset, Data.GetData(), Data.Num() * sizeof(uint32)) == 0)
+				{
+					return It.Value();
+				}
+			}
+
+			const int32 SetIndex = SinkSets.Num();
+			SinkSets.Add({ Num, SinkSetData.Num(), bDense });
+			SinkSetData.Append(Data.GetData(), Data.Num());
+			SinkSetsByHash.Add(Hash, SetIndex);
+			return SetIndex;
+		}
+
+		const FCommonValidatorsIndexedGraph& Graph;
+
+		TArray<ESinkState> SinkState;
+
+		// Reachable impure sinks get dense ids in node order, INDEX_NONE for other nodes.
+		TArray<int32> SinkIds;
+		TArray<int32> SinkNodes;
+		int32 NumSinkWords = 0;
+
+		// Set of each node in SinkSets, INDEX_NONE until it's done. Sorted ids or bit words of every set in SinkSetData.
+		TArray<int32> NodeSinkSets;
+		TArray<FSinkSet> SinkSets;
+		TArray<uint32> SinkSetData;
+		TMultiMap<uint32, int32> SinkSetsByHash;
+
+		// Loops whose body executes each node, innermost first. Only filled for graphs with loops, like the members below.
+		TArray<TArray<int32, TInlineAllocator<2>>> EnclosingLoops;
+		TArray<int32> LoopDepths;
+
+		// Loop whose per-iteration input each node feeds.
+		TArray<int32> PerIterationInputLoops;
+
+		// Per loop, the nodes whose value changes from one iteration to the next.
+		TArray<TBitArray<>> LoopVarying;
+
+		// Loops whose body runs nodes that may change state the analysis can't follow, like calls with side effects.
+		TBitArray<> LoopsChangingState;
+
+		// Inverted data and exec links and exec dominators, built the first time they are needed.
+		TArray<int32> ProducerOffsets;
+		TArray<int32> Producers;
+		TArray<int32> ExecPredecessorOffsets;
+		TArray<int32> ExecPredecessors;
+		TOptional<FCommonValidatorsExecDominators> Dominators;
+
+		// Scratch containers reused by every traversal.
+		TArray<int32> Stack;
+		TArray<int32, TInlineAllocator<8>> MergeSets;
+		TArray<uint32> MergeData;
+		TBitArray<> Visited;
+	};
+
+	// Node reading one of the pure node's outputs, directly or through the sub pins of a split struct output.
+	struct FReaderLink
+	{
+		UEdGraphPin* Reader = nullptr;
+
+		// Index of the sub pin at each split level, empty for the output itself.
+		TArray<int32, TInlineAllocator<2>> SubPinPath;
+	};
+
+	static void CollectReaderLinks(UEdGraphPin* Pin, TArray<int32, TInlineAllocator<2>>& InOutPath, TArray<FReaderLink>& OutLinks)
+	{
+		for (UEdGraphPin* Reader : Pin->LinkedTo)
+		{
+			OutLinks.Add({ Reader, InOutPath });
+		}
+		for (int32 SubIndex = 0; SubIndex < Pin->SubPins.Num(); ++SubIndex)
+		{
+			InOutPath.Add(SubIndex);
+			CollectReaderLinks(Pin->SubPins[SubIndex], InOutPath, OutLinks);
+			InOutPath.Pop(EAllowShrinking::No);
+		}
 	}
-	
-    // Finds every event/function entry (no incoming exec) in the graph.
-    static void CollectExecEntries(UEdGraph* Graph, TSet<UEdGraphNode*>& OutEntries)
-    {
-        for (UEdGraphNode* Node : Graph->Nodes)
-        {
-            if (Node->FindPin(UEdGraphSchema_K2::PN_Execute, EGPD_Input) == nullptr)
-            {
-                OutEntries.Add(Node);
-            }
-        }
-    }
 
-    // Marks all nodes reachable via exec pins from those entries.
-    static void CollectReachableExecNodes(UEdGraph* Graph, TSet<UEdGraphNode*>& OutReachable)
-    {
-        TSet<UEdGraphNode*> Visited;
-        TArray<UEdGraphNode*> Queue;
+	// Splits Pin the way the reader's output was, returns the sub pin the reader was linked to.
+	static UEdGraphPin* SplitAlongPath(UEdGraphPin* Pin, TConstArrayView<int32> SubPinPath)
+	{
+		const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+		for (const int32 SubIndex : SubPinPath)
+		{
+			if (Pin->SubPins.IsEmpty())
+			{
+				Schema->SplitPin(Pin, false);
+			}
+			if (!Pin->SubPins.IsValidIndex(SubIndex))
+			{
+				return nullptr;
+			}
+			Pin = Pin->SubPins[SubIndex];
+		}
+		return Pin;
+	}
 
-        CollectExecEntries(Graph, Visited);
-        for (UEdGraphNode* Entry : Visited)
-        {
-            Queue.Add(Entry);
-        }
+	// Marks the pure nodes feeding NodeIndex or fed by it, directly or not: rewriting it changes their readers.
+	static void MarkDataLinked(const FCommonValidatorsIndexedGraph& Graph, int32 NodeIndex, TBitArray<>& InOutLinked)
+	{
+		if (InOutLinked.IsEmpty())
+		{
+			InOutLinked.Init(false, Graph.Nodes.Num());
+		}
 
-        while (Queue.Num() > 0)
-        {
-            UEdGraphNode* Current = Queue.Pop();
-            OutReachable.Add(Current);
+		TArray<int32> ProducerOffsets;
+		TArray<int32> Producers;
+		Graph.BuildDataProducers(ProducerOffsets, Producers);
 
-            for (UEdGraphPin* Pin : Current->Pins)
-            {
-                if (Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec && Pin->Direction == EGPD_Output)
-                {
-                    for (UEdGraphPin* Link : Pin->LinkedTo)
-                    {
-                        UEdGraphNode* Next = Link->GetOwningNode();
-                        if (!Visited.Contains(Next))
-                        {
-                            Visited.Add(Next);
-                            Queue.Add(Next);
-                        }
-                    }
-                }
-            }
-        }
-    }
+		for (const bool bTowardsProducers : { true, false })
+		{
+			TArray<int32> Stack = { NodeIndex };
+			while (Stack.Num() > 0)
+			{
+				const int32 Current = Stack.Pop(EAllowShrinking::No);
+				const TArrayView<const int32> Linked = bTowardsProducers
+					? TArrayView<const int32>(Producers.GetData() + ProducerOffsets[Current], ProducerOffsets[Current + 1] - ProducerOffsets[Current])
+					: Graph.GetDataConsumers(Current);
+				for (const int32 Next : Linked)
+				{
+					if (Graph.Nodes[Next].bIsPure && !InOutLinked[Next])
+					{
+						InOutLinked[Next] = true;
+						Stack.Add(Next);
+					}
+				}
+			}
+		}
+		InOutLinked[NodeIndex] = true;
+	}
 
-    // Walks the data‑pin graph until the first connected exec‑input is found.
-    static UEdGraphNode* FindFirstImpureSink(UEdGraphNode* StartNode)
-    {
-        TSet<UEdGraphNode*> Visited;
-        TArray<UEdGraphNode*> Queue = { StartNode };
+	// Rewrites a single repeated node found on an index of the Blueprint as it is now, see UEditorValidator_PureNode::CacheInVariables.
+	static bool CacheInVariable(UBlueprint* Blueprint, const FCommonValidatorsIndexedGraph& IndexedGraph, const FCommonValidatorsRepeatedPureNode& Repeated)
+	{
+		UEdGraph* Graph = IndexedGraph.Graph;
+		UEdGraphNode* PureNode = IndexedGraph.Nodes[Repeated.Ref.NodeIndex].Node;
+		UEdGraphNode* CachePointNode = IndexedGraph.Nodes[Repeated.CachePoint].Node;
+		const bool bCacheAfterPoint = Repeated.bCacheAfterPoint;
+		const bool bLocal = IndexedGraph.Kind == ECommonValidatorsGraphKind::Function;
 
-        while (Queue.Num() > 0)
-        {
-            UEdGraphNode* Current = Queue.Pop();
-            if (Visited.Contains(Current))
-            {
-                continue;
-            }
-            Visited.Add(Current);
+		// The exec pin the assignments are spliced into: the cache point's own exec input, or the single linked exec
+		// output of an entry, timeline or gate, which FindCachePoint checked every reader goes through.
+		UEdGraphPin* SplicePin = nullptr;
+		if (bCacheAfterPoint)
+		{
+			for (UEdGraphPin* Pin : CachePointNode->Pins)
+			{
+				if (Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec && Pin->Direction == EGPD_Output && Pin->LinkedTo.Num() > 0)
+				{
+					if (SplicePin)
+					{
+						return false;
+					}
+					SplicePin = Pin;
+				}
+			}
+		}
+		else
+		{
+			SplicePin = CachePointNode->FindPin(UEdGraphSchema_K2::PN_Execute, EGPD_Input);
+		}
 
-            if (UEdGraphPin* ExecIn = Current->FindPin(UEdGraphSchema_K2::PN_Execute, EGPD_Input))
-            {
-                if (ExecIn->LinkedTo.Num() > 0)
-                {
-                    return Current;
-                }
-            }
+		TArray<UEdGraphPin*> Outputs;
+		TArray<TArray<FReaderLink>> OutputReaders;
+		for (UEdGraphPin* Pin : PureNode->Pins)
+		{
+			if (Pin->Direction != EGPD_Output || Pin->ParentPin || Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec
+				|| Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Wildcard)
+			{
+				continue;
+			}
 
-            for (UEdGraphPin* Pin : Current->Pins)
-            {
-                if (Pin->Direction == EGPD_Output && Pin->PinType.PinCategory != UEdGraphSchema_K2::PC_Exec)
-                {
-                    for (UEdGraphPin* Link : Pin->LinkedTo)
-                    {
-                        Queue.Add(Link->GetOwningNode());
-                    }
-                    for (UEdGraphPin* Sub : Pin->SubPins)
-                    {
-                        for (UEdGraphPin* Link : Sub->LinkedTo)
-                        {
-                            Queue.Add(Link->GetOwningNode());
-                        }
-                    }
-                }
-            }
-        }
+			TArray<int32, TInlineAllocator<2>> Path;
+			TArray<FReaderLink> Links;
+			CollectReaderLinks(Pin, Path, Links);
+			if (Links.Num() > 0)
+			{
+				Outputs.Add(Pin);
+				OutputReaders.Add(MoveTemp(Links));
+			}
+		}
+		if (!SplicePin || Outputs.IsEmpty())
+		{
+			return false;
+		}
 
-        return nullptr;
-    }
+		Blueprint->Modify();
+		Graph->Modify();
+		PureNode->Modify();
 
-    bool WillPureNodeFireMultipleTimes(UK2Node* PureFunctionNode, UEdGraph* Graph)
-    {
-        TSet<UEdGraphNode*> Reachable;
-        CollectReachableExecNodes(Graph, Reachable);
+		const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+		const FString FunctionName = IndexedGraph.Nodes[Repeated.Ref.NodeIndex].MemberName.ToString();
+		TArray<UK2Node_VariableSet*> SetNodes;
+		for (int32 OutputIndex = 0; OutputIndex < Outputs.Num(); ++OutputIndex)
+		{
+			UEdGraphPin* Output = Outputs[OutputIndex];
+			FEdGraphPinType VariableType = Output->PinType;
+			VariableType.bIsReference = false;
+			VariableType.bIsConst = false;
 
-        TSet<UEdGraphNode*> DataConsumers;
-        for (UEdGraphPin* Pin : PureFunctionNode->Pins)
-        {
-            if (Pin->Direction != EGPD_Output || Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec)
-            {
-                continue;
-            }
+			const FString BaseName = Outputs.Num() > 1 ? FString::Printf(TEXT("Cached%s_%s"), *FunctionName, *Output->PinName.ToString()) : FString::Printf(TEXT("Cached%s"), *FunctionName);
+			const FName VariableName = FBlueprintEditorUtils::FindUniqueKismetName(Blueprint, BaseName);
 
-            for (UEdGraphPin* Link : Pin->LinkedTo)
-            {
-                DataConsumers.Add(Link->GetOwningNode());
-            }
-            for (UEdGraphPin* Sub : Pin->SubPins)
-            {
-                for (UEdGraphPin* Link : Sub->LinkedTo)
-                {
-                    DataConsumers.Add(Link->GetOwningNode());
-                }
-            }
-        }
+			FMemberReference Reference;
+			if (bLocal)
+			{
+				UEdGraph* FunctionGraph = FBlueprintEditorUtils::GetTopLevelGraph(Graph);
+				if (!FBlueprintEditorUtils::AddLocalVariable(Blueprint, FunctionGraph, VariableName, VariableType))
+				{
+					return false;
+				}
+				Reference.SetLocalMember(VariableName, FunctionGraph->GetName(), FBlueprintEditorUtils::FindLocalVariableGuidByName(Blueprint, FunctionGraph, VariableName));
+			}
+			else
+			{
+				if (!FBlueprintEditorUtils::AddMemberVariable(Blueprint, VariableName, VariableType))
+				{
+					return false;
+				}
+				Reference.SetSelfMember(VariableName, FBlueprintEditorUtils::FindMemberVariableGuidByName(Blueprint, VariableName));
+			}
 
-        TSet<UEdGraphNode*> ExecSinks;
-        for (UEdGraphNode* Consumer : DataConsumers)
-        {
-            UEdGraphNode* Sink = FindFirstImpureSink(Consumer);
-            if (Sink != nullptr && Reachable.Contains(Sink))
-            {
-                ExecSinks.Add(Sink);
-                if (ExecSinks.Num() > 1)
-                {
-                    return true;
-                }
-            }
-        }
+			// Every reader gets the variable instead, split the same way if it read a sub pin. The output itself is
+			// recombined, the whole value is stored.
+			for (const FReaderLink& Link : OutputReaders[OutputIndex])
+			{
+				UEdGraphNode* ReaderNode = Link.Reader->GetOwningNode();
 
-        return false;
-    }
+				FGraphNodeCreator<UK2Node_VariableGet> GetCreator(*Graph);
+				UK2Node_VariableGet* GetNode = GetCreator.CreateNode();
+				GetNode->VariableReference = Reference;
+				GetNode->NodePosX = ReaderNode->NodePosX - 200;
+				GetNode->NodePosY = ReaderNode->NodePosY - 64;
+				GetCreator.Finalize();
+
+				Link.Reader->BreakAllPinLinks();
+				UEdGraphPin* ValuePin = GetNode->GetValuePin();
+				if (UEdGraphPin* Source = ValuePin ? SplitAlongPath(ValuePin, Link.SubPinPath) : nullptr)
+				{
+					Source->MakeLinkTo(Link.Reader);
+				}
+			}
+			if (Output->SubPins.Num() > 0)
+			{
+				Schema->RecombinePin(Output->SubPins[0]);
+			}
+
+			FGraphNodeCreator<UK2Node_VariableSet> SetCreator(*Graph);
+			UK2Node_VariableSet* SetNode = SetCreator.CreateNode();
+			SetNode->VariableReference = Reference;
+			SetNode->NodePosX = CachePointNode->NodePosX + (bCacheAfterPoint ? 250 : -250) * (SetNodes.Num() + 1);
+			SetNode->NodePosY = CachePointNode->NodePosY + 150;
+			SetCreator.Finalize();
+
+			if (UEdGraphPin* ValuePin = SetNode->FindPin(VariableName, EGPD_Input))
+			{
+				Output->MakeLinkTo(ValuePin);
+			}
+			SetNodes.Add(SetNode);
+		}
+
+		// Splice the assignments into the exec flow, in order.
+		const TArray<UEdGraphPin*> SplicedLinks = SplicePin->LinkedTo;
+		SplicePin->BreakAllPinLinks();
+		for (int32 SetIndex = 1; SetIndex < SetNodes.Num(); ++SetIndex)
+		{
+			SetNodes[SetIndex - 1]->GetThenPin()->MakeLinkTo(SetNodes[SetIndex]->GetExecPin());
+		}
+
+		UEdGraphPin* FirstExec = SetNodes[0]->GetExecPin();
+		UEdGraphPin* LastThen = SetNodes.Last()->GetThenPin();
+		if (bCacheAfterPoint)
+		{
+			SplicePin->MakeLinkTo(FirstExec);
+			for (UEdGraphPin* Linked : SplicedLinks)
+			{
+				LastThen->MakeLinkTo(Linked);
+			}
+		}
+		else
+		{
+			for (UEdGraphPin* Linked : SplicedLinks)
+			{
+				Linked->MakeLinkTo(FirstExec);
+			}
+			LastThen->MakeLinkTo(SplicePin);
+		}
+
+		Graph->NotifyGraphChanged();
+		return true;
+	}
 } // namespace UE::Internal::PureNodeValidatorHelpers
 
 
-bool UEditorValidator_PureNode::CanValidateAsset_Implementation(
-    const FAssetData& InAssetData,
-    UObject* InObject,
-    FDataValidationContext& InContext) const
+bool UEditorValidator_PureNode::IsEnabledInSettings() const
 {
-	bool bIsValidatorEnabled = GetDefault<UCommonValidatorsDeveloperSettings>()->bEnablePureNodeMultiExecValidator;
-    return bIsValidatorEnabled && (InObject != nullptr) && InObject->IsA<UBlueprint>();
+	return GetDefault<UCommonValidatorsDeveloperSettings>()->bEnablePureNodeMultiExecValidator;
 }
 
+uint32 UEditorValidator_PureNode::GetSettingsHash() const
+{
+	const uint32 Hash = HashCombine(UE::Internal::PureNodeValidatorHelpers::AnalysisVersion, GetTypeHash(GetDefault<UCommonValidatorsDeveloperSettings>()->bErrorOnPureNodeMultiExec));
+	return HashCombine(Hash, FCommonValidatorsAssetTags::ComputePureNodeSettingsHash());
+}
 
-EDataValidationResult UEditorValidator_PureNode::ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
+EDataValidationResult UEditorValidator_PureNode::AnalyzeBlueprint(const FCommonValidatorsBlueprintIndex& Index, TArray<FCommonValidatorsFinding>& OutFindings) const
 {
-    UBlueprint* Blueprint = Cast<UBlueprint>(InAsset);
-    if (Blueprint == nullptr)
-    {
-        return EDataValidationResult::NotValidated;
-    }
-	bool bFoundBadNode = false;
+	SCOPE_CYCLE_COUNTER(STAT_CommonValidators_PureNode);
+
 	bool bShouldError = GetDefault<UCommonValidatorsDeveloperSettings>()->bErrorOnPureNodeMultiExec;
 
-	TArray<UEdGraph*> AllGraphs;
-	AllGraphs.Append(Blueprint->FunctionGraphs);
-	AllGraphs.Append(Blueprint->UbergraphPages);
-	
-    for (UEdGraph* Graph : AllGraphs)
+    TArray<FCommonValidatorsRepeatedPureNode> BadNodes;
+    FindRepeatedPureNodes(Index, BadNodes);
+
+    for (const FCommonValidatorsRepeatedPureNode& BadNode : BadNodes)
     {
-        for (UEdGraphNode* Node : Graph->Nodes)
+        const FCommonValidatorsIndexedGraph& Graph = Index.Graphs[BadNode.Ref.GraphIndex];
+
+        FString Message;
+        FName Rule = UE::Internal::PureNodeValidatorHelpers::MultiExecRule;
+        if (BadNode.LoopIndex != INDEX_NONE)
         {
-            if (Node->IsA<UK2Node_BreakStruct>() || Node->IsA<UK2Node_Variable>())
+            const FCommonValidatorsIndexedLoop& Loop = Graph.Loops[BadNode.LoopIndex];
+            const FString LoopName = Graph.Nodes[Loop.NodeIndex].MemberName.ToString();
+            const FString Multiplier = BadNode.LoopDepth > 1
+                ? FString::Printf(TEXT("on every iteration of %d nested loops (innermost %s)"), BadNode.LoopDepth, *LoopName)
+                : FString::Printf(TEXT("on every iteration of %s"), *LoopName);
+
+            Message = BadNode.bFeedsLoopInput
+                ? FString::Printf(TEXT("{Node} is evaluated %s through its %s input."), *Multiplier, *Loop.PerIterationPinName.ToString())
+                : FString::Printf(TEXT("{Node} is evaluated %s by the loop body, but reads nothing the loop sets."), *Multiplier);
+            if (BadNode.bFeedsLoopInput && Loop.PerIterationPinName == UE::Internal::PureNodeValidatorHelpers::ConditionPinName)
             {
-                continue;
+                Message += TEXT(" Keep it cheap, the loop needs it on every iteration.");
             }
-
-            UK2Node_CallFunction* CallNode = Cast<UK2Node_CallFunction>(Node);
-            if (CallNode == nullptr)
+            else if (BadNode.bCacheMayChangeResult)
             {
-                continue;
+                Message += TEXT(" Nodes in or before the loop may change its result, check they don't before caching it in a local variable before the loop.");
             }
-
-            if (UFunction* TargetFunc = CallNode->GetTargetFunction())
+            else
             {
-                if (TargetFunc->HasMetaData(TEXT("NativeBreakFunc")) ||
-                    TargetFunc->HasMetaData(TEXT("NativeMakeFunc")))
-                {
-                    continue;
-                }
+                Message += TEXT(" Cache the result in a local variable before the loop.");
             }
+            Rule = BadNode.bFeedsLoopInput ? UE::Internal::PureNodeValidatorHelpers::LoopInputRule : UE::Internal::PureNodeValidatorHelpers::LoopBodyRule;
+        }
+        else
+        {
+            Message = FString::Printf(TEXT("{Node} is evaluated %d times per execution, once for each exec node reading it. Convert to exec or avoid using across multiple exec nodes."), BadNode.NumReaders);
+        }
 
-            if (!CallNode->IsNodePure() || UE::Internal::PureNodeValidatorHelpers::IsHarmlessPureNode(CallNode))
+        ECommonValidatorsFindingActions Actions = ECommonValidatorsFindingActions::FocusNode;
+        if (BadNode.CachePoint != INDEX_NONE)
+        {
+            if (!BadNode.bCacheMayChangeResult)
             {
-                continue;
+                Actions |= ECommonValidatorsFindingActions::CacheInVariable;
             }
-
-            if (UE::Internal::PureNodeValidatorHelpers::WillPureNodeFireMultipleTimes(CallNode, Graph))
+            else if (BadNode.LoopIndex == INDEX_NONE)
             {
-                const FText Title = CallNode->GetNodeTitle(ENodeTitleType::MenuTitle);
-                const FText Message = FText::Format(
-                    NSLOCTEXT("PureNodeValidator", "MultiCallWarning",
-                              "{0} will execute more than once. Convert to exec or avoid using across multiple exec nodes."),
-                    Title
-                );
-                CallNode->ErrorMsg            = Message.ToString();
-                CallNode->ErrorType           = bShouldError ? EMessageSeverity::Error : EMessageSeverity::Warning;
-                CallNode->bHasCompilerMessage = true;
-
-                TSharedRef<FTokenizedMessage> TokenMessage =
-                    FTokenizedMessage::Create(EMessageSeverity::Warning, Message);
-
-                TokenMessage->AddToken(
-                    FActionToken::Create(
-                        NSLOCTEXT("PureNodeValidator", "OpenNode", "Focus Node"),
-                        NSLOCTEXT("PureNodeValidator", "OpenNodeTooltip", "Open this node in the Blueprint Editor"),
-                        FOnActionTokenExecuted::CreateLambda([Blueprint, Graph, CallNode]()
-                        {
-                            UCommonValidatorsStatics::OpenBlueprintAndFocusNode(Blueprint, Graph, CallNode);
-                        }),
-                        /*bEnabled=*/false
-                    )
-                );
-
-                Context.AddMessage(TokenMessage);
-                Graph->NotifyNodeChanged(Node);
-				bFoundBadNode = true;
+                Message += TEXT(" Nodes running in between may change its result, check they don't before caching it.");
             }
         }
+
+        OutFindings.Add(MakeFinding(Graph, BadNode.Ref.NodeIndex, EMessageSeverity::Warning, Message, Actions, Rule));
     }
 
-	if (bShouldError && bFoundBadNode)
+	if (bShouldError && BadNodes.Num() > 0)
 	{
 		return EDataValidationResult::Invalid;
 	}
 	
     return EDataValidationResult::Valid;
 }
+
+bool UEditorValidator_PureNode::OnFindingReported(UBlueprint* Blueprint, UEdGraph* Graph, UEdGraphNode* Node, const FCommonValidatorsFinding& Finding) const
+{
+	bool bShouldError = GetDefault<UCommonValidatorsDeveloperSettings>()->bErrorOnPureNodeMultiExec;
+
+    Node->ErrorMsg            = FormatMessage(Finding, Node).ToString();
+    Node->ErrorType           = bShouldError ? EMessageSeverity::Error : EMessageSeverity::Warning;
+    Node->bHasCompilerMessage = true;
+
+    return true;
+}
+
+void UEditorValidator_PureNode::FindRepeatedPureNodes(const FCommonValidatorsBlueprintIndex& Index, TArray<FCommonValidatorsRepeatedPureNode>& OutNodes)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UEditorValidator_PureNode::FindRepeatedPureNodes);
+
+	for (int32 GraphIndex = 0; GraphIndex < Index.Graphs.Num(); ++GraphIndex)
+	{
+		const FCommonValidatorsIndexedGraph& IndexedGraph = Index.Graphs[GraphIndex];
+
+		// Built lazily, most graphs contain no pure call worth checking.
+		TOptional<UE::Internal::PureNodeValidatorHelpers::FGraphAnalysis> GraphAnalysis;
+
+		for (int32 NodeIndex = 0; NodeIndex < IndexedGraph.Nodes.Num(); ++NodeIndex)
+		{
+			const FCommonValidatorsIndexedNode& IndexedNode = IndexedGraph.Nodes[NodeIndex];
+			if (IndexedNode.Kind != ECommonValidatorsNodeKind::CallFunction || !IndexedNode.bIsPure)
+			{
+				continue;
+			}
+
+			if (IndexedNode.bIsHarmlessPure)
+			{
+				continue;
+			}
+
+			if (!GraphAnalysis.IsSet())
+			{
+				GraphAnalysis.Emplace(IndexedGraph);
+			}
+
+			FCommonValidatorsRepeatedPureNode Repeated;
+			if (GraphAnalysis->FindRepeatedEvaluation(NodeIndex, Repeated))
+			{
+				GraphAnalysis->FindCachePoint(NodeIndex, Repeated);
+				Repeated.Ref = { GraphIndex, NodeIndex };
+				OutNodes.Add(Repeated);
+			}
+		}
+	}
+}
+
+bool UEditorValidator_PureNode::CacheInVariable(UBlueprint* Blueprint, UEdGraphNode* PureNode)
+{
+	return CacheInVariables(Blueprint, MakeArrayView(&PureNode, 1)) > 0;
+}
+
+int32 UEditorValidator_PureNode::CacheInVariables(UBlueprint* Blueprint, TConstArrayView<UEdGraphNode*> PureNodes)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UEditorValidator_PureNode::CacheInVariables);
+
+	if (!Blueprint)
+	{
+		return 0;
+	}
+
+	int32 NumCached = 0;
+	TArray<UEdGraphNode*> Pending(PureNodes);
+	while (Pending.Num() > 0)
+	{
+		// The graphs may have changed since they were validated, so cache points are looked up again on a fresh index,
+		// shared by every node of the pass. Nodes data-linked to one rewritten in the pass wait for the next one.
+		const TSharedRef<FCommonValidatorsBlueprintIndex> Index = FCommonValidatorsBlueprintIndex::Build(Blueprint);
+		TArray<FCommonValidatorsRepeatedPureNode> Repeated;
+		FindRepeatedPureNodes(*Index, Repeated);
+
+		TMap<int32, TBitArray<>> Rewritten;
+		TArray<UEdGraphNode*> Deferred;
+		for (UEdGraphNode* PureNode : Pending)
+		{
+			UEdGraph* Graph = PureNode ? PureNode->GetGraph() : nullptr;
+			const int32 GraphIndex = Graph ? Index->Graphs.IndexOfByPredicate([Graph](const FCommonValidatorsIndexedGraph& Indexed) { return Indexed.Graph == Graph; }) : INDEX_NONE;
+			const int32 NodeIndex = GraphIndex != INDEX_NONE ? Index->Graphs[GraphIndex].FindNodeIndex(PureNode) : INDEX_NONE;
+			const FCommonValidatorsRepeatedPureNode* Found = Repeated.FindByPredicate([GraphIndex, NodeIndex](const FCommonValidatorsRepeatedPureNode& Node)
+			{
+				return Node.Ref.GraphIndex == GraphIndex && Node.Ref.NodeIndex == NodeIndex;
+			});
+			if (NodeIndex == INDEX_NONE || !Found || Found->CachePoint == INDEX_NONE || Found->bCacheMayChangeResult)
+			{
+				continue;
+			}
+
+			const TBitArray<>* Linked = Rewritten.Find(GraphIndex);
+			if (Linked && (*Linked)[NodeIndex])
+			{
+				Deferred.Add(PureNode);
+				continue;
+			}
+
+			if (UE::Internal::PureNodeValidatorHelpers::CacheInVariable(Blueprint, Index->Graphs[GraphIndex], *Found))
+			{
+				++NumCached;
+				UE::Internal::PureNodeValidatorHelpers::MarkDataLinked(Index->Graphs[GraphIndex], NodeIndex, Rewritten.FindOrAdd(GraphIndex));
+			}
+		}
+
+		Pending = MoveTemp(Deferred);
+	}
+
+	return NumCached;
+}
+
+void UEditorValidator_PureNode::FindMultiExecPureNodes(const FCommonValidatorsBlueprintIndex& Index, TArray<FCommonValidatorsNodeRef>& OutNodes)
+{
+	TArray<FCommonValidatorsRepeatedPureNode> Repeated;
+	FindRepeatedPureNodes(Index, Repeated);
+
+	OutNodes.Reserve(OutNodes.Num() + Repeated.Num());
+	for (const FCommonValidatorsRepeatedPureNode& Node : Repeated)
+	{
+		OutNodes.Add(Node.Ref);
+	}
+}
@@ -1,17 +1,70 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "EditorValidatorBase.h"
+#include "EditorValidator_BlueprintBase.h"
+#include "CommonValidatorsGraphIndex.h"
 #include "EditorValidator_PureNode.generated.h"
 
-/**
- *
- */
+// A pure node evaluated again by more than one exec node, or on every iteration of a loop.
+struct FCommonValidatorsRepeatedPureNode
+{
+	FCommonValidatorsNodeRef Ref;
+
+	// Reachable exec nodes reading the result, each of them evaluates it again.
+	int32 NumReaders = 0;
+
+	// Innermost loop of Graph.Loops evaluating it on every iteration, INDEX_NONE if no loop repeats it.
+	int32 LoopIndex = INDEX_NONE;
+
+	// Number of nested loops multiplying the evaluations, LoopIndex's own enclosing loops included.
+	int32 LoopDepth = 0;
+
+	// Whether it feeds the loop's per-iteration input rather than nodes of its body.
+	bool bFeedsLoopInput = false;
+
+	// Exec node the result can be computed and stored at once for every reader, INDEX_NONE when there is none.
+	int32 CachePoint = INDEX_NONE;
+
+	// Whether to store it right after CachePoint, an event or function entry, rather than right before.
+	bool bCacheAfterPoint = false;
+
+	// Whether exec nodes running between CachePoint and the readers, or in the body of the loop repeating it, may
+	// change the result. Caching it is then only suggested, the graph isn't rewritten automatically.
+	bool bCacheMayChangeResult = false;
+};
+
 UCLASS()
-class COMMONVALIDATORS_API UEditorValidator_PureNode : public UEditorValidatorBase
+class COMMONVALIDATORS_API UEditorValidator_PureNode : public UEditorValidator_BlueprintBase
 {
 	GENERATED_BODY()
 
-	virtual bool CanValidateAsset_Implementation(const FAssetData& InAssetData, UObject* InObject, FDataValidationContext& InContext) const override;
-	virtual EDataValidationResult ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context) override;
-};
\ No newline at end of file
+	virtual bool IsEnabledInSettings() const override;
+	virtual uint32 GetSettingsHash() const override;
+	virtual bool IsGraphLocal() const override { return true; }
+	virtual EDataValidationResult AnalyzeBlueprint(const FCommonValidatorsBlueprintIndex& Index, TArray<FCommonValidatorsFinding>& OutFindings) const override;
+	virtual bool OnFindingReported(UBlueprint* Blueprint, UEdGraph* Graph, UEdGraphNode* Node, const FCommonValidatorsFinding& Finding) const override;
+
+public:
+	/**
+	 * Collects every non-allowlisted pure call whose result feeds more than one reachable exec node, feeds a
+	 * standard loop's per-iteration input, or feeds nodes of a loop body without depending on the loop.
+	 */
+	static void FindRepeatedPureNodes(const FCommonValidatorsBlueprintIndex& Index, TArray<FCommonValidatorsRepeatedPureNode>& OutNodes);
+
+	/**
+	 * Rewrites the graph so the pure node is evaluated once: its result is stored in a new variable at the cache
+	 * point found by FindRepeatedPureNodes, local in functions and a member in event graphs, and every reader gets
+	 * the variable instead. Returns false if the node isn't repeated, has no cache point or only a suggested one.
+	 * Leaves compiling to the caller.
+	 */
+	static bool CacheInVariable(UBlueprint* Blueprint, UEdGraphNode* PureNode);
+
+	/**
+	 * CacheInVariable for several nodes of the same Blueprint. Nodes are rewritten in passes sharing one index each,
+	 * a node data-linked to one rewritten earlier in the pass waits for the next pass. Returns the number of nodes cached.
+	 */
+	static int32 CacheInVariables(UBlueprint* Blueprint, TConstArrayView<UEdGraphNode*> PureNodes);
+
+	// Same as FindRepeatedPureNodes, without the details.
+	static void FindMultiExecPureNodes(const FCommonValidatorsBlueprintIndex& Index, TArray<FCommonValidatorsNodeRef>& OutNodes);
+};
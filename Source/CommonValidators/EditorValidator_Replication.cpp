@@ -0,0 +1,172 @@
+#include "EditorValidator_Replication.h"
+
+#include "Misc/DataValidation.h"
+#include "CommonValidatorsDeveloperSettings.h"
+#include "CommonValidatorsGraphIndex.h"
+#include "CommonValidatorsProfiler.h"
+#include "EditorValidator_ExpensiveTick.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "UObject/CoreNetTypes.h"
+
+DECLARE_CYCLE_STAT(TEXT("Replication Validator"), STAT_CommonValidators_Replication, STATGROUP_CommonValidators);
+
+namespace UE::Internal::ReplicationValidatorHelpers
+{
+	// Bump when the analysis changes, so cached results are recomputed.
+	static constexpr uint32 AnalysisVersion = 1;
+
+	// Rules of the findings, see FCommonValidatorsFinding::Rule.
+	static const FName ReliableRpcRule(TEXT("ReliableRpc"));
+	static const FName RepNotifyWriteRule(TEXT("RepNotifyWrite"));
+
+	// A finding and the bandwidth it's estimated to cost, so the worst ones are reported first.
+	struct FRankedFinding
+	{
+		float BytesPerSecond = 0.0f;
+		FCommonValidatorsFinding Finding;
+	};
+}
+
+bool UEditorValidator_Replication::IsEnabledInSettings() const
+{
+	return GetDefault<UCommonValidatorsDeveloperSettings>()->bEnableReplicationValidator;
+}
+
+uint32 UEditorValidator_Replication::GetSettingsHash() const
+{
+	const UCommonValidatorsDeveloperSettings* Settings = GetDefault<UCommonValidatorsDeveloperSettings>();
+	uint32 Hash = HashCombine(UE::Internal::ReplicationValidatorHelpers::AnalysisVersion, GetTypeHash(Settings->bErrorOnReplication));
+	Hash = HashCombine(Hash, GetTypeHash(Settings->bRequireReplicationCondition));
+	Hash = HashCombine(Hash, GetTypeHash(Settings->ReplicatedVariableThresholdBytes));
+	Hash = HashCombine(Hash, GetTypeHash(Settings->ReplicationTickRate));
+	return HashCombine(Hash, GetTypeHash(Settings->TickCostLoopIterations));
+}
+
+EDataValidationResult UEditorValidator_Replication::AnalyzeBlueprint(const FCommonValidatorsBlueprintIndex& Index, TArray<FCommonValidatorsFinding>& OutFindings) const
+{
+	using namespace UE::Internal::ReplicationValidatorHelpers;
+
+	SCOPE_CYCLE_COUNTER(STAT_CommonValidators_Replication);
+
+	const UCommonValidatorsDeveloperSettings* Settings = GetDefault<UCommonValidatorsDeveloperSettings>();
+	const bool bShouldError = Settings->bErrorOnReplication;
+	const EMessageSeverity::Type Severity = bShouldError ? EMessageSeverity::Error : EMessageSeverity::Warning;
+	const float TickRate = FMath::Max(1.0f, Settings->ReplicationTickRate);
+	const float LoopIterations = FMath::Max(1.0f, Settings->TickCostLoopIterations);
+
+	TArray<FRankedFinding> Ranked;
+
+	// Variables of actors and components that don't replicate never leave the server.
+	if (Index.bReplicates)
+	{
+		// Without the actor's net update frequency, a variable is ranked by its size alone.
+		const float UpdateRate = Index.NetUpdateFrequency > 0.0f ? Index.NetUpdateFrequency : 1.0f;
+
+		for (const FCommonValidatorsReplicatedVariable& Variable : Index.ReplicatedVariables)
+		{
+			const float BytesPerSecond = Variable.Bytes * UpdateRate;
+			if (Variable.Bytes >= Settings->ReplicatedVariableThresholdBytes)
+			{
+				FString Frequency;
+				if (Index.NetUpdateFrequency > 0.0f)
+				{
+					Frequency = FString::Printf(TEXT(", up to ~%d bytes/s at %g net updates per second if it changes every update"), FMath::RoundToInt(BytesPerSecond), Index.NetUpdateFrequency);
+				}
+
+				FRankedFinding& Entry = Ranked.AddDefaulted_GetRef();
+				Entry.BytesPerSecond = BytesPerSecond;
+				Entry.Finding.Severity = Severity;
+				Entry.Finding.Message = FString::Printf(TEXT("Replicated variable %s is ~%d bytes per replication%s. %s"),
+					*Variable.Name.ToString(), Variable.Bytes, *Frequency,
+					Variable.bIsContainer
+						? TEXT("Containers are assumed to hold 8 elements and are compared element by element, keep them short or replicate only what clients need.")
+						: TEXT("Replicate a smaller struct with only what clients need."));
+			}
+
+			if (Settings->bRequireReplicationCondition && Variable.Condition == COND_None)
+			{
+				FRankedFinding& Entry = Ranked.AddDefaulted_GetRef();
+				Entry.BytesPerSecond = BytesPerSecond;
+				Entry.Finding.Severity = Severity;
+				Entry.Finding.Message = FString::Printf(TEXT("Replicated variable %s (~%d bytes) has no replication condition, so the server compares it for every connection on every net update. Set a Replication Condition such as Initial Only, Owner Only or Skip Owner if not every client needs every change."),
+					*Variable.Name.ToString(), Variable.Bytes);
+			}
+		}
+	}
+
+	FCommonValidatorsTickReach Reach;
+	TArray<int32> LoopDepths;
+	for (const FCommonValidatorsIndexedGraph& Graph : Index.Graphs)
+	{
+		if (!UEditorValidator_ExpensiveTick::FindTickReach(Graph, Reach))
+		{
+			continue;
+		}
+
+		// Loop bodies on Tick run several times per frame, nested loops multiply.
+		LoopDepths.Init(0, Graph.Nodes.Num());
+		for (const FCommonValidatorsIndexedLoop& Loop : Graph.Loops)
+		{
+			for (const int32 BodyNode : Loop.BodyNodes)
+			{
+				++LoopDepths[BodyNode];
+			}
+		}
+
+		for (const int32 NodeIndex : Reach.Order)
+		{
+			const FCommonValidatorsIndexedNode& Node = Graph.Nodes[NodeIndex];
+			if (Node.NetKind != ECommonValidatorsNetKind::ReliableRpc && Node.NetKind != ECommonValidatorsNetKind::RepNotifyWrite)
+			{
+				continue;
+			}
+
+			const int32 LoopDepth = LoopDepths[NodeIndex];
+			const TCHAR* Repeat = LoopDepth > 0 ? TEXT(", on every loop iteration") : TEXT("");
+			const float BytesPerSecond = Node.NetBytes * TickRate * FMath::Pow(LoopIterations, LoopDepth);
+			const FString Path = UEditorValidator_ExpensiveTick::DescribeTickPath(Graph, Reach, NodeIndex);
+
+			FRankedFinding& Entry = Ranked.AddDefaulted_GetRef();
+			Entry.BytesPerSecond = BytesPerSecond;
+			if (Node.NetKind == ECommonValidatorsNetKind::ReliableRpc)
+			{
+				Entry.Finding = MakeFinding(Graph, NodeIndex, Severity,
+					FString::Printf(TEXT("{Node} sends a reliable RPC every frame%s (~%d bytes per call, ~%d bytes/s at %g fps): %s. Reliable RPCs are resent until acknowledged and can overflow the reliable buffer, make it Unreliable or only send it when something changed."),
+						Repeat, Node.NetBytes, FMath::RoundToInt(BytesPerSecond), TickRate, *Path),
+					ECommonValidatorsFindingActions::FocusNode, ReliableRpcRule);
+			}
+			else
+			{
+				Entry.Finding = MakeFinding(Graph, NodeIndex, Severity,
+					FString::Printf(TEXT("{Node} writes a replicated variable with a RepNotify every frame%s (~%d bytes per replication, up to ~%d bytes/s at %g fps): %s. Blueprints call the RepNotify on the server on every set and clients on every net update it changed, only set it when the value is different."),
+						Repeat, Node.NetBytes, FMath::RoundToInt(BytesPerSecond), TickRate, *Path),
+					ECommonValidatorsFindingActions::FocusNode, RepNotifyWriteRule);
+			}
+		}
+	}
+
+	Ranked.StableSort([](const FRankedFinding& A, const FRankedFinding& B)
+	{
+		return A.BytesPerSecond > B.BytesPerSecond;
+	});
+
+	for (FRankedFinding& Entry : Ranked)
+	{
+		OutFindings.Add(MoveTemp(Entry.Finding));
+	}
+
+	return (bShouldError && Ranked.Num() > 0) ? EDataValidationResult::Invalid : EDataValidationResult::Valid;
+}
+
+int32 UEditorValidator_Replication::CountNetworkedItems(const FCommonValidatorsBlueprintIndex& Index)
+{
+	int32 Count = Index.ReplicatedVariables.Num();
+	for (const FCommonValidatorsIndexedGraph& Graph : Index.Graphs)
+	{
+		for (const FCommonValidatorsIndexedNode& Node : Graph.Nodes)
+		{
+			Count += Node.NetKind == ECommonValidatorsNetKind::ReliableRpc || Node.NetKind == ECommonValidatorsNetKind::RepNotifyWrite;
+		}
+	}
+	return Count;
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorValidator_BlueprintBase.h"
+#include "EditorValidator_Replication.generated.h"
+
+UCLASS()
+class COMMONVALIDATORS_API UEditorValidator_Replication : public UEditorValidator_BlueprintBase
+{
+	GENERATED_BODY()
+
+	virtual bool IsEnabledInSettings() const override;
+	virtual uint32 GetSettingsHash() const override;
+	virtual EDataValidationResult AnalyzeBlueprint(const FCommonValidatorsBlueprintIndex& Index, TArray<FCommonValidatorsFinding>& OutFindings) const override;
+
+public:
+	// Number of replicated variables, reliable RPC calls and RepNotify writes, i.e. everything the analysis may report.
+	static int32 CountNetworkedItems(const FCommonValidatorsBlueprintIndex& Index);
+};
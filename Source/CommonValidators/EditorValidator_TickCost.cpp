@@ -0,0 +1,330 @@
+#include "EditorValidator_TickCost.h"
+
+#include "Misc/DataValidation.h"
+#include "EdGraphSchema_K2.h"
+#include "EditorValidator_ExpensiveTick.h"
+#include "CommonValidatorsCallGraph.h"
+#include "CommonValidatorsDeveloperSettings.h"
+#include "CommonValidatorsProfiler.h"
+#include "Misc/Crc.h"
+#include "Misc/StringBuilder.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+DECLARE_CYCLE_STAT(TEXT("Tick Cost Validator"), STAT_CommonValidators_TickCost, STATGROUP_CommonValidators);
+
+namespace UE::Internal::TickCostValidatorHelpers
+{
+	// Bump when the analysis changes, so cached results are recomputed.
+	static constexpr uint32 AnalysisVersion = 1;
+
+	// Rules of the findings, see FCommonValidatorsFinding::Rule.
+	static const FName TickRule(TEXT("Tick"));
+	static const FName ConstructionScriptRule(TEXT("ConstructionScript"));
+
+	// Nodes named in a finding.
+	static constexpr int32 MaxTopNodes = 3;
+
+	// Owner class name and function name, the same way the index and call summaries identify functions.
+	using FFunctionKey = TPair<FName, FName>;
+
+	static FName GetClassName(const TSoftClassPtr<UObject>& Class)
+	{
+		return FName(Class.ToSoftObjectPath().GetAssetName());
+	}
+
+	/**
+	 * Costs of a single Blueprint index. Function graphs of the Blueprint are costed once, the first time they are
+	 * called, and reused for every other call.
+	 */
+	class FCostModel
+	{
+	public:
+		FCostModel(const UCommonValidatorsDeveloperSettings& Settings, const FCommonValidatorsBlueprintIndex& InIndex)
+			: Index(InIndex)
+			, CostPerNode(Settings.TickCostPerNode)
+			, LoopIterations(FMath::Max(1.0f, Settings.TickCostLoopIterations))
+		{
+			FunctionCosts.Reserve(Settings.TickCostFunctions.Num());
+			for (const FCommonValidatorsFunctionCost& FunctionCost : Settings.TickCostFunctions)
+			{
+				FunctionCosts.Add({ GetClassName(FunctionCost.Class), FunctionCost.FunctionName }, FunctionCost.Cost);
+			}
+
+			for (int32 GraphIndex = 0; GraphIndex < Index.Graphs.Num(); ++GraphIndex)
+			{
+				if (Index.Graphs[GraphIndex].Kind == ECommonValidatorsGraphKind::Function)
+				{
+					FunctionGraphs.Add(Index.Graphs[GraphIndex].GraphName, GraphIndex);
+				}
+			}
+
+			GraphCosts.Init(-1.0f, Index.Graphs.Num());
+			InProgress.Init(false, Index.Graphs.Num());
+		}
+
+		// Cost of everything run from Roots. OutTopNodes receives the most expensive nodes, if given.
+		float ComputeCost(int32 GraphIndex, TConstArrayView<int32> Roots, TArray<FCommonValidatorsNodeCost>* OutTopNodes)
+		{
+			const FCommonValidatorsIndexedGraph& Graph = Index.Graphs[GraphIndex];
+
+			FCommonValidatorsTickReach Reach;
+			UEditorValidator_ExpensiveTick::FindExecReach(Graph, Roots, Reach);
+
+			// Loop bodies run once per iteration, nested loops multiply.
+			TArray<float> Multipliers;
+			Multipliers.Init(1.0f, Graph.Nodes.Num());
+			for (const FCommonValidatorsIndexedLoop& Loop : Graph.Loops)
+			{
+				for (const int32 BodyNode : Loop.BodyNodes)
+				{
+					Multipliers[BodyNode] *= LoopIterations;
+				}
+			}
+
+			float Total = 0.0f;
+			for (const int32 NodeIndex : Reach.Order)
+			{
+				// Pure nodes are evaluated by the node they were reached from, inside its loops. Parents come first.
+				const int32 Parent = Reach.Parents[NodeIndex];
+				if (Graph.Nodes[NodeIndex].bIsPure && Parent != INDEX_NONE)
+				{
+					Multipliers[NodeIndex] = Multipliers[Parent];
+				}
+
+				const float Cost = GetNodeCost(GraphIndex, NodeIndex) * Multipliers[NodeIndex];
+				Total += Cost;
+				if (OutTopNodes && Cost > 0.0f)
+				{
+					OutTopNodes->Add({ { GraphIndex, NodeIndex }, Cost });
+				}
+			}
+
+			if (OutTopNodes)
+			{
+				OutTopNodes->Sort([](const FCommonValidatorsNodeCost& A, const FCommonValidatorsNodeCost& B) { return A.Cost > B.Cost; });
+				OutTopNodes->SetNum(FMath::Min(OutTopNodes->Num(), MaxTopNodes));
+			}
+			return Total;
+		}
+
+	private:
+		float GetNodeCost(int32 GraphIndex, int32 NodeIndex)
+		{
+			const FCommonValidatorsIndexedGraph& Graph = Index.Graphs[GraphIndex];
+			const FCommonValidatorsIndexedNode& Node = Graph.Nodes[NodeIndex];
+
+			// Entries, results and reroutes don't run anything by themselves.
+			if (Node.Kind == ECommonValidatorsNodeKind::Event || Node.Kind == ECommonValidatorsNodeKind::FunctionEntry
+				|| Node.Kind == ECommonValidatorsNodeKind::FunctionResult || Node.Kind == ECommonValidatorsNodeKind::Knot)
+			{
+				return 0.0f;
+			}
+
+			// Calls, and nodes expanding into one such as Format Text.
+			float Cost = CostPerNode;
+			if (Node.Function)
+			{
+				if (const float* FunctionCost = FunctionCosts.Find({ Node.FunctionOwnerName, Node.MemberName }))
+				{
+					Cost = *FunctionCost;
+				}
+			}
+
+			if (Node.Kind == ECommonValidatorsNodeKind::CallFunction)
+			{
+				// Functions of this Blueprint are costed node by node, loops included.
+				if (const int32* CalleeGraph = FunctionGraphs.Find(Node.MemberName))
+				{
+					return Cost + GetFunctionGraphCost(*CalleeGraph);
+				}
+			}
+
+			// Only the calls made further down are known for macros and functions of other Blueprints.
+			if (const TSharedRef<const FCommonValidatorsCallSummary>* Summary = Graph.CallSummaries.Find(NodeIndex))
+			{
+				for (const FCommonValidatorsReachedCall& Call : (*Summary)->Calls)
+				{
+					const float* CallCost = FunctionCosts.Find({ Call.OwnerName, Call.FunctionName });
+					Cost += CallCost ? *CallCost : CostPerNode;
+				}
+			}
+			return Cost;
+		}
+
+		float GetFunctionGraphCost(int32 GraphIndex)
+		{
+			if (GraphCosts[GraphIndex] >= 0.0f)
+			{
+				return GraphCosts[GraphIndex];
+			}
+
+			// Recursive calls are counted once.
+			if (InProgress[GraphIndex])
+			{
+				return 0.0f;
+			}
+
+			const FCommonValidatorsIndexedGraph& Graph = Index.Graphs[GraphIndex];
+			TArray<int32, TInlineAllocator<1>> Entries;
+			for (const int32 Entry : Graph.EntryNodes)
+			{
+				if (Graph.Nodes[Entry].Kind == ECommonValidatorsNodeKind::FunctionEntry)
+				{
+					Entries.Add(Entry);
+				}
+			}
+
+			InProgress[GraphIndex] = true;
+			GraphCosts[GraphIndex] = ComputeCost(GraphIndex, Entries, nullptr);
+			InProgress[GraphIndex] = false;
+			return GraphCosts[GraphIndex];
+		}
+
+		const FCommonValidatorsBlueprintIndex& Index;
+		const float CostPerNode;
+		const float LoopIterations;
+
+		TMap<FFunctionKey, float> FunctionCosts;
+		TMap<FName, int32> FunctionGraphs;
+
+		// Memoized cost of every function graph, negative until computed.
+		TArray<float> GraphCosts;
+		TBitArray<> InProgress;
+	};
+
+	// "GetAllActorsOfClass (160), UpdateTargets (42)"
+	static FString DescribeTopNodes(const FCommonValidatorsBlueprintIndex& Index, const TArray<FCommonValidatorsNodeCost>& TopNodes)
+	{
+		TStringBuilder<256> Description;
+		for (const FCommonValidatorsNodeCost& NodeCost : TopNodes)
+		{
+			const FName MemberName = Index.GetNode(NodeCost.Ref).MemberName;
+			Description << (Description.Len() > 0 ? TEXT(", ") : TEXT(""));
+			if (MemberName.IsNone())
+			{
+				Description << TEXT("unnamed node");
+			}
+			else
+			{
+				Description << MemberName;
+			}
+			Description.Appendf(TEXT(" (%.0f)"), NodeCost.Cost);
+		}
+		return Description.ToString();
+	}
+}
+
+bool UEditorValidator_TickCost::IsEnabledInSettings() const
+{
+	return GetDefault<UCommonValidatorsDeveloperSettings>()->bEnableTickCostValidator;
+}
+
+uint32 UEditorValidator_TickCost::GetSettingsHash() const
+{
+	const UCommonValidatorsDeveloperSettings* Settings = GetDefault<UCommonValidatorsDeveloperSettings>();
+
+	uint32 Hash = HashCombine(UE::Internal::TickCostValidatorHelpers::AnalysisVersion, GetTypeHash(Settings->bErrorOnTickCostOverBudget));
+	Hash = HashCombine(Hash, GetTypeHash(Settings->TickCostPerNode));
+	Hash = HashCombine(Hash, GetTypeHash(Settings->TickCostLoopIterations));
+	for (const FCommonValidatorsFunctionCost& FunctionCost : Settings->TickCostFunctions)
+	{
+		Hash = FCrc::StrCrc32(*FunctionCost.Class.ToString(), Hash);
+		Hash = FCrc::StrCrc32(*FunctionCost.FunctionName.ToString(), Hash);
+		Hash = HashCombine(Hash, GetTypeHash(FunctionCost.Cost));
+	}
+	for (const FCommonValidatorsTickBudget& Budget : Settings->TickCostBudgets)
+	{
+		Hash = FCrc::StrCrc32(*Budget.ParentClass.ToString(), Hash);
+		Hash = HashCombine(Hash, GetTypeHash(Budget.TickBudget));
+		Hash = HashCombine(Hash, GetTypeHash(Budget.ConstructionScriptBudget));
+	}
+	return Hash;
+}
+
+EDataValidationResult UEditorValidator_TickCost::AnalyzeBlueprint(const FCommonValidatorsBlueprintIndex& Index, TArray<FCommonValidatorsFinding>& OutFindings) const
+{
+	using namespace UE::Internal::TickCostValidatorHelpers;
+
+	SCOPE_CYCLE_COUNTER(STAT_CommonValidators_TickCost);
+
+	const bool bShouldError = GetDefault<UCommonValidatorsDeveloperSettings>()->bErrorOnTickCostOverBudget;
+	const EMessageSeverity::Type Severity = bShouldError ? EMessageSeverity::Error : EMessageSeverity::Warning;
+
+	FCommonValidatorsTickCost Cost;
+	ComputeTickCost(Index, Cost);
+
+	const int32 NumFindings = OutFindings.Num();
+	if (Cost.TickBudget > 0.0f && Cost.TickCost > Cost.TickBudget)
+	{
+		OutFindings.Add(MakeFinding(Index.Graphs[Cost.CostliestTick.GraphIndex], Cost.CostliestTick.NodeIndex, Severity,
+			FString::Printf(TEXT("Tick costs an estimated %.0f per frame, over the %.0f budget of %s Blueprints. {Node} is the most expensive, mostly because of %s."),
+				Cost.TickCost, Cost.TickBudget, *Cost.BudgetClassName.ToString(), *DescribeTopNodes(Index, Cost.TopTickNodes)),
+			ECommonValidatorsFindingActions::FocusNode, TickRule));
+	}
+
+	if (Cost.ConstructionScriptBudget > 0.0f && Cost.ConstructionScriptCost > Cost.ConstructionScriptBudget)
+	{
+		OutFindings.Add(MakeFinding(Index.Graphs[Cost.ConstructionScript.GraphIndex], Cost.ConstructionScript.NodeIndex, Severity,
+			FString::Printf(TEXT("{Node} costs an estimated %.0f per run, over the %.0f budget of %s Blueprints. Most expensive: %s."),
+				Cost.ConstructionScriptCost, Cost.ConstructionScriptBudget, *Cost.BudgetClassName.ToString(), *DescribeTopNodes(Index, Cost.TopConstructionScriptNodes)),
+			ECommonValidatorsFindingActions::FocusNode, ConstructionScriptRule));
+	}
+
+	return (bShouldError && OutFindings.Num() > NumFindings) ? EDataValidationResult::Invalid : EDataValidationResult::Valid;
+}
+
+void UEditorValidator_TickCost::ComputeTickCost(const FCommonValidatorsBlueprintIndex& Index, FCommonValidatorsTickCost& OutCost)
+{
+	using namespace UE::Internal::TickCostValidatorHelpers;
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(UEditorValidator_TickCost::ComputeTickCost);
+
+	const UCommonValidatorsDeveloperSettings* Settings = GetDefault<UCommonValidatorsDeveloperSettings>();
+
+	OutCost = FCommonValidatorsTickCost();
+	FCostModel Model(*Settings, Index);
+
+	float CostliestTick = -1.0f;
+	TArray<FCommonValidatorsNodeCost> TopNodes;
+	for (int32 GraphIndex = 0; GraphIndex < Index.Graphs.Num(); ++GraphIndex)
+	{
+		const FCommonValidatorsIndexedGraph& Graph = Index.Graphs[GraphIndex];
+		for (const int32 Entry : Graph.EntryNodes)
+		{
+			const FCommonValidatorsIndexedNode& Node = Graph.Nodes[Entry];
+			if (UEditorValidator_ExpensiveTick::IsTickEntry(Node) && !Node.bIsGhostNode)
+			{
+				TopNodes.Reset();
+				const float Cost = Model.ComputeCost(GraphIndex, MakeArrayView(&Entry, 1), &TopNodes);
+				OutCost.TickCost += Cost;
+				if (Cost > CostliestTick)
+				{
+					CostliestTick = Cost;
+					OutCost.CostliestTick = { GraphIndex, Entry };
+					OutCost.TopTickNodes = TopNodes;
+				}
+			}
+			else if (Node.Kind == ECommonValidatorsNodeKind::FunctionEntry && Node.MemberName == UEdGraphSchema_K2::FN_UserConstructionScript)
+			{
+				OutCost.ConstructionScriptCost = Model.ComputeCost(GraphIndex, MakeArrayView(&Entry, 1), &OutCost.TopConstructionScriptNodes);
+				OutCost.ConstructionScript = { GraphIndex, Entry };
+			}
+		}
+	}
+
+	for (const FName ParentClassName : Index.ParentClassNames)
+	{
+		const FCommonValidatorsTickBudget* Budget = Settings->TickCostBudgets.FindByPredicate([ParentClassName](const FCommonValidatorsTickBudget& Candidate)
+		{
+			return GetClassName(Candidate.ParentClass) == ParentClassName;
+		});
+
+		if (Budget)
+		{
+			OutCost.BudgetClassName = ParentClassName;
+			OutCost.TickBudget = Budget->TickBudget;
+			OutCost.ConstructionScriptBudget = Budget->ConstructionScriptBudget;
+			break;
+		}
+	}
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorValidator_BlueprintBase.h"
+#include "CommonValidatorsGraphIndex.h"
+#include "EditorValidator_TickCost.generated.h"
+
+// A node and its estimated cost, loop multipliers and called functions included.
+struct FCommonValidatorsNodeCost
+{
+	FCommonValidatorsNodeRef Ref;
+	float Cost = 0.0f;
+};
+
+// Estimated cost of a Blueprint's Tick events and construction script, in the units of the Tick Cost settings.
+struct FCommonValidatorsTickCost
+{
+	// Every Tick event together, per frame.
+	float TickCost = 0.0f;
+	float ConstructionScriptCost = 0.0f;
+
+	// Closest parent class with a budget in the settings, None (and budgets of 0) when there is none.
+	FName BudgetClassName;
+	float TickBudget = 0.0f;
+	float ConstructionScriptBudget = 0.0f;
+
+	// The most expensive Tick event and the construction script entry, unset when there is none.
+	FCommonValidatorsNodeRef CostliestTick;
+	FCommonValidatorsNodeRef ConstructionScript;
+
+	// Most expensive nodes run by CostliestTick and by the construction script, by decreasing cost.
+	TArray<FCommonValidatorsNodeCost> TopTickNodes;
+	TArray<FCommonValidatorsNodeCost> TopConstructionScriptNodes;
+};
+
+UCLASS()
+class COMMONVALIDATORS_API UEditorValidator_TickCost : public UEditorValidator_BlueprintBase
+{
+	GENERATED_BODY()
+
+	virtual bool IsEnabledInSettings() const override;
+	virtual uint32 GetSettingsHash() const override;
+	virtual EDataValidationResult AnalyzeBlueprint(const FCommonValidatorsBlueprintIndex& Index, TArray<FCommonValidatorsFinding>& OutFindings) const override;
+
+public:
+	/**
+	 * Sums the cost of every node Tick and the construction script run, with loop bodies multiplied by the assumed
+	 * number of iterations and calls into the Blueprint's functions costed node by node. Calls into macros and other
+	 * Blueprints are costed by the functions they call further down. Only reads the index and settings.
+	 */
+	static void ComputeTickCost(const FCommonValidatorsBlueprintIndex& Index, FCommonValidatorsTickCost& OutCost);
+};